@@ -1,3 +1,4 @@
+#include <algorithm>
 #include "Ast.h"
 #include "Exception.h"
 
@@ -7,7 +8,8 @@ using namespace std;
 //  IAst
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
-IAst::IAst()
+IAst::IAst(AST_KIND kind)
+	: m_kind(kind)
 {
 }
 
@@ -15,32 +17,15 @@ IAst::~IAst()
 {
 }
 
-bool IAst::IsExpression() const
-{
-	return false;
-}
-
-bool IAst::IsConstant() const
-{
-	return false;
-}
-
-bool IAst::IsError() const
-{
-	return false;
-}
-
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 //  AstError
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
-AstError::AstError()
-{
-}
+IAst *const AstError::INSTANCE = new AstError();
 
-bool AstError::IsError() const
+AstError::AstError()
+	: IAst(AST_KIND::AST_ERROR)
 {
-	return true;
 }
 
 void AstError::accept(IVisitor &v)
@@ -52,14 +37,10 @@ void AstError::accept(IVisitor &v)
 //  AstExpression
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
-AstExpression::AstExpression(DataType exprType)
-	: m_type(exprType)
-{
-}
-
-bool AstExpression::IsExpression() const
+AstExpression::AstExpression(AST_KIND kind, DataType exprType)
+	: IAst(kind)
+	, m_type(exprType)
 {
-	return true;
 }
 
 bool AstExpression::IsNumeric() const
@@ -77,13 +58,18 @@ const DataType &AstExpression::GetType() const
 //  AstVariable
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
-AstVariable::AstVariable(const string &varName, DataType varType)
-	: AstExpression(varType)
+AstVariable::AstVariable(Atom varName, DataType varType)
+	: AstExpression(AST_KIND::AST_VARIABLE, varType)
 	, m_varName(varName)
 {
 }
 
 const string &AstVariable::GetName() const
+{
+	return Interner::GetString(m_varName);
+}
+
+Atom AstVariable::GetAtom() const
 {
 	return m_varName;
 }
@@ -97,14 +83,14 @@ void AstVariable::accept(IVisitor &v)
 //  AstUnaryExpression
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
-AstUnaryExpression::AstUnaryExpression(KEYWORD op, shared_ptr<IAst> expr)
-	: AstExpression(GetExpressionType(expr))
+AstUnaryExpression::AstUnaryExpression(KEYWORD op, IAst *expr)
+	: AstExpression(AST_KIND::AST_UNARY, GetExpressionType(expr))
 	, m_op(op)
 	, m_expr(expr)
 {
 }
 
-shared_ptr<IAst> AstUnaryExpression::GetExpression() const
+IAst *AstUnaryExpression::GetExpression() const
 {
 	return m_expr;
 }
@@ -119,34 +105,34 @@ void AstUnaryExpression::accept(IVisitor &v)
 	v.visit(*this);
 }
 
-DataType AstUnaryExpression::GetExpressionType(shared_ptr<IAst> expr)
+DataType AstUnaryExpression::GetExpressionType(IAst *expr)
 {
 	if (!expr->IsExpression())
 	{
 		throw InternalError("Attempt to create AstUnaryExpression from non AstExpression based node");
 	}
 
-	return dynamic_cast<AstExpression*>(expr.get())->GetType();
+	return Cast<AstExpression>(expr)->GetType();
 }
 
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 //  AstBinaryExpression
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
-AstBinaryExpression::AstBinaryExpression(shared_ptr<IAst> left, KEYWORD op, shared_ptr<IAst> right)
-	: AstExpression(GetExpressionType(left, op, right, m_inType))
+AstBinaryExpression::AstBinaryExpression(IAst *left, KEYWORD op, IAst *right)
+	: AstExpression(AST_KIND::AST_BINARY, GetExpressionType(left, op, right, m_inType))
 	, m_left(left)
 	, m_op(op)
 	, m_right(right)
 {
 }
 
-shared_ptr<IAst> AstBinaryExpression::GetLeft() const
+IAst *AstBinaryExpression::GetLeft() const
 {
 	return m_left;
 }
 
-shared_ptr<IAst> AstBinaryExpression::GetRight() const
+IAst *AstBinaryExpression::GetRight() const
 {
 	return m_right;
 }
@@ -166,15 +152,15 @@ void AstBinaryExpression::accept(IVisitor &v)
 	v.visit(*this);
 }
 
-DataType AstBinaryExpression::GetExpressionType(shared_ptr<IAst> left, KEYWORD op, shared_ptr<IAst> right, DATA_TYPE &inType)
+DataType AstBinaryExpression::GetExpressionType(IAst *left, KEYWORD op, IAst *right, DATA_TYPE &inType)
 {
 	if (!left->IsExpression() || !right->IsExpression())
 	{
 		throw InternalError("Attempt to create AstBinaryExpression from non AstExpression based node");
 	}
 
-	AstExpression *leftEx = dynamic_cast<AstExpression*>(left.get());
-	AstExpression *rightEx = dynamic_cast<AstExpression*>(right.get());
+	AstExpression *leftEx = Cast<AstExpression>(left);
+	AstExpression *rightEx = Cast<AstExpression>(right);
 
 	if (leftEx->GetType() != rightEx->GetType())
 	{
@@ -203,8 +189,9 @@ DataType AstBinaryExpression::GetExpressionType(shared_ptr<IAst> left, KEYWORD o
 //  AstAssignmentExpression
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
-AstAssignmentExpression::AstAssignmentExpression(shared_ptr<AstVariable> variable, shared_ptr<AstExpression> expression)
-	: m_variable(variable)
+AstAssignmentExpression::AstAssignmentExpression(AstVariable *variable, AstExpression *expression)
+	: IAst(AST_KIND::AST_ASSIGNMENT)
+	, m_variable(variable)
 	, m_expression(expression)
 {
 	if (m_variable->GetType() != m_expression->GetType())
@@ -214,12 +201,12 @@ AstAssignmentExpression::AstAssignmentExpression(shared_ptr<AstVariable> variabl
 	}
 }
 
-shared_ptr<AstVariable> AstAssignmentExpression::GetVariable() const
+AstVariable *AstAssignmentExpression::GetVariable() const
 {
 	return m_variable;
 }
 
-shared_ptr<AstExpression> AstAssignmentExpression::GetExpression() const
+AstExpression *AstAssignmentExpression::GetExpression() const
 {
 	return m_expression;
 }
@@ -234,12 +221,14 @@ void AstAssignmentExpression::accept(IVisitor &v)
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
 AstReturn::AstReturn()
-	: m_expr(nullptr)
+	: IAst(AST_KIND::AST_RETURN)
+	, m_expr(nullptr)
 {
 }
 
-AstReturn::AstReturn(shared_ptr<AstExpression> expr)
-	: m_expr(expr)
+AstReturn::AstReturn(AstExpression *expr)
+	: IAst(AST_KIND::AST_RETURN)
+	, m_expr(expr)
 {
 }
 
@@ -248,7 +237,7 @@ bool AstReturn::HasExpression() const
 	return m_expr != nullptr;
 }
 
-shared_ptr<AstExpression> AstReturn::GetExpression() const
+AstExpression *AstReturn::GetExpression() const
 {
 	return m_expr;
 }
@@ -263,15 +252,27 @@ void AstReturn::accept(IVisitor &v)
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
 AstList::AstList()
+	: IAst(AST_KIND::AST_LIST)
 {
 }
 
-void AstList::AddElement(shared_ptr<IAst> statement)
+void AstList::AddElement(IAst *statement)
 {
 	m_statements.push_back(statement);
 }
 
-const vector<shared_ptr<IAst>> &AstList::GetElements() const
+void AstList::ReplaceElements(size_t first, size_t last, const vector<IAst *> &elements)
+{
+	if (elements.size() == last - first)
+	{
+		copy(elements.begin(), elements.end(), m_statements.begin() + first);
+		return;
+	}
+	m_statements.erase(m_statements.begin() + first, m_statements.begin() + last);
+	m_statements.insert(m_statements.begin() + first, elements.begin(), elements.end());
+}
+
+const vector<IAst *> &AstList::GetElements() const
 {
 	return m_statements;
 }
@@ -290,8 +291,9 @@ void AstList::accept(IVisitor &v)
 //  AstFunction
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
-AstFunction::AstFunction(const string &name, DataType returnType, shared_ptr<AstList> arguments, shared_ptr<AstList> code)
-	: m_name(name)
+AstFunction::AstFunction(Atom name, DataType returnType, AstList *arguments, AstList *code)
+	: IAst(AST_KIND::AST_FUNCTION)
+	, m_name(name)
 	, m_returnType(returnType)
 	, m_code(code)
 	, m_arguments(arguments)
@@ -299,6 +301,11 @@ AstFunction::AstFunction(const string &name, DataType returnType, shared_ptr<Ast
 }
 
 const string &AstFunction::GetName() const
+{
+	return Interner::GetString(m_name);
+}
+
+Atom AstFunction::GetAtom() const
 {
 	return m_name;
 }
@@ -308,12 +315,12 @@ const DataType &AstFunction::GetReturnType() const
 	return m_returnType;
 }
 
-shared_ptr<AstList> AstFunction::GetArguments() const
+AstList *AstFunction::GetArguments() const
 {
 	return m_arguments;
 }
 
-shared_ptr<AstList> AstFunction::GetCode() const
+AstList *AstFunction::GetCode() const
 {
 	return m_code;
 }
@@ -327,12 +334,13 @@ void AstFunction::accept(IVisitor &v)
 //  AstGlobal
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
-AstGlobal::AstGlobal(shared_ptr<AstList> declList)
-	: m_declList(declList)
+AstGlobal::AstGlobal(AstList *declList)
+	: IAst(AST_KIND::AST_GLOBAL)
+	, m_declList(declList)
 {
 }
 
-shared_ptr<AstList> AstGlobal::GetDeclarations() const
+AstList *AstGlobal::GetDeclarations() const
 {
 	return m_declList;
 }
@@ -346,19 +354,24 @@ void AstGlobal::accept(IVisitor &v)
 //  AstFunctionCall
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
-AstFunctionCall::AstFunctionCall(const string &functionName, const DataType &returnType, shared_ptr<AstList> arguments)
-	: AstExpression(returnType)
+AstFunctionCall::AstFunctionCall(Atom functionName, const DataType &returnType, AstList *arguments)
+	: AstExpression(AST_KIND::AST_CALL, returnType)
 	, m_name(functionName)
 	, m_args(arguments)
 {
 }
 
 const string &AstFunctionCall::GetName() const
+{
+	return Interner::GetString(m_name);
+}
+
+Atom AstFunctionCall::GetAtom() const
 {
 	return m_name;
 }
 
-shared_ptr<AstList> AstFunctionCall::GetArguments() const
+AstList *AstFunctionCall::GetArguments() const
 {
 	return m_args;
 }
@@ -372,12 +385,13 @@ void AstFunctionCall::accept(IVisitor &v)
 //  AstIf
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
-AstIf::AstIf(shared_ptr<IAst> condition,
-	shared_ptr<IAst> consequent, shared_ptr<IAst> alternative)
-	: m_consequent(consequent)
+AstIf::AstIf(IAst *condition,
+	IAst *consequent, IAst *alternative)
+	: IAst(AST_KIND::AST_IF)
+	, m_consequent(consequent)
 	, m_alternative(alternative)
 {
-	m_condition = dynamic_pointer_cast<AstExpression>(condition);
+	m_condition = DynCast<AstExpression>(condition);
 	if (m_condition == nullptr)
 	{
 		throw InternalError("AstIf::AstIf: condition is not an expression");
@@ -388,17 +402,17 @@ AstIf::AstIf(shared_ptr<IAst> condition,
 	}
 }
 
-shared_ptr<AstExpression> AstIf::GetCondition() const
+AstExpression *AstIf::GetCondition() const
 {
 	return m_condition;
 }
 
-shared_ptr<IAst> AstIf::GetConsequent() const
+IAst *AstIf::GetConsequent() const
 {
 	return m_consequent;
 }
 
-shared_ptr<IAst> AstIf::GetAlternative() const
+IAst *AstIf::GetAlternative() const
 {
 	return m_alternative;
 }
@@ -418,7 +432,7 @@ void AstIf::accept(IVisitor &v)
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
 AstNewDict::AstNewDict(ATOMIC_TYPE keyType, ATOMIC_TYPE valueType)
-	: AstExpression(DataType(keyType, valueType))
+	: AstExpression(AST_KIND::AST_NEW_DICT, DataType(keyType, valueType))
 {
 }
 
@@ -431,12 +445,12 @@ void AstNewDict::accept(IVisitor &v)
 //  AstDictValue
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
-AstDictValue::AstDictValue(const string &dictName, ATOMIC_TYPE keyType, ATOMIC_TYPE valueType, shared_ptr<IAst> key)
-	: AstExpression(DataType(valueType))
+AstDictValue::AstDictValue(Atom dictName, ATOMIC_TYPE keyType, ATOMIC_TYPE valueType, IAst *key)
+	: AstExpression(AST_KIND::AST_DICT_VALUE, DataType(valueType))
 	, m_dictType(keyType, valueType)
 	, m_name(dictName)
 {
-	m_key = dynamic_pointer_cast<AstExpression>(key);
+	m_key = DynCast<AstExpression>(key);
 	if (m_key == nullptr)
 	{
 		throw InternalError("AstDictValue: key must be an expression");
@@ -447,7 +461,7 @@ AstDictValue::AstDictValue(const string &dictName, ATOMIC_TYPE keyType, ATOMIC_T
 	}
 }
 
-shared_ptr<AstExpression> AstDictValue::GetKey() const
+AstExpression *AstDictValue::GetKey() const
 {
 	return m_key;
 }
@@ -458,6 +472,11 @@ const DataType &AstDictValue::GetDictType() const
 }
 
 const string &AstDictValue::GetName() const
+{
+	return Interner::GetString(m_name);
+}
+
+Atom AstDictValue::GetAtom() const
 {
 	return m_name;
 }
@@ -471,18 +490,19 @@ void AstDictValue::accept(IVisitor &v)
 //  AstDictAssign
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
-AstDictAssign::AstDictAssign(std::shared_ptr<AstDictValue> dict, std::shared_ptr<AstExpression> expression)
-	: m_dict(dict)
+AstDictAssign::AstDictAssign(AstDictValue *dict, AstExpression *expression)
+	: IAst(AST_KIND::AST_DICT_ASSIGN)
+	, m_dict(dict)
 	, m_expression(expression)
 {
 }
 
-std::shared_ptr<AstDictValue> AstDictAssign::GetDictValue() const
+AstDictValue *AstDictAssign::GetDictValue() const
 {
 	return m_dict;
 }
 
-std::shared_ptr<AstExpression> AstDictAssign::GetExpression() const
+AstExpression *AstDictAssign::GetExpression() const
 {
 	return m_expression;;
 }
@@ -497,7 +517,8 @@ void AstDictAssign::accept(IVisitor &v)
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
 AstConstantDecl::AstConstantDecl(shared_ptr<ConstantBase> constant)
-	: m_const(constant)
+	: IAst(AST_KIND::AST_CONSTANT_DECL)
+	, m_const(constant)
 {
 }
 
@@ -515,11 +536,16 @@ void AstConstantDecl::accept(IVisitor &v)
 //  AstFor
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
-AstFor::AstFor(shared_ptr<IAst> from, shared_ptr<IAst> to,
-	shared_ptr<IAst> step, shared_ptr<IAst> code)
-	: m_code(code)
+// Default steps are shared by all the loops that have no 'step'
+static AstIntConst INT_STEP(1);
+static AstFloatConst FLOAT_STEP(1.0);
+
+AstFor::AstFor(IAst *from, IAst *to,
+	IAst *step, IAst *code)
+	: IAst(AST_KIND::AST_FOR)
+	, m_code(code)
 {
-	m_from = dynamic_pointer_cast<AstAssignmentExpression>(from);
+	m_from = DynCast<AstAssignmentExpression>(from);
 	if (!m_from)
 	{
 		throw InternalError("AstFor::AstFor: from must be AstAssignmentExpression");
@@ -530,7 +556,7 @@ AstFor::AstFor(shared_ptr<IAst> from, shared_ptr<IAst> to,
 	}
 	DATA_TYPE counterType = m_from->GetVariable()->GetType().GetType();
 
-	m_to = dynamic_pointer_cast<AstExpression>(to);
+	m_to = DynCast<AstExpression>(to);
 	if (!m_to)
 	{
 		throw InternalError("AstFor::AstFor: to must be AstExpression");
@@ -542,7 +568,7 @@ AstFor::AstFor(shared_ptr<IAst> from, shared_ptr<IAst> to,
 
 	if (step)
 	{
-		m_step = dynamic_pointer_cast<AstExpression>(step);
+		m_step = DynCast<AstExpression>(step);
 		if (!m_step)
 		{
 			throw InternalError("AstFor::AstFor: step must be AstExpression");
@@ -556,11 +582,11 @@ AstFor::AstFor(shared_ptr<IAst> from, shared_ptr<IAst> to,
 	{
 		if (counterType == DATA_TYPE::TYPE_INT)
 		{
-			m_step = make_shared<AstIntConst>(1);
+			m_step = &INT_STEP;
 		}
 		else if (counterType == DATA_TYPE::TYPE_FLOAT)
 		{
-			m_step = make_shared<AstFloatConst>(1.0);
+			m_step = &FLOAT_STEP;
 		}
 		else
 		{
@@ -569,22 +595,22 @@ AstFor::AstFor(shared_ptr<IAst> from, shared_ptr<IAst> to,
 	}
 }
 
-shared_ptr<AstAssignmentExpression> AstFor::GetFrom() const
+AstAssignmentExpression *AstFor::GetFrom() const
 {
 	return m_from;
 }
 
-shared_ptr<AstExpression> AstFor::GetTo() const
+AstExpression *AstFor::GetTo() const
 {
 	return m_to;
 }
 
-shared_ptr<AstExpression> AstFor::GetStep() const
+AstExpression *AstFor::GetStep() const
 {
 	return m_step;
 }
 
-shared_ptr<IAst> AstFor::GetCode() const
+IAst *AstFor::GetCode() const
 {
 	return m_code;
 }
@@ -598,12 +624,13 @@ void AstFor::accept(IVisitor &v)
 //  AstWhile
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
-AstWhile::AstWhile(shared_ptr<IAst> condition, shared_ptr<IAst> code,
+AstWhile::AstWhile(IAst *condition, IAst *code,
 	bool isDoWhile)
-	: m_dowhile(isDoWhile)
+	: IAst(AST_KIND::AST_WHILE)
+	, m_dowhile(isDoWhile)
 	, m_code(code)
 {
-	m_condition = dynamic_pointer_cast<AstExpression>(condition);
+	m_condition = DynCast<AstExpression>(condition);
 	if (!m_condition)
 	{
 		throw InternalError("AstWhile::AstWhile: condition must be AstExpression");
@@ -614,12 +641,12 @@ AstWhile::AstWhile(shared_ptr<IAst> condition, shared_ptr<IAst> code,
 	}
 }
 
-shared_ptr<AstExpression> AstWhile::GetCondition() const
+AstExpression *AstWhile::GetCondition() const
 {
 	return m_condition;
 }
 
-shared_ptr<IAst> AstWhile::GetCode() const
+IAst *AstWhile::GetCode() const
 {
 	return m_code;
 }
@@ -638,13 +665,13 @@ void AstWhile::accept(IVisitor &v)
 //  AstNewArray
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
-AstNewArray::AstNewArray(ATOMIC_TYPE dataType, shared_ptr<AstList> dimensions)
-	: AstExpression(DataType(dimensions->GetElements().size(), dataType))
+AstNewArray::AstNewArray(ATOMIC_TYPE dataType, AstList *dimensions)
+	: AstExpression(AST_KIND::AST_NEW_ARRAY, DataType(dimensions->GetElements().size(), dataType))
 	, m_baseType(dataType)
 {
 	for (auto dimAst : dimensions->GetElements())
 	{
-		shared_ptr<AstExpression> dimExpr = dynamic_pointer_cast<AstExpression>(dimAst);
+		AstExpression *dimExpr = DynCast<AstExpression>(dimAst);
 		if (!dimExpr)
 		{
 			throw InternalError("AstNewArray::AstNewArray: dimExpr is not AstExpression");
@@ -658,7 +685,7 @@ AstNewArray::AstNewArray(ATOMIC_TYPE dataType, shared_ptr<AstList> dimensions)
 	}
 }
 
-const vector<shared_ptr<AstExpression>> &AstNewArray::GetDimensions() const
+const vector<AstExpression *> &AstNewArray::GetDimensions() const
 {
 	return m_dimensions;
 }
@@ -677,9 +704,9 @@ void AstNewArray::accept(IVisitor &v)
 //  AstArrayValue
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
-AstArrayValue::AstArrayValue(const string &name, ATOMIC_TYPE arrayType,
-	shared_ptr<AstList> indexes)
-	: AstExpression(DataType(arrayType))
+AstArrayValue::AstArrayValue(Atom name, ATOMIC_TYPE arrayType,
+	AstList *indexes)
+	: AstExpression(AST_KIND::AST_ARRAY_VALUE, DataType(arrayType))
 	, m_indexes(indexes)
 	, m_name(name)
 {
@@ -693,7 +720,7 @@ AstArrayValue::AstArrayValue(const string &name, ATOMIC_TYPE arrayType,
 
 	for (auto indexAst : elem)
 	{
-		auto index = dynamic_pointer_cast<AstExpression>(indexAst);
+		auto index = DynCast<AstExpression>(indexAst);
 		if (!index)
 		{
 			throw InternalError("AstArrayValue::AstArrayValue: index must be AstExpression");
@@ -706,11 +733,16 @@ AstArrayValue::AstArrayValue(const string &name, ATOMIC_TYPE arrayType,
 }
 
 const string &AstArrayValue::GetName() const
+{
+	return Interner::GetString(m_name);
+}
+
+Atom AstArrayValue::GetAtom() const
 {
 	return m_name;
 }
 
-shared_ptr<AstList> AstArrayValue::GetIndexes() const
+AstList *AstArrayValue::GetIndexes() const
 {
 	return m_indexes;
 }
@@ -729,15 +761,16 @@ void AstArrayValue::accept(IVisitor &v)
 //  AstArrayAssign
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
-AstArrayAssign::AstArrayAssign(shared_ptr<IAst> elem, shared_ptr<IAst> expression)
+AstArrayAssign::AstArrayAssign(IAst *elem, IAst *expression)
+	: IAst(AST_KIND::AST_ARRAY_ASSIGN)
 {
-	m_elem = dynamic_pointer_cast<AstArrayValue>(elem);
+	m_elem = DynCast<AstArrayValue>(elem);
 	if (!m_elem)
 	{
 		throw InternalError("AstArrayAssign::AstArrayAssign: elem must be AstArrayValue");
 	}
 
-	m_expression = dynamic_pointer_cast<AstExpression>(expression);
+	m_expression = DynCast<AstExpression>(expression);
 	if (!m_expression)
 	{
 		throw InternalError("AstArrayAssign::AstArrayAssign: expression must be AstExpression");
@@ -749,12 +782,12 @@ AstArrayAssign::AstArrayAssign(shared_ptr<IAst> elem, shared_ptr<IAst> expressio
 	}
 }
 
-shared_ptr<AstArrayValue> AstArrayAssign::GetElem() const
+AstArrayValue *AstArrayAssign::GetElem() const
 {
 	return m_elem;
 }
 
-shared_ptr<AstExpression> AstArrayAssign::GetExpression() const
+AstExpression *AstArrayAssign::GetExpression() const
 {
 	return m_expression;
 }
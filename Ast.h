@@ -2,44 +2,116 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <assert.h>
 #include "DataType.h"
 #include "Visitor.h"
 #include "Token.h"
 #include "Constant.h"
-
+#include "Interner.h"
+
+// Node of the syntax tree
+// - Nodes are made by AstContext (see AstContext.h), which owns them;
+// children are plain pointers to the nodes of the same context or of
+// the contexts it retains
+// - Nodes aren't changed after they are made
+// - Every node has the kind of its class, set by the constructor, so the
+// class of a node is found by Isa<>(), Cast<>() and DynCast<>() without RTTI;
+// each class has ClassOf(), which tells if a kind belongs to the class
 class IAst
 {
 protected:
-	IAst();
+	IAst(AST_KIND kind);
 
 public:
 	virtual ~IAst();
 
-	virtual bool IsExpression() const;
-	virtual bool IsConstant() const;
-	virtual bool IsError() const;
+	AST_KIND GetKind() const
+	{
+		return m_kind;
+	}
+
+	bool IsExpression() const
+	{
+		return m_kind >= AST_KIND::AST_INT_CONST && m_kind <= AST_KIND::AST_DICT_VALUE;
+	}
+
+	bool IsConstant() const
+	{
+		return m_kind >= AST_KIND::AST_INT_CONST && m_kind <= AST_KIND::AST_BOOL_CONST;
+	}
+
+	bool IsError() const
+	{
+		return m_kind == AST_KIND::AST_ERROR;
+	}
 
 	virtual void accept(IVisitor &v) = 0;
+
+private:
+	AST_KIND m_kind;
 };
 
+// Checks if the node is of class T (or derived from it)
+template<class T> bool Isa(const IAst *node)
+{
+	return T::ClassOf(node->GetKind());
+}
+
+// Converts the node to class T, which it must be of
+template<class T> T *Cast(IAst *node)
+{
+	assert(Isa<T>(node));
+	return static_cast<T *>(node);
+}
+
+template<class T> const T *Cast(const IAst *node)
+{
+	assert(Isa<T>(node));
+	return static_cast<const T *>(node);
+}
+
+// Converts the node to class T, returns nullptr if the node is null
+// or isn't of class T
+template<class T> T *DynCast(IAst *node)
+{
+	return node && Isa<T>(node) ? static_cast<T *>(node) : nullptr;
+}
+
+template<class T> const T *DynCast(const IAst *node)
+{
+	return node && Isa<T>(node) ? static_cast<const T *>(node) : nullptr;
+}
+
+// Returned by the parser when a rule doesn't match the tokens
+// - All failures share one instance, so a failed attempt costs no allocation
 class AstError : public IAst
 {
 public:
-	AstError();
+	static IAst *const INSTANCE;
 
-	bool IsError() const override;
+	static bool ClassOf(AST_KIND kind)
+	{
+		return kind == AST_KIND::AST_ERROR;
+	}
 
 	void accept(IVisitor &v) override;
+
+private:
+	AstError();
 };
 
 // Anything that has a return value is based off this class
 class AstExpression : public IAst
 {
 protected:
-	AstExpression(DataType exprType);
+	AstExpression(AST_KIND kind, DataType exprType);
 
 public:
-	bool IsExpression() const override;
+	static bool ClassOf(AST_KIND kind)
+	{
+		return kind >= AST_KIND::AST_INT_CONST && kind <= AST_KIND::AST_DICT_VALUE;
+	}
+
 	bool IsNumeric() const;
 
 	const DataType &GetType() const;
@@ -48,19 +120,35 @@ private:
 	DataType m_type;
 };
 
+// Kind of the constants of the type
+inline AST_KIND GetConstantKind(ATOMIC_TYPE type)
+{
+	switch (type)
+	{
+	case ATOMIC_TYPE::TYPE_INT:
+		return AST_KIND::AST_INT_CONST;
+	case ATOMIC_TYPE::TYPE_FLOAT:
+		return AST_KIND::AST_FLOAT_CONST;
+	case ATOMIC_TYPE::TYPE_STRING:
+		return AST_KIND::AST_STRING_CONST;
+	default:
+		return AST_KIND::AST_BOOL_CONST;
+	}
+}
+
 // Constant (has a name, data type and a value)
 template<class T, ATOMIC_TYPE DATA_TYPE> class AstConstant : public AstExpression
 {
 public:
 	AstConstant(T value)
-		: AstExpression(DATA_TYPE)
+		: AstExpression(GetConstantKind(DATA_TYPE), DATA_TYPE)
 		, m_value(value)
 	{
 	}
 
-	bool IsConstant() const override
+	static bool ClassOf(AST_KIND kind)
 	{
-		return true;
+		return kind == GetConstantKind(DATA_TYPE);
 	}
 
 	T GetValue() const
@@ -83,40 +171,56 @@ private:
 class AstVariable : public AstExpression
 {
 public:
-	AstVariable(const std::string &varName, DataType varType);
+	AstVariable(Atom varName, DataType varType);
+
+	static bool ClassOf(AST_KIND kind)
+	{
+		return kind == AST_KIND::AST_VARIABLE;
+	}
 
 	const std::string &GetName() const;
+	Atom GetAtom() const;
 
 	void accept(IVisitor &v) override;
 
 private:
-	std::string m_varName;
+	Atom m_varName;
 };
 
 class AstUnaryExpression : public AstExpression
 {
 public:
-	AstUnaryExpression(KEYWORD op, std::shared_ptr<IAst> expr);
+	AstUnaryExpression(KEYWORD op, IAst *expr);
 
-	std::shared_ptr<IAst> GetExpression() const;
+	static bool ClassOf(AST_KIND kind)
+	{
+		return kind == AST_KIND::AST_UNARY;
+	}
+
+	IAst *GetExpression() const;
 	KEYWORD GetOperator() const;
 
 	void accept(IVisitor &v) override;
 
 private:
-	std::shared_ptr<IAst> m_expr;
+	IAst *m_expr;
 	KEYWORD m_op;
 
-	static DataType GetExpressionType(std::shared_ptr<IAst> expr);
+	static DataType GetExpressionType(IAst *expr);
 };
 
 class AstBinaryExpression : public AstExpression
 {
 public:
-	AstBinaryExpression(std::shared_ptr<IAst> left, KEYWORD op, std::shared_ptr<IAst> right);
+	AstBinaryExpression(IAst *left, KEYWORD op, IAst *right);
 
-	std::shared_ptr<IAst> GetLeft() const;
-	std::shared_ptr<IAst> GetRight() const;
+	static bool ClassOf(AST_KIND kind)
+	{
+		return kind == AST_KIND::AST_BINARY;
+	}
+
+	IAst *GetLeft() const;
+	IAst *GetRight() const;
 	KEYWORD GetOperator() const;
 
 	// Type of left and right parts of the expression
@@ -126,28 +230,33 @@ public:
 	void accept(IVisitor &v) override;
 
 private:
-	std::shared_ptr<IAst> m_left, m_right;
+	IAst *m_left, *m_right;
 	KEYWORD m_op;
 	DATA_TYPE m_inType;
 
-	static DataType GetExpressionType(std::shared_ptr<IAst> left, KEYWORD op,
-		std::shared_ptr<IAst> right, DATA_TYPE &inType);
+	static DataType GetExpressionType(IAst *left, KEYWORD op,
+		IAst *right, DATA_TYPE &inType);
 };
 
 // variable = expression
 class AstAssignmentExpression : public IAst
 {
 public:
-	AstAssignmentExpression(std::shared_ptr<AstVariable> variable, std::shared_ptr<AstExpression> expression);
+	AstAssignmentExpression(AstVariable *variable, AstExpression *expression);
+
+	static bool ClassOf(AST_KIND kind)
+	{
+		return kind == AST_KIND::AST_ASSIGNMENT;
+	}
 
-	std::shared_ptr<AstVariable> GetVariable() const;
-	std::shared_ptr<AstExpression> GetExpression() const;
+	AstVariable *GetVariable() const;
+	AstExpression *GetExpression() const;
 
 	void accept(IVisitor &v) override;
 
 private:
-	std::shared_ptr<AstVariable> m_variable;
-	std::shared_ptr<AstExpression> m_expression;
+	AstVariable *m_variable;
+	AstExpression *m_expression;
 };
 
 // return statement
@@ -157,15 +266,20 @@ public:
 	// return (from procedure)
 	AstReturn();
 	// return ... (from function)
-	AstReturn(std::shared_ptr<AstExpression> expr);
+	AstReturn(AstExpression *expr);
+
+	static bool ClassOf(AST_KIND kind)
+	{
+		return kind == AST_KIND::AST_RETURN;
+	}
 
 	bool HasExpression() const;
-	std::shared_ptr<AstExpression> GetExpression() const;
+	AstExpression *GetExpression() const;
 
 	void accept(IVisitor &v) override;
 
 private:
-	std::shared_ptr<AstExpression> m_expr;
+	AstExpression *m_expr;
 };
 
 // Container for a sequence of IAst references
@@ -174,88 +288,117 @@ class AstList : public IAst
 public:
 	AstList();
 
-	void AddElement(std::shared_ptr<IAst> statement);
-	const std::vector<std::shared_ptr<IAst>> &GetElements() const;
+	static bool ClassOf(AST_KIND kind)
+	{
+		return kind == AST_KIND::AST_LIST;
+	}
+
+	void AddElement(IAst *statement);
+	// Replaces the elements [first, last) with the given ones
+	void ReplaceElements(size_t first, size_t last, const std::vector<IAst *> &elements);
+	const std::vector<IAst *> &GetElements() const;
 	bool IsEmpty() const;
 
 	void accept(IVisitor &v) override;
 
 private:
-	std::vector<std::shared_ptr<IAst>> m_statements;
+	std::vector<IAst *> m_statements;
 };
 
 // Everything about a function, including its code
 class AstFunction : public IAst
 {
 public:
-	AstFunction(const std::string &name, DataType returnType,
-		std::shared_ptr<AstList> arguments, std::shared_ptr<AstList> code);
+	AstFunction(Atom name, DataType returnType,
+		AstList *arguments, AstList *code);
+
+	static bool ClassOf(AST_KIND kind)
+	{
+		return kind == AST_KIND::AST_FUNCTION;
+	}
 
 	const std::string &GetName() const;
+	Atom GetAtom() const;
 	const DataType &GetReturnType() const;
-	std::shared_ptr<AstList> GetArguments() const;
-	std::shared_ptr<AstList> GetCode() const;
+	AstList *GetArguments() const;
+	AstList *GetCode() const;
 
 	void accept(IVisitor &v) override;
 
 private:
-	std::string m_name;
+	Atom m_name;
 	DataType m_returnType;
-	std::shared_ptr<AstList> m_arguments;
-	std::shared_ptr<AstList> m_code;
+	AstList *m_arguments;
+	AstList *m_code;
 };
 
 class AstGlobal : public IAst
 {
 public:
-	AstGlobal(std::shared_ptr<AstList> declList);
+	AstGlobal(AstList *declList);
+
+	static bool ClassOf(AST_KIND kind)
+	{
+		return kind == AST_KIND::AST_GLOBAL;
+	}
 
-	std::shared_ptr<AstList> GetDeclarations() const;
+	AstList *GetDeclarations() const;
 
 	void accept(IVisitor &v) override;
 
 private:
-	std::shared_ptr<AstList> m_declList;
+	AstList *m_declList;
 };
 
 class AstFunctionCall : public AstExpression
 {
 public:
-	AstFunctionCall(const std::string &functionName,
-		const DataType &returnType, std::shared_ptr<AstList> arguments);
+	AstFunctionCall(Atom functionName,
+		const DataType &returnType, AstList *arguments);
+
+	static bool ClassOf(AST_KIND kind)
+	{
+		return kind == AST_KIND::AST_CALL;
+	}
 
 	const std::string &GetName() const;
-	std::shared_ptr<AstList> GetArguments() const;
+	Atom GetAtom() const;
+	AstList *GetArguments() const;
 
 	void accept(IVisitor &v) override;
 
 private:
-	std::string m_name;
-	std::shared_ptr<AstList> m_args;
+	Atom m_name;
+	AstList *m_args;
 };
 
 // If statement
 class AstIf : public IAst
 {
 public:
-	AstIf(std::shared_ptr<IAst> condition,
-		std::shared_ptr<IAst> consequent, std::shared_ptr<IAst> alternative);
+	AstIf(IAst *condition,
+		IAst *consequent, IAst *alternative);
+
+	static bool ClassOf(AST_KIND kind)
+	{
+		return kind == AST_KIND::AST_IF;
+	}
 
-	std::shared_ptr<AstExpression> GetCondition() const;
+	AstExpression *GetCondition() const;
 	// Consequent is a part of code that executes when condition is true
-	std::shared_ptr<IAst> GetConsequent() const;
+	IAst *GetConsequent() const;
 	// Alternative is a part of code that executes when condition is false (after else)
 	// In case an if statement has no else clause, GetAlternative() returns nullptr
-	std::shared_ptr<IAst> GetAlternative() const;
+	IAst *GetAlternative() const;
 
 	bool HasElse() const;
 
 	void accept(IVisitor &v) override;
 
 private:
-	std::shared_ptr<AstExpression> m_condition;
-	std::shared_ptr<IAst> m_consequent;
-	std::shared_ptr<IAst> m_alternative;
+	AstExpression *m_condition;
+	IAst *m_consequent;
+	IAst *m_alternative;
 };
 
 // While: 'while' Expression Code
@@ -263,18 +406,23 @@ private:
 class AstWhile : public IAst
 {
 public:
-	AstWhile(std::shared_ptr<IAst> condition, std::shared_ptr<IAst> code,
+	AstWhile(IAst *condition, IAst *code,
 		bool isDoWhile);
 
-	std::shared_ptr<AstExpression> GetCondition() const;
-	std::shared_ptr<IAst> GetCode() const;
+	static bool ClassOf(AST_KIND kind)
+	{
+		return kind == AST_KIND::AST_WHILE;
+	}
+
+	AstExpression *GetCondition() const;
+	IAst *GetCode() const;
 	bool IsDoWhile() const;
 
 	void accept(IVisitor &v) override;
 
 private:
-	std::shared_ptr<AstExpression> m_condition;
-	std::shared_ptr<IAst> m_code;
+	AstExpression *m_condition;
+	IAst *m_code;
 	bool m_dowhile;
 };
 
@@ -284,36 +432,46 @@ class AstFor : public IAst
 public:
 	// step can be null
 	// in that case it'll be default (1)
-	AstFor(std::shared_ptr<IAst> from, std::shared_ptr<IAst> to,
-		std::shared_ptr<IAst> step, std::shared_ptr<IAst> code);
+	AstFor(IAst *from, IAst *to,
+		IAst *step, IAst *code);
 
-	std::shared_ptr<AstAssignmentExpression> GetFrom() const;
-	std::shared_ptr<AstExpression> GetTo() const;
-	std::shared_ptr<AstExpression> GetStep() const;
-	std::shared_ptr<IAst> GetCode() const;
+	static bool ClassOf(AST_KIND kind)
+	{
+		return kind == AST_KIND::AST_FOR;
+	}
+
+	AstAssignmentExpression *GetFrom() const;
+	AstExpression *GetTo() const;
+	AstExpression *GetStep() const;
+	IAst *GetCode() const;
 
 	void accept(IVisitor &v) override;
 
 private:
-	std::shared_ptr<AstAssignmentExpression> m_from;
-	std::shared_ptr<AstExpression> m_to;
-	std::shared_ptr<AstExpression> m_step;
-	std::shared_ptr<IAst> m_code;
+	AstAssignmentExpression *m_from;
+	AstExpression *m_to;
+	AstExpression *m_step;
+	IAst *m_code;
 };
 
 // new array%(10, 10, 20)
 class AstNewArray : public AstExpression
 {
 public:
-	AstNewArray(ATOMIC_TYPE dataType, std::shared_ptr<AstList> dimensions);
+	AstNewArray(ATOMIC_TYPE dataType, AstList *dimensions);
+
+	static bool ClassOf(AST_KIND kind)
+	{
+		return kind == AST_KIND::AST_NEW_ARRAY;
+	}
 
-	const std::vector<std::shared_ptr<AstExpression>> &GetDimensions() const;
+	const std::vector<AstExpression *> &GetDimensions() const;
 	ATOMIC_TYPE GetBaseType() const;
 
 	void accept(IVisitor &v) override;
 
 private:
-	std::vector<std::shared_ptr<AstExpression>> m_dimensions;
+	std::vector<AstExpression *> m_dimensions;
 	ATOMIC_TYPE m_baseType;
 };
 
@@ -321,34 +479,45 @@ private:
 class AstArrayValue : public AstExpression
 {
 public:
-	AstArrayValue(const std::string &name, ATOMIC_TYPE arrayType,
-		std::shared_ptr<AstList> indexes);
+	AstArrayValue(Atom name, ATOMIC_TYPE arrayType,
+		AstList *indexes);
+
+	static bool ClassOf(AST_KIND kind)
+	{
+		return kind == AST_KIND::AST_ARRAY_VALUE;
+	}
 
 	const std::string &GetName() const;
-	std::shared_ptr<AstList> GetIndexes() const;
+	Atom GetAtom() const;
+	AstList *GetIndexes() const;
 	DataType GetArrayType() const;
 
 	void accept(IVisitor &v) override;
 
 private:
-	std::shared_ptr<AstList> m_indexes;
-	std::string m_name;
+	AstList *m_indexes;
+	Atom m_name;
 };
 
 // ArrayAssign: Elem = Expression
 class AstArrayAssign : public IAst
 {
 public:
-	AstArrayAssign(std::shared_ptr<IAst> elem, std::shared_ptr<IAst> expression);
+	AstArrayAssign(IAst *elem, IAst *expression);
+
+	static bool ClassOf(AST_KIND kind)
+	{
+		return kind == AST_KIND::AST_ARRAY_ASSIGN;
+	}
 
-	std::shared_ptr<AstArrayValue> GetElem() const;
-	std::shared_ptr<AstExpression> GetExpression() const;
+	AstArrayValue *GetElem() const;
+	AstExpression *GetExpression() const;
 
 	void accept(IVisitor &v) override;
 
 private:
-	std::shared_ptr<AstArrayValue> m_elem;
-	std::shared_ptr<AstExpression> m_expression;
+	AstArrayValue *m_elem;
+	AstExpression *m_expression;
 };
 
 // new dict$%()
@@ -357,6 +526,11 @@ class AstNewDict : public AstExpression
 public:
 	AstNewDict(ATOMIC_TYPE keyType, ATOMIC_TYPE valueType);
 
+	static bool ClassOf(AST_KIND kind)
+	{
+		return kind == AST_KIND::AST_NEW_DICT;
+	}
+
 	void accept(IVisitor &v) override;
 };
 
@@ -368,33 +542,44 @@ public:
 class AstDictValue : public AstExpression
 {
 public:
-	AstDictValue(const std::string &dictName, ATOMIC_TYPE keyType, ATOMIC_TYPE valueType, std::shared_ptr<IAst> key);
+	AstDictValue(Atom dictName, ATOMIC_TYPE keyType, ATOMIC_TYPE valueType, IAst *key);
+
+	static bool ClassOf(AST_KIND kind)
+	{
+		return kind == AST_KIND::AST_DICT_VALUE;
+	}
 
-	std::shared_ptr<AstExpression> GetKey() const;
+	AstExpression *GetKey() const;
 	const DataType &GetDictType() const;
 	const std::string &GetName() const;
+	Atom GetAtom() const;
 
 	void accept(IVisitor &v) override;
 
 private:
-	std::shared_ptr<AstExpression> m_key;
+	AstExpression *m_key;
 	DataType m_dictType;
-	std::string m_name;
+	Atom m_name;
 };
 
 class AstDictAssign : public IAst
 {
 public:
-	AstDictAssign(std::shared_ptr<AstDictValue> dict, std::shared_ptr<AstExpression> expression);
+	AstDictAssign(AstDictValue *dict, AstExpression *expression);
 
-	std::shared_ptr<AstDictValue> GetDictValue() const;
-	std::shared_ptr<AstExpression> GetExpression() const;
+	static bool ClassOf(AST_KIND kind)
+	{
+		return kind == AST_KIND::AST_DICT_ASSIGN;
+	}
+
+	AstDictValue *GetDictValue() const;
+	AstExpression *GetExpression() const;
 
 	void accept(IVisitor &v) override;
 
 private:
-	std::shared_ptr<AstDictValue> m_dict;
-	std::shared_ptr<AstExpression> m_expression;
+	AstDictValue *m_dict;
+	AstExpression *m_expression;
 };
 
 // declaration of a single constant
@@ -403,6 +588,11 @@ class AstConstantDecl : public IAst
 public:
 	AstConstantDecl(std::shared_ptr<ConstantBase> constant);
 
+	static bool ClassOf(AST_KIND kind)
+	{
+		return kind == AST_KIND::AST_CONSTANT_DECL;
+	}
+
 	std::shared_ptr<ConstantBase> GetConst() const;
 
 	void accept(IVisitor &v) override;
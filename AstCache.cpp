@@ -0,0 +1,671 @@
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <unordered_map>
+#include <vector>
+#include "AstCache.h"
+#include "Ast.h"
+#include "AstContext.h"
+#include "FlatAst.h"
+#include "MappedFile.h"
+#include "Exception.h"
+
+using namespace std;
+
+namespace
+{
+	const char MAGIC[4] = { 'B', 'S', 'A', 'C' };
+	// Changed whenever the layout of the file changes
+	const unsigned FORMAT_VERSION = 1;
+
+	// Layout of the file:
+	//   FileHeader
+	//   double floats[floatCount]
+	//   FileNode nodes[nodeCount]
+	//   FileConstant constants[constantCount]
+	//   unsigned stringOffsets[stringCount + 1]
+	//   char strings[stringBytes]
+	// - Numbers are in the byte order of the machine, a file from another one
+	// doesn't pass the check of the header
+	struct FileHeader
+	{
+		char magic[4];
+		unsigned formatVersion;
+		unsigned long long key;
+		unsigned long long sourceSize;
+		unsigned nodeCount;
+		unsigned floatCount;
+		unsigned constantCount;
+		unsigned stringCount;
+		unsigned stringBytes;
+		unsigned reserved;
+	};
+
+	// FlatNode with the type packed into 3 bytes
+	// and atoms replaced by indexes in the string table
+	struct FileNode
+	{
+		unsigned char kind;
+		// DATA_TYPE
+		unsigned char type;
+		// Array: dimension, dict: ATOMIC_TYPE of the key
+		unsigned char first;
+		// Array: ATOMIC_TYPE of the elements, dict: ATOMIC_TYPE of the value
+		unsigned char second;
+		unsigned next;
+		unsigned payload;
+	};
+
+	struct FileConstant
+	{
+		// Index in the string table
+		unsigned name;
+		// ATOMIC_TYPE
+		unsigned type;
+		// Int, bool: value, float: index in the floats, string: index in the strings
+		unsigned value;
+	};
+
+	const unsigned long long FNV_OFFSET = 14695981039346656037ULL;
+	const unsigned long long FNV_PRIME = 1099511628211ULL;
+
+	unsigned long long Hash(unsigned long long hash, const char *data, size_t size)
+	{
+		for (size_t i = 0; i < size; i++)
+		{
+			hash = (hash ^ static_cast<unsigned char>(data[i])) * FNV_PRIME;
+		}
+		return hash;
+	}
+
+	bool PackType(const DataType &type, FileNode &node)
+	{
+		node.type = static_cast<unsigned char>(type.GetType());
+		node.first = 0;
+		node.second = 0;
+		switch (type.GetType())
+		{
+		case DATA_TYPE::TYPE_ARRAY:
+			if (type.GetArrayDimension() < 0 || type.GetArrayDimension() > 0xFF)
+			{
+				return false;
+			}
+			node.first = static_cast<unsigned char>(type.GetArrayDimension());
+			node.second = static_cast<unsigned char>(type.GetArrayType());
+			break;
+		case DATA_TYPE::TYPE_DICT:
+			node.first = static_cast<unsigned char>(type.GetDictKeyType());
+			node.second = static_cast<unsigned char>(type.GetDictValueType());
+			break;
+		default:
+			break;
+		}
+		return true;
+	}
+
+	// Writes the tree, the strings are collected as they are met
+	class Writer
+	{
+	public:
+		explicit Writer(IAst &ast)
+			: m_ast(ast)
+		{
+		}
+
+		// Returns false if the tree can't be stored
+		bool Write(unsigned long long key, size_t sourceSize, vector<char> &file)
+		{
+			vector<FileNode> nodes;
+			nodes.reserve(m_ast.Size());
+			for (unsigned i = 0; i < m_ast.Size(); i++)
+			{
+				const FlatNode &flat = m_ast.GetNode(i);
+				FileNode node;
+				node.kind = static_cast<unsigned char>(flat.kind);
+				node.next = flat.next;
+				node.payload = GetPayload(i);
+				if (!PackType(flat.type, node))
+				{
+					return false;
+				}
+				nodes.push_back(node);
+			}
+
+			FileHeader header = {};
+			memcpy(header.magic, MAGIC, sizeof(MAGIC));
+			header.formatVersion = FORMAT_VERSION;
+			header.key = key;
+			header.sourceSize = sourceSize;
+			header.nodeCount = static_cast<unsigned>(nodes.size());
+			header.floatCount = static_cast<unsigned>(m_floats.size());
+			header.constantCount = static_cast<unsigned>(m_constants.size());
+			header.stringCount = static_cast<unsigned>(m_strings.size());
+
+			vector<unsigned> offsets(1, 0);
+			for (Atom atom : m_strings)
+			{
+				offsets.push_back(offsets.back() + static_cast<unsigned>(Interner::GetString(atom).size()));
+			}
+			header.stringBytes = offsets.back();
+
+			file.clear();
+			file.reserve(sizeof(header) + m_floats.size() * sizeof(double) + nodes.size() * sizeof(FileNode)
+				+ m_constants.size() * sizeof(FileConstant) + offsets.size() * sizeof(unsigned) + header.stringBytes);
+			Append(file, &header, sizeof(header));
+			Append(file, m_floats.data(), m_floats.size() * sizeof(double));
+			Append(file, nodes.data(), nodes.size() * sizeof(FileNode));
+			Append(file, m_constants.data(), m_constants.size() * sizeof(FileConstant));
+			Append(file, offsets.data(), offsets.size() * sizeof(unsigned));
+			for (Atom atom : m_strings)
+			{
+				const string &text = Interner::GetString(atom);
+				Append(file, text.data(), text.size());
+			}
+			return true;
+		}
+
+	private:
+		FlatAst m_ast;
+		vector<double> m_floats;
+		vector<FileConstant> m_constants;
+		vector<Atom> m_strings;
+		unordered_map<Atom, unsigned> m_stringIndexes;
+
+		static void Append(vector<char> &file, const void *data, size_t size)
+		{
+			const char *bytes = static_cast<const char *>(data);
+			file.insert(file.end(), bytes, bytes + size);
+		}
+
+		unsigned GetPayload(unsigned index)
+		{
+			switch (m_ast.GetNode(index).kind)
+			{
+			case AST_KIND::AST_FLOAT_CONST:
+				return AddFloat(m_ast.GetFloat(index));
+			case AST_KIND::AST_STRING_CONST:
+			case AST_KIND::AST_VARIABLE:
+			case AST_KIND::AST_FUNCTION:
+			case AST_KIND::AST_CALL:
+			case AST_KIND::AST_ARRAY_VALUE:
+			case AST_KIND::AST_DICT_VALUE:
+				return AddString(m_ast.GetAtom(index));
+			case AST_KIND::AST_CONSTANT_DECL:
+				return AddConstant(*m_ast.GetConst(index));
+			default:
+				return m_ast.GetNode(index).payload;
+			}
+		}
+
+		unsigned AddFloat(double value)
+		{
+			m_floats.push_back(value);
+			return static_cast<unsigned>(m_floats.size() - 1);
+		}
+
+		unsigned AddString(Atom atom)
+		{
+			auto found = m_stringIndexes.find(atom);
+			if (found != m_stringIndexes.end())
+			{
+				return found->second;
+			}
+			unsigned index = static_cast<unsigned>(m_strings.size());
+			m_strings.push_back(atom);
+			m_stringIndexes[atom] = index;
+			return index;
+		}
+
+		unsigned AddConstant(const ConstantBase &constant)
+		{
+			FileConstant result;
+			result.name = AddString(constant.GetAtom());
+			result.type = static_cast<unsigned>(constant.GetType().GetType());
+
+			switch (constant.GetType().GetType())
+			{
+			case DATA_TYPE::TYPE_INT:
+				result.value = static_cast<unsigned>(static_cast<const IntConst &>(constant).GetValue());
+				break;
+			case DATA_TYPE::TYPE_FLOAT:
+				result.value = AddFloat(static_cast<const FloatConst &>(constant).GetValue());
+				break;
+			case DATA_TYPE::TYPE_STRING:
+				result.value = AddString(Interner::Intern(static_cast<const StringConst &>(constant).GetValue()));
+				break;
+			case DATA_TYPE::TYPE_BOOL:
+				result.value = static_cast<const BoolConst &>(constant).GetValue() ? 1 : 0;
+				break;
+			default:
+				throw InternalError("AstCache: constant of non atomic type");
+			}
+
+			m_constants.push_back(result);
+			return static_cast<unsigned>(m_constants.size() - 1);
+		}
+	};
+
+	// Makes the nodes of a file that is mapped into memory
+	// - Every index and count is checked, a damaged file throws InternalError
+	class Reader
+	{
+	public:
+		// The file must be the one of the key and the source size
+		Reader(const char *data, size_t size, unsigned long long key, size_t sourceSize, AstContext &context)
+			: m_context(context)
+		{
+			if (size < sizeof(FileHeader))
+			{
+				Damaged();
+			}
+			memcpy(&m_header, data, sizeof(m_header));
+			if (memcmp(m_header.magic, MAGIC, sizeof(MAGIC)) != 0 || m_header.formatVersion != FORMAT_VERSION
+				|| m_header.key != key || m_header.sourceSize != sourceSize)
+			{
+				Damaged();
+			}
+
+			size_t floatsSize = static_cast<size_t>(m_header.floatCount) * sizeof(double);
+			size_t nodesSize = static_cast<size_t>(m_header.nodeCount) * sizeof(FileNode);
+			size_t constantsSize = static_cast<size_t>(m_header.constantCount) * sizeof(FileConstant);
+			size_t offsetsSize = (static_cast<size_t>(m_header.stringCount) + 1) * sizeof(unsigned);
+			if (size != sizeof(FileHeader) + floatsSize + nodesSize + constantsSize + offsetsSize + m_header.stringBytes
+				|| m_header.nodeCount == 0)
+			{
+				Damaged();
+			}
+
+			m_floats = data + sizeof(FileHeader);
+			m_nodes = m_floats + floatsSize;
+			m_constants = m_nodes + nodesSize;
+			const char *offsets = m_constants + constantsSize;
+			const char *strings = offsets + offsetsSize;
+
+			// Strings are interned once, names become atoms again
+			m_atoms.reserve(m_header.stringCount);
+			unsigned begin = 0;
+			for (unsigned i = 0; i < m_header.stringCount; i++)
+			{
+				unsigned end;
+				memcpy(&end, offsets + (i + 1) * sizeof(unsigned), sizeof(end));
+				if (end < begin || end > m_header.stringBytes)
+				{
+					Damaged();
+				}
+				m_atoms.push_back(Interner::Intern(strings + begin, end - begin));
+				begin = end;
+			}
+		}
+
+		IAst *ReadTree()
+		{
+			return Read(0, m_header.nodeCount);
+		}
+
+	private:
+		AstContext &m_context;
+		FileHeader m_header;
+		const char *m_floats;
+		const char *m_nodes;
+		const char *m_constants;
+		vector<Atom> m_atoms;
+
+		static void Damaged()
+		{
+			throw InternalError("AstCache: the file is damaged");
+		}
+
+		FileNode GetNode(unsigned index) const
+		{
+			FileNode node;
+			memcpy(&node, m_nodes + static_cast<size_t>(index) * sizeof(FileNode), sizeof(node));
+			return node;
+		}
+
+		Atom GetAtom(unsigned index) const
+		{
+			if (index >= m_atoms.size())
+			{
+				Damaged();
+			}
+			return m_atoms[index];
+		}
+
+		double GetFloat(unsigned index) const
+		{
+			if (index >= m_header.floatCount)
+			{
+				Damaged();
+			}
+			double value;
+			memcpy(&value, m_floats + static_cast<size_t>(index) * sizeof(double), sizeof(value));
+			return value;
+		}
+
+		static KEYWORD GetOperator(const FileNode &node)
+		{
+			if (node.payload >= KEYWORD_COUNT)
+			{
+				Damaged();
+			}
+			return static_cast<KEYWORD>(node.payload);
+		}
+
+		static ATOMIC_TYPE GetAtomicType(unsigned type)
+		{
+			if (type > static_cast<unsigned>(ATOMIC_TYPE::TYPE_VOID))
+			{
+				Damaged();
+			}
+			return static_cast<ATOMIC_TYPE>(type);
+		}
+
+		static DataType GetType(const FileNode &node)
+		{
+			switch (static_cast<DATA_TYPE>(node.type))
+			{
+			case DATA_TYPE::TYPE_ARRAY:
+				return DataType(node.first, GetAtomicType(node.second));
+			case DATA_TYPE::TYPE_DICT:
+				return DataType(GetAtomicType(node.first), GetAtomicType(node.second));
+			default:
+				return DataType(GetAtomicType(node.type));
+			}
+		}
+
+		// Type of a node that must be an array or a dict
+		static DataType GetType(const FileNode &node, DATA_TYPE expected)
+		{
+			if (static_cast<DATA_TYPE>(node.type) != expected)
+			{
+				Damaged();
+			}
+			return GetType(node);
+		}
+
+		shared_ptr<ConstantBase> GetConstant(unsigned index) const
+		{
+			if (index >= m_header.constantCount)
+			{
+				Damaged();
+			}
+			FileConstant constant;
+			memcpy(&constant, m_constants + static_cast<size_t>(index) * sizeof(FileConstant), sizeof(constant));
+
+			Atom name = GetAtom(constant.name);
+			switch (GetAtomicType(constant.type))
+			{
+			case ATOMIC_TYPE::TYPE_INT:
+				return make_shared<IntConst>(name, static_cast<int>(constant.value));
+			case ATOMIC_TYPE::TYPE_FLOAT:
+				return make_shared<FloatConst>(name, GetFloat(constant.value));
+			case ATOMIC_TYPE::TYPE_STRING:
+				return make_shared<StringConst>(name, Interner::GetString(GetAtom(constant.value)));
+			case ATOMIC_TYPE::TYPE_BOOL:
+				return make_shared<BoolConst>(name, constant.value != 0);
+			default:
+				Damaged();
+				return nullptr;
+			}
+		}
+
+		// Indexes of the children of a node that has exactly count of them
+		void GetChildren(unsigned index, const FileNode &node, unsigned count, unsigned *children) const
+		{
+			unsigned child = index + 1;
+			for (unsigned i = 0; i < count; i++)
+			{
+				if (child >= node.next)
+				{
+					Damaged();
+				}
+				children[i] = child;
+				unsigned next = GetNode(child).next;
+				if (next <= child)
+				{
+					Damaged();
+				}
+				child = next;
+			}
+			if (child != node.next)
+			{
+				Damaged();
+			}
+		}
+
+		template<class T>
+		T *ReadAs(unsigned index, unsigned end)
+		{
+			T *node = DynCast<T>(Read(index, end));
+			if (!node)
+			{
+				Damaged();
+			}
+			return node;
+		}
+
+		// Makes the subtree of the node, which must end before end
+		IAst *Read(unsigned index, unsigned end)
+		{
+			FileNode node = GetNode(index);
+			if (node.next <= index || node.next > end || node.kind >= AST_KIND_COUNT)
+			{
+				Damaged();
+			}
+
+			unsigned c[4];
+			switch (static_cast<AST_KIND>(node.kind))
+			{
+			case AST_KIND::AST_ERROR:
+				GetChildren(index, node, 0, c);
+				return AstError::INSTANCE;
+			case AST_KIND::AST_INT_CONST:
+				GetChildren(index, node, 0, c);
+				return m_context.Make<AstIntConst>(static_cast<int>(node.payload));
+			case AST_KIND::AST_FLOAT_CONST:
+				GetChildren(index, node, 0, c);
+				return m_context.Make<AstFloatConst>(GetFloat(node.payload));
+			case AST_KIND::AST_STRING_CONST:
+				GetChildren(index, node, 0, c);
+				return m_context.Make<AstStringConst>(Interner::GetString(GetAtom(node.payload)));
+			case AST_KIND::AST_BOOL_CONST:
+				GetChildren(index, node, 0, c);
+				return m_context.Make<AstBoolConst>(node.payload != 0);
+			case AST_KIND::AST_VARIABLE:
+				GetChildren(index, node, 0, c);
+				return m_context.Make<AstVariable>(GetAtom(node.payload), GetType(node));
+			case AST_KIND::AST_UNARY:
+				GetChildren(index, node, 1, c);
+				return m_context.Make<AstUnaryExpression>(GetOperator(node),
+					ReadAs<AstExpression>(c[0], node.next));
+			case AST_KIND::AST_BINARY:
+				GetChildren(index, node, 2, c);
+				return m_context.Make<AstBinaryExpression>(ReadAs<AstExpression>(c[0], node.next),
+					GetOperator(node), ReadAs<AstExpression>(c[1], node.next));
+			case AST_KIND::AST_CALL:
+				GetChildren(index, node, 1, c);
+				return m_context.Make<AstFunctionCall>(GetAtom(node.payload), GetType(node),
+					ReadAs<AstList>(c[0], node.next));
+			case AST_KIND::AST_NEW_ARRAY:
+				return m_context.Make<AstNewArray>(GetType(node, DATA_TYPE::TYPE_ARRAY).GetArrayType(), ReadList(index, node));
+			case AST_KIND::AST_ARRAY_VALUE:
+				GetChildren(index, node, 1, c);
+				return m_context.Make<AstArrayValue>(GetAtom(node.payload), GetAtomicType(node.type),
+					ReadAs<AstList>(c[0], node.next));
+			case AST_KIND::AST_NEW_DICT:
+				{
+					GetChildren(index, node, 0, c);
+					DataType type = GetType(node, DATA_TYPE::TYPE_DICT);
+					return m_context.Make<AstNewDict>(type.GetDictKeyType(), type.GetDictValueType());
+				}
+			case AST_KIND::AST_DICT_VALUE:
+				{
+					GetChildren(index, node, 1, c);
+					DataType type = GetType(node, DATA_TYPE::TYPE_DICT);
+					return m_context.Make<AstDictValue>(GetAtom(node.payload), type.GetDictKeyType(),
+						type.GetDictValueType(), ReadAs<AstExpression>(c[0], node.next));
+				}
+			case AST_KIND::AST_ASSIGNMENT:
+				GetChildren(index, node, 2, c);
+				return m_context.Make<AstAssignmentExpression>(ReadAs<AstVariable>(c[0], node.next),
+					ReadAs<AstExpression>(c[1], node.next));
+			case AST_KIND::AST_LIST:
+				return ReadList(index, node);
+			case AST_KIND::AST_FUNCTION:
+				GetChildren(index, node, 2, c);
+				return m_context.Make<AstFunction>(GetAtom(node.payload), GetType(node),
+					ReadAs<AstList>(c[0], node.next), ReadAs<AstList>(c[1], node.next));
+			case AST_KIND::AST_RETURN:
+				if (node.payload == 0)
+				{
+					GetChildren(index, node, 0, c);
+					return m_context.Make<AstReturn>();
+				}
+				GetChildren(index, node, 1, c);
+				return m_context.Make<AstReturn>(ReadAs<AstExpression>(c[0], node.next));
+			case AST_KIND::AST_GLOBAL:
+				GetChildren(index, node, 1, c);
+				return m_context.Make<AstGlobal>(ReadAs<AstList>(c[0], node.next));
+			case AST_KIND::AST_IF:
+				if (node.payload == 0)
+				{
+					GetChildren(index, node, 2, c);
+					return m_context.Make<AstIf>(Read(c[0], node.next), Read(c[1], node.next), nullptr);
+				}
+				GetChildren(index, node, 3, c);
+				return m_context.Make<AstIf>(Read(c[0], node.next), Read(c[1], node.next), Read(c[2], node.next));
+			case AST_KIND::AST_WHILE:
+				GetChildren(index, node, 2, c);
+				return m_context.Make<AstWhile>(Read(c[0], node.next), Read(c[1], node.next), node.payload != 0);
+			case AST_KIND::AST_FOR:
+				GetChildren(index, node, 4, c);
+				return m_context.Make<AstFor>(Read(c[0], node.next), Read(c[1], node.next),
+					Read(c[2], node.next), Read(c[3], node.next));
+			case AST_KIND::AST_ARRAY_ASSIGN:
+				GetChildren(index, node, 2, c);
+				return m_context.Make<AstArrayAssign>(ReadAs<AstArrayValue>(c[0], node.next),
+					ReadAs<AstExpression>(c[1], node.next));
+			case AST_KIND::AST_DICT_ASSIGN:
+				GetChildren(index, node, 2, c);
+				return m_context.Make<AstDictAssign>(ReadAs<AstDictValue>(c[0], node.next),
+					ReadAs<AstExpression>(c[1], node.next));
+			case AST_KIND::AST_CONSTANT_DECL:
+				GetChildren(index, node, 0, c);
+				return m_context.Make<AstConstantDecl>(GetConstant(node.payload));
+			default:
+				Damaged();
+				return nullptr;
+			}
+		}
+
+		AstList *ReadList(unsigned index, const FileNode &node)
+		{
+			AstList *list = m_context.Make<AstList>();
+			for (unsigned child = index + 1; child < node.next; child = GetNode(child).next)
+			{
+				list->AddElement(Read(child, node.next));
+			}
+			return list;
+		}
+	};
+}
+
+AstCache::AstCache(const string &directory, const string &version)
+	: m_directory(directory)
+	, m_version(version)
+{
+}
+
+shared_ptr<IAst> AstCache::Load(const char *source, size_t size) const
+{
+	unsigned long long key = GetKey(source, size);
+	MappedFile file(GetFileName(key));
+	if (!file.IsOpen())
+	{
+		return nullptr;
+	}
+
+	try
+	{
+		auto context = make_shared<AstContext>();
+		Reader reader(file.GetData(), file.GetSize(), key, size, *context);
+		return context->Handle(reader.ReadTree());
+	}
+	catch (const InternalError &)
+	{
+	}
+	catch (const IntermediateError &)
+	{
+	}
+	return nullptr;
+}
+
+bool AstCache::Save(const char *source, size_t size, IAst &ast) const
+{
+	unsigned long long key = GetKey(source, size);
+	vector<char> data;
+	Writer writer(ast);
+	if (!writer.Write(key, size, data))
+	{
+		return false;
+	}
+
+#ifdef _WIN32
+	_mkdir(m_directory.c_str());
+#else
+	mkdir(m_directory.c_str(), 0777);
+#endif
+
+	// Another compiler may read the file meanwhile, so it's replaced only when complete
+	string fileName = GetFileName(key);
+	string tempName = fileName + ".tmp";
+	{
+		ofstream out(tempName, ios::binary | ios::trunc);
+		out.write(data.data(), data.size());
+		if (!out)
+		{
+			out.close();
+			remove(tempName.c_str());
+			return false;
+		}
+	}
+
+	if (rename(tempName.c_str(), fileName.c_str()) != 0)
+	{
+		// Windows doesn't replace an existing file
+		remove(fileName.c_str());
+		if (rename(tempName.c_str(), fileName.c_str()) != 0)
+		{
+			remove(tempName.c_str());
+			return false;
+		}
+	}
+	return true;
+}
+
+string AstCache::GetFileName(const char *source, size_t size) const
+{
+	return GetFileName(GetKey(source, size));
+}
+
+unsigned long long AstCache::GetKey(const char *source, size_t size) const
+{
+	// With the terminating zero, so "1.0" + "1..." differs from "1.01" + "..."
+	unsigned long long hash = Hash(FNV_OFFSET, m_version.c_str(), m_version.size() + 1);
+	return Hash(hash, source, size);
+}
+
+string AstCache::GetFileName(unsigned long long key) const
+{
+	ostringstream name;
+	name << m_directory << "/" << hex << setw(16) << setfill('0') << key << ".ast";
+	return name.str();
+}
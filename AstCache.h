@@ -0,0 +1,40 @@
+#pragma once
+#include <memory>
+#include <string>
+#include "AstFwd.h"
+
+// Part of the key of the cached trees, must be changed
+// whenever the parser starts making other trees
+const char COMPILER_VERSION[] = "1.0";
+
+// Cache of the syntax trees of unchanged sources, kept as files in a directory
+// - A file is named after the hash of the source bytes and COMPILER_VERSION,
+// so an edited source or another compiler misses the cache
+// - The file is a compact binary form of FlatAst: node headers in pre-order,
+// then side tables of floats, constants and strings; it's mapped into memory
+// and the nodes are made from it directly, without Lexer and Parse()
+// - Only trees without errors should be saved, a hit has no errors to report
+// - A damaged or foreign file is a miss, not an error
+class AstCache
+{
+public:
+	// Version is a part of the key, so caches of different versions
+	// may share the directory
+	explicit AstCache(const std::string &directory, const std::string &version = COMPILER_VERSION);
+
+	// Tree of the source, or null if it isn't in the cache
+	std::shared_ptr<IAst> Load(const char *source, size_t size) const;
+	// Stores the tree of the source, the directory is made if needed
+	// - Returns false if the file couldn't be written
+	bool Save(const char *source, size_t size, IAst &ast) const;
+
+	// Name of the file with the tree of the source, whether it exists or not
+	std::string GetFileName(const char *source, size_t size) const;
+
+private:
+	std::string m_directory;
+	std::string m_version;
+
+	unsigned long long GetKey(const char *source, size_t size) const;
+	std::string GetFileName(unsigned long long key) const;
+};
@@ -0,0 +1,128 @@
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <unistd.h>
+#endif
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include "AstCacheTest.h"
+#include "UnitTest.h"
+#include "AstCache.h"
+#include "Ast.h"
+#include "ProgramGenerator.h"
+
+using namespace std;
+
+namespace
+{
+	const char CACHE_DIRECTORY[] = "TestAstCache";
+
+	string ReadFile(const string &fileName)
+	{
+		ifstream file(fileName, ios::binary);
+		ostringstream text;
+		text << file.rdbuf();
+		return text.str();
+	}
+
+	void WriteFile(const string &fileName, const string &data)
+	{
+		ofstream file(fileName, ios::binary | ios::trunc);
+		file.write(data.data(), data.size());
+		Check(static_cast<bool>(file), "cannot write " + fileName);
+	}
+
+	// Files of the sources are removed before and after the test
+	void RemoveFiles(const AstCache &cache, const vector<string> &sources)
+	{
+		for (const string &source : sources)
+		{
+			remove(cache.GetFileName(source.data(), source.size()).c_str());
+		}
+	}
+
+	// Saves the tree of the source, it must be loaded back the same
+	void CheckRoundTrip(const AstCache &cache, const string &source, const string &name)
+	{
+		Check(!cache.Load(source.data(), source.size()), name + " is in the cache before saving");
+		string tree = DumpAst(*ParseText(source));
+		Check(cache.Save(source.data(), source.size(), *ParseText(source)), name + " isn't saved");
+
+		shared_ptr<IAst> loaded = cache.Load(source.data(), source.size());
+		Check(loaded != nullptr, name + " isn't loaded");
+		Check(DumpAst(*loaded) == tree, name + " is loaded with another tree");
+	}
+
+	bool IsMiss(const AstCache &cache, const string &source)
+	{
+		return !cache.Load(source.data(), source.size());
+	}
+}
+
+void TestAstCache()
+{
+	GeneratorOptions options;
+	options.seed = 8;
+	options.functionCount = 10;
+	options.statementsPerFunction = 20;
+	string generated = ProgramGenerator(options).Generate();
+	string constants = ReadTestProgram("Constants.txt");
+	string dict = ReadTestProgram("NewDict.txt");
+
+	// The same byte count, so only the hash tells them apart
+	string edited = generated;
+	edited[edited.find('%')] = '#';
+	string longer = generated + "\n";
+
+	AstCache cache(CACHE_DIRECTORY);
+	AstCache otherVersion(CACHE_DIRECTORY, string(COMPILER_VERSION) + ".1");
+	vector<string> sources = { generated, constants, dict, edited, longer };
+	RemoveFiles(cache, sources);
+	RemoveFiles(otherVersion, sources);
+
+	CheckRoundTrip(cache, generated, "generated program");
+	CheckRoundTrip(cache, constants, "Constants.txt");
+	CheckRoundTrip(cache, dict, "NewDict.txt");
+
+	// Edited sources and other versions of the compiler miss
+	Check(IsMiss(cache, edited), "edited source is loaded");
+	Check(IsMiss(cache, longer), "longer source is loaded");
+	Check(IsMiss(otherVersion, generated), "tree of another version is loaded");
+	Check(cache.GetFileName(generated.data(), generated.size()) !=
+		otherVersion.GetFileName(generated.data(), generated.size()), "versions share the file");
+
+	// The file of another version can't pass for this version
+	string fileName = cache.GetFileName(generated.data(), generated.size());
+	string otherFileName = otherVersion.GetFileName(generated.data(), generated.size());
+	string file = ReadFile(fileName);
+	WriteFile(otherFileName, file);
+	Check(IsMiss(otherVersion, generated), "file of another version is loaded");
+
+	// Damaged files miss instead of throwing
+	for (size_t size = 0; size < file.size(); size += 1 + size / 4)
+	{
+		WriteFile(fileName, file.substr(0, size));
+		Check(IsMiss(cache, generated), "file cut to " + to_string(size) + " bytes is loaded");
+	}
+	string damaged = file;
+	for (size_t i = damaged.size() / 3; i < damaged.size() * 2 / 3; i++)
+	{
+		damaged[i] = '\xFF';
+	}
+	WriteFile(fileName, damaged);
+	Check(IsMiss(cache, generated), "overwritten file is loaded");
+
+	// Saving again replaces the damaged file
+	Check(cache.Save(generated.data(), generated.size(), *ParseText(generated)), "program isn't saved again");
+	Check(!IsMiss(cache, generated), "program saved again isn't loaded");
+
+	RemoveFiles(cache, sources);
+	RemoveFiles(otherVersion, sources);
+#ifdef _WIN32
+	_rmdir(CACHE_DIRECTORY);
+#else
+	rmdir(CACHE_DIRECTORY);
+#endif
+}
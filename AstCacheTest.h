@@ -0,0 +1,4 @@
+#pragma once
+
+// Trees saved by AstCache are loaded back only for the same source and version
+void TestAstCache();
@@ -0,0 +1,236 @@
+#include <cstring>
+#include <functional>
+#include "AstContext.h"
+#include "Ast.h"
+#include "Exception.h"
+
+using namespace std;
+
+AstContext::AstContext()
+	: m_free(nullptr)
+	, m_left(0)
+	, m_isHashConsing(false)
+{
+}
+
+AstContext::~AstContext()
+{
+	for (size_t i = m_nodes.size(); i > 0; i--)
+	{
+		m_nodes[i - 1]->~IAst();
+	}
+}
+
+void AstContext::Retain(shared_ptr<const void> owner)
+{
+	m_retained.push_back(owner);
+}
+
+void AstContext::SetHashConsing(bool isOn)
+{
+	m_isHashConsing = isOn;
+	if (!isOn)
+	{
+		ClearExpressions();
+	}
+}
+
+bool AstContext::IsHashConsing() const
+{
+	return m_isHashConsing;
+}
+
+void AstContext::ClearExpressions()
+{
+	if (!m_expressions.empty())
+	{
+		m_expressions.clear();
+	}
+}
+
+size_t AstContext::GetNodeCount() const
+{
+	return m_nodes.size();
+}
+
+void *AstContext::Allocate(size_t size, size_t alignment)
+{
+	size_t padding = (alignment - reinterpret_cast<size_t>(m_free) % alignment) % alignment;
+	if (padding + size > m_left)
+	{
+		// Nodes are much smaller than a block, but a bigger one still gets a block of its own
+		size_t blockSize = size + alignment > BLOCK_SIZE ? size + alignment : BLOCK_SIZE;
+		m_blocks.push_back(unique_ptr<char[]>(new char[blockSize]));
+		m_free = m_blocks.back().get();
+		m_left = blockSize;
+		padding = (alignment - reinterpret_cast<size_t>(m_free) % alignment) % alignment;
+	}
+
+	void *memory = m_free + padding;
+	m_free += padding + size;
+	m_left -= padding + size;
+	return memory;
+}
+
+IAst *AstContext::Share(IAst *node)
+{
+	switch (node->GetKind())
+	{
+	case AST_KIND::AST_UNARY:
+		if (!IsShared(Cast<AstUnaryExpression>(node)->GetExpression()))
+		{
+			return node;
+		}
+		break;
+	case AST_KIND::AST_BINARY:
+		{
+			auto binary = Cast<AstBinaryExpression>(node);
+			if (!IsShared(binary->GetLeft()) || !IsShared(binary->GetRight()))
+			{
+				return node;
+			}
+		}
+		break;
+	default:
+		break;
+	}
+
+	return *m_expressions.insert(node).first;
+}
+
+bool AstContext::IsShared(IAst *node) const
+{
+	auto found = m_expressions.find(node);
+	return found != m_expressions.end() && *found == node;
+}
+
+void AstContext::Unmake(IAst *node, void *memory)
+{
+	if (m_nodes.empty() || m_nodes.back() != node)
+	{
+		throw InternalError("AstContext::Unmake(): node isn't the last one");
+	}
+	m_nodes.pop_back();
+	node->~IAst();
+
+	// The memory is reused if the node didn't start a new block
+	char *begin = static_cast<char *>(memory);
+	if (begin >= m_blocks.back().get() && begin < m_free)
+	{
+		m_left += m_free - begin;
+		m_free = begin;
+	}
+}
+
+static size_t Combine(size_t hash, size_t value)
+{
+	return hash ^ (value + 0x9e3779b9 + (hash << 6) + (hash >> 2));
+}
+
+static size_t HashType(const DataType &type)
+{
+	size_t hash = static_cast<size_t>(type.GetType());
+	switch (type.GetType())
+	{
+	case DATA_TYPE::TYPE_ARRAY:
+		hash = Combine(hash, type.GetArrayDimension());
+		hash = Combine(hash, static_cast<size_t>(type.GetArrayType()));
+		break;
+	case DATA_TYPE::TYPE_DICT:
+		hash = Combine(hash, static_cast<size_t>(type.GetDictKeyType()));
+		hash = Combine(hash, static_cast<size_t>(type.GetDictValueType()));
+		break;
+	default:
+		break;
+	}
+	return hash;
+}
+
+// Floats are compared bitwise, so 0.0 and -0.0 are different constants
+static unsigned long long FloatBits(double value)
+{
+	unsigned long long bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+size_t AstContext::ExpressionHash::operator()(const IAst *node) const
+{
+	size_t hash = static_cast<size_t>(node->GetKind());
+	switch (node->GetKind())
+	{
+	case AST_KIND::AST_INT_CONST:
+		return Combine(hash, static_cast<size_t>(Cast<AstIntConst>(node)->GetValue()));
+	case AST_KIND::AST_FLOAT_CONST:
+		return Combine(hash, std::hash<unsigned long long>()(FloatBits(Cast<AstFloatConst>(node)->GetValue())));
+	case AST_KIND::AST_STRING_CONST:
+		return Combine(hash, std::hash<string>()(Cast<AstStringConst>(node)->GetValue()));
+	case AST_KIND::AST_BOOL_CONST:
+		return Combine(hash, Cast<AstBoolConst>(node)->GetValue() ? 1 : 0);
+	case AST_KIND::AST_VARIABLE:
+		{
+			auto variable = Cast<AstVariable>(node);
+			return Combine(Combine(hash, variable->GetAtom()), HashType(variable->GetType()));
+		}
+	case AST_KIND::AST_UNARY:
+		{
+			auto unary = Cast<AstUnaryExpression>(node);
+			hash = Combine(hash, unary->GetOperator());
+			return Combine(hash, std::hash<const IAst *>()(unary->GetExpression()));
+		}
+	case AST_KIND::AST_BINARY:
+		{
+			auto binary = Cast<AstBinaryExpression>(node);
+			hash = Combine(hash, binary->GetOperator());
+			hash = Combine(hash, std::hash<const IAst *>()(binary->GetLeft()));
+			return Combine(hash, std::hash<const IAst *>()(binary->GetRight()));
+		}
+	default:
+		// Other nodes are never shared, they are only looked up as children
+		return Combine(hash, std::hash<const IAst *>()(node));
+	}
+}
+
+bool AstContext::ExpressionEqual::operator()(const IAst *left, const IAst *right) const
+{
+	if (left->GetKind() != right->GetKind())
+	{
+		return false;
+	}
+
+	switch (left->GetKind())
+	{
+	case AST_KIND::AST_INT_CONST:
+		return Cast<AstIntConst>(left)->GetValue() == Cast<AstIntConst>(right)->GetValue();
+	case AST_KIND::AST_FLOAT_CONST:
+		return FloatBits(Cast<AstFloatConst>(left)->GetValue()) == FloatBits(Cast<AstFloatConst>(right)->GetValue());
+	case AST_KIND::AST_STRING_CONST:
+		return Cast<AstStringConst>(left)->GetValue() == Cast<AstStringConst>(right)->GetValue();
+	case AST_KIND::AST_BOOL_CONST:
+		return Cast<AstBoolConst>(left)->GetValue() == Cast<AstBoolConst>(right)->GetValue();
+	case AST_KIND::AST_VARIABLE:
+		{
+			auto leftVariable = Cast<AstVariable>(left);
+			auto rightVariable = Cast<AstVariable>(right);
+			return leftVariable->GetAtom() == rightVariable->GetAtom()
+				&& leftVariable->GetType() == rightVariable->GetType();
+		}
+	case AST_KIND::AST_UNARY:
+		{
+			auto leftUnary = Cast<AstUnaryExpression>(left);
+			auto rightUnary = Cast<AstUnaryExpression>(right);
+			return leftUnary->GetOperator() == rightUnary->GetOperator()
+				&& leftUnary->GetExpression() == rightUnary->GetExpression();
+		}
+	case AST_KIND::AST_BINARY:
+		{
+			auto leftBinary = Cast<AstBinaryExpression>(left);
+			auto rightBinary = Cast<AstBinaryExpression>(right);
+			return leftBinary->GetOperator() == rightBinary->GetOperator()
+				&& leftBinary->GetLeft() == rightBinary->GetLeft()
+				&& leftBinary->GetRight() == rightBinary->GetRight();
+		}
+	default:
+		return left == right;
+	}
+}
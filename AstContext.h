@@ -0,0 +1,118 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <unordered_set>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include "AstFwd.h"
+
+// Owns the nodes of the trees made by a parser
+// - Nodes are placed one after another in big blocks, so making a node
+// costs no allocation, and all of them are destroyed with the context
+// - Nodes refer to their children with plain pointers; the tree is passed
+// around with shared_ptr handles (see Handle()), which share the reference
+// count of the context instead of having one per node
+// - Not thread safe, every parsing thread has its own context
+// - May share equal expressions (hash-consing), see MakeExpression()
+class AstContext : public std::enable_shared_from_this<AstContext>
+{
+public:
+	AstContext();
+	// Destroys the nodes in the reverse order of making them
+	~AstContext();
+
+	AstContext(const AstContext &) = delete;
+	AstContext &operator=(const AstContext &) = delete;
+
+	template<class T, class... ARGS>
+	T *Make(ARGS&&... args)
+	{
+		static_assert(std::is_base_of<IAst, T>::value, "AstContext only makes nodes");
+
+		// Room for the node is made first, so it isn't lost if push_back throws
+		if (m_nodes.size() == m_nodes.capacity())
+		{
+			m_nodes.reserve(m_nodes.size() * 2 + 64);
+		}
+		void *memory = Allocate(sizeof(T), std::alignment_of<T>::value);
+		T *node = new (memory) T(std::forward<ARGS>(args)...);
+		m_nodes.push_back(node);
+		return node;
+	}
+
+	// Makes an expression without side effects: a constant, a variable,
+	// or a unary or binary expression of such expressions
+	// - While hash-consing is on, returns the node made earlier for an equal
+	// expression instead of a new one, so repeated subexpressions (e.g. the
+	// index arithmetic of array accesses) are one node and the tree is a DAG
+	// - Children are compared by address, which is enough as they are shared
+	// themselves; an expression with a child that isn't (a call, an array
+	// value) is always a new node
+	// - A code generator may keep the value of a shared node in a temporary,
+	// but must drop the temporaries of the expressions that read a variable
+	// when the variable is assigned: the node of the variable stays the same
+	template<class T, class... ARGS>
+	T *MakeExpression(ARGS&&... args)
+	{
+		T *node = Make<T>(std::forward<ARGS>(args)...);
+		if (m_isHashConsing)
+		{
+			IAst *shared = Share(node);
+			if (shared != node)
+			{
+				Unmake(node, node);
+				return static_cast<T *>(shared);
+			}
+		}
+		return node;
+	}
+
+	// Hash-consing is off by default
+	void SetHashConsing(bool isOn);
+	bool IsHashConsing() const;
+	// Forgets the shared expressions; the parsers call it after every
+	// function, so expressions are shared only within a function
+	void ClearExpressions();
+
+	// Handle that keeps the context alive, the context must be owned by a shared_ptr
+	template<class T>
+	std::shared_ptr<T> Handle(T *node)
+	{
+		return std::shared_ptr<T>(shared_from_this(), node);
+	}
+
+	// Keeps the owner (e.g. a handle of a tree from another context,
+	// whose nodes are referred to by this context) alive as long as this context
+	void Retain(std::shared_ptr<const void> owner);
+
+	size_t GetNodeCount() const;
+
+private:
+	static const size_t BLOCK_SIZE = 64 * 1024;
+
+	std::vector<std::unique_ptr<char[]>> m_blocks;
+	char *m_free;
+	size_t m_left;
+	std::vector<IAst *> m_nodes;
+	std::vector<std::shared_ptr<const void>> m_retained;
+
+	struct ExpressionHash
+	{
+		size_t operator()(const IAst *node) const;
+	};
+	struct ExpressionEqual
+	{
+		bool operator()(const IAst *left, const IAst *right) const;
+	};
+
+	bool m_isHashConsing;
+	std::unordered_set<IAst *, ExpressionHash, ExpressionEqual> m_expressions;
+
+	void *Allocate(size_t size, size_t alignment);
+	// Returns the shared node equal to the node, or the node itself
+	IAst *Share(IAst *node);
+	bool IsShared(IAst *node) const;
+	// Destroys the last node made, memory is its address as the derived class
+	void Unmake(IAst *node, void *memory);
+};
@@ -25,6 +25,44 @@ class AstDictAssign;
 class AstConstantDecl;
 class AstFor;
 
+// Kind of a node, one for each class of the tree
+// - Constants and expressions are contiguous ranges (see IAst::IsConstant()
+// and IAst::IsExpression())
+enum class AST_KIND : unsigned char
+{
+	AST_ERROR,
+
+	// Constants
+	AST_INT_CONST,
+	AST_FLOAT_CONST,
+	AST_STRING_CONST,
+	AST_BOOL_CONST,
+
+	// Other expressions
+	AST_VARIABLE,
+	AST_UNARY,
+	AST_BINARY,
+	AST_CALL,
+	AST_NEW_ARRAY,
+	AST_ARRAY_VALUE,
+	AST_NEW_DICT,
+	AST_DICT_VALUE,
+
+	AST_ASSIGNMENT,
+	AST_LIST,
+	AST_FUNCTION,
+	AST_RETURN,
+	AST_GLOBAL,
+	AST_IF,
+	AST_WHILE,
+	AST_FOR,
+	AST_ARRAY_ASSIGN,
+	AST_DICT_ASSIGN,
+	AST_CONSTANT_DECL
+};
+
+static const unsigned AST_KIND_COUNT = static_cast<unsigned>(AST_KIND::AST_CONSTANT_DECL) + 1;
+
 template<class T, ATOMIC_TYPE DATA_TYPE> class AstConstant;
 typedef AstConstant<double, ATOMIC_TYPE::TYPE_FLOAT> AstFloatConst;
 typedef AstConstant<std::string, ATOMIC_TYPE::TYPE_STRING> AstStringConst;
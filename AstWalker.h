@@ -0,0 +1,329 @@
+#pragma once
+#include "Ast.h"
+#include "Exception.h"
+
+// Statically dispatched alternative to IVisitor for the passes over the tree
+// - Walk() switches on the kind of the node and calls visit() of DERIVED
+// directly, so there are no virtual calls and the handlers can be inlined
+// - DERIVED defines only the visit() overloads it needs, with
+// "using AstWalker<DERIVED>::visit;" to keep the others; by default
+// a visit() walks the children of the node (see WalkChildren())
+// - DERIVED may define its own Walk(), e.g. to act on every node,
+// which calls AstWalker::Walk()
+// - An IVisitor pass is ported by deriving it from AstWalker instead,
+// dropping 'override' and replacing child->accept(*this) with Walk(child)
+template<class DERIVED> class AstWalker
+{
+public:
+	void Walk(const IAst *node)
+	{
+		DERIVED &derived = static_cast<DERIVED &>(*this);
+		switch (node->GetKind())
+		{
+		case AST_KIND::AST_ERROR:
+			derived.visit(static_cast<const AstError &>(*node));
+			break;
+		case AST_KIND::AST_INT_CONST:
+			derived.visit(static_cast<const AstIntConst &>(*node));
+			break;
+		case AST_KIND::AST_FLOAT_CONST:
+			derived.visit(static_cast<const AstFloatConst &>(*node));
+			break;
+		case AST_KIND::AST_STRING_CONST:
+			derived.visit(static_cast<const AstStringConst &>(*node));
+			break;
+		case AST_KIND::AST_BOOL_CONST:
+			derived.visit(static_cast<const AstBoolConst &>(*node));
+			break;
+		case AST_KIND::AST_VARIABLE:
+			derived.visit(static_cast<const AstVariable &>(*node));
+			break;
+		case AST_KIND::AST_UNARY:
+			derived.visit(static_cast<const AstUnaryExpression &>(*node));
+			break;
+		case AST_KIND::AST_BINARY:
+			derived.visit(static_cast<const AstBinaryExpression &>(*node));
+			break;
+		case AST_KIND::AST_CALL:
+			derived.visit(static_cast<const AstFunctionCall &>(*node));
+			break;
+		case AST_KIND::AST_NEW_ARRAY:
+			derived.visit(static_cast<const AstNewArray &>(*node));
+			break;
+		case AST_KIND::AST_ARRAY_VALUE:
+			derived.visit(static_cast<const AstArrayValue &>(*node));
+			break;
+		case AST_KIND::AST_NEW_DICT:
+			derived.visit(static_cast<const AstNewDict &>(*node));
+			break;
+		case AST_KIND::AST_DICT_VALUE:
+			derived.visit(static_cast<const AstDictValue &>(*node));
+			break;
+		case AST_KIND::AST_ASSIGNMENT:
+			derived.visit(static_cast<const AstAssignmentExpression &>(*node));
+			break;
+		case AST_KIND::AST_LIST:
+			derived.visit(static_cast<const AstList &>(*node));
+			break;
+		case AST_KIND::AST_FUNCTION:
+			derived.visit(static_cast<const AstFunction &>(*node));
+			break;
+		case AST_KIND::AST_RETURN:
+			derived.visit(static_cast<const AstReturn &>(*node));
+			break;
+		case AST_KIND::AST_GLOBAL:
+			derived.visit(static_cast<const AstGlobal &>(*node));
+			break;
+		case AST_KIND::AST_IF:
+			derived.visit(static_cast<const AstIf &>(*node));
+			break;
+		case AST_KIND::AST_WHILE:
+			derived.visit(static_cast<const AstWhile &>(*node));
+			break;
+		case AST_KIND::AST_FOR:
+			derived.visit(static_cast<const AstFor &>(*node));
+			break;
+		case AST_KIND::AST_ARRAY_ASSIGN:
+			derived.visit(static_cast<const AstArrayAssign &>(*node));
+			break;
+		case AST_KIND::AST_DICT_ASSIGN:
+			derived.visit(static_cast<const AstDictAssign &>(*node));
+			break;
+		case AST_KIND::AST_CONSTANT_DECL:
+			derived.visit(static_cast<const AstConstantDecl &>(*node));
+			break;
+		default:
+			throw InternalError("AstWalker: unknown kind of node");
+		}
+	}
+
+	// Nodes without children
+	void visit(const AstError &ref)
+	{
+	}
+
+	void visit(const AstIntConst &ref)
+	{
+	}
+
+	void visit(const AstFloatConst &ref)
+	{
+	}
+
+	void visit(const AstStringConst &ref)
+	{
+	}
+
+	void visit(const AstBoolConst &ref)
+	{
+	}
+
+	void visit(const AstVariable &ref)
+	{
+	}
+
+	void visit(const AstNewDict &ref)
+	{
+	}
+
+	void visit(const AstConstantDecl &ref)
+	{
+	}
+
+	// Nodes with children
+	void visit(const AstUnaryExpression &ref)
+	{
+		WalkChildren(ref);
+	}
+
+	void visit(const AstBinaryExpression &ref)
+	{
+		WalkChildren(ref);
+	}
+
+	void visit(const AstFunctionCall &ref)
+	{
+		WalkChildren(ref);
+	}
+
+	void visit(const AstNewArray &ref)
+	{
+		WalkChildren(ref);
+	}
+
+	void visit(const AstArrayValue &ref)
+	{
+		WalkChildren(ref);
+	}
+
+	void visit(const AstDictValue &ref)
+	{
+		WalkChildren(ref);
+	}
+
+	void visit(const AstAssignmentExpression &ref)
+	{
+		WalkChildren(ref);
+	}
+
+	void visit(const AstList &ref)
+	{
+		WalkChildren(ref);
+	}
+
+	void visit(const AstFunction &ref)
+	{
+		WalkChildren(ref);
+	}
+
+	void visit(const AstReturn &ref)
+	{
+		WalkChildren(ref);
+	}
+
+	void visit(const AstGlobal &ref)
+	{
+		WalkChildren(ref);
+	}
+
+	void visit(const AstIf &ref)
+	{
+		WalkChildren(ref);
+	}
+
+	void visit(const AstWhile &ref)
+	{
+		WalkChildren(ref);
+	}
+
+	void visit(const AstFor &ref)
+	{
+		WalkChildren(ref);
+	}
+
+	void visit(const AstArrayAssign &ref)
+	{
+		WalkChildren(ref);
+	}
+
+	void visit(const AstDictAssign &ref)
+	{
+		WalkChildren(ref);
+	}
+
+	// Walks the children in the order of the getters of the class
+	void WalkChildren(const AstUnaryExpression &ref)
+	{
+		Child(ref.GetExpression());
+	}
+
+	void WalkChildren(const AstBinaryExpression &ref)
+	{
+		Child(ref.GetLeft());
+		Child(ref.GetRight());
+	}
+
+	void WalkChildren(const AstFunctionCall &ref)
+	{
+		Child(ref.GetArguments());
+	}
+
+	void WalkChildren(const AstNewArray &ref)
+	{
+		for (auto dimension : ref.GetDimensions())
+		{
+			Child(dimension);
+		}
+	}
+
+	void WalkChildren(const AstArrayValue &ref)
+	{
+		Child(ref.GetIndexes());
+	}
+
+	void WalkChildren(const AstDictValue &ref)
+	{
+		Child(ref.GetKey());
+	}
+
+	void WalkChildren(const AstAssignmentExpression &ref)
+	{
+		Child(ref.GetVariable());
+		Child(ref.GetExpression());
+	}
+
+	void WalkChildren(const AstList &ref)
+	{
+		for (auto element : ref.GetElements())
+		{
+			Child(element);
+		}
+	}
+
+	void WalkChildren(const AstFunction &ref)
+	{
+		Child(ref.GetArguments());
+		Child(ref.GetCode());
+	}
+
+	void WalkChildren(const AstReturn &ref)
+	{
+		if (ref.HasExpression())
+		{
+			Child(ref.GetExpression());
+		}
+	}
+
+	void WalkChildren(const AstGlobal &ref)
+	{
+		Child(ref.GetDeclarations());
+	}
+
+	void WalkChildren(const AstIf &ref)
+	{
+		Child(ref.GetCondition());
+		Child(ref.GetConsequent());
+		if (ref.HasElse())
+		{
+			Child(ref.GetAlternative());
+		}
+	}
+
+	void WalkChildren(const AstWhile &ref)
+	{
+		Child(ref.GetCondition());
+		Child(ref.GetCode());
+	}
+
+	void WalkChildren(const AstFor &ref)
+	{
+		Child(ref.GetFrom());
+		Child(ref.GetTo());
+		Child(ref.GetStep());
+		Child(ref.GetCode());
+	}
+
+	void WalkChildren(const AstArrayAssign &ref)
+	{
+		Child(ref.GetElem());
+		Child(ref.GetExpression());
+	}
+
+	void WalkChildren(const AstDictAssign &ref)
+	{
+		Child(ref.GetDictValue());
+		Child(ref.GetExpression());
+	}
+
+protected:
+	AstWalker()
+	{
+	}
+
+private:
+	// Goes through Walk() of DERIVED, if it has one
+	void Child(const IAst *child)
+	{
+		static_cast<DERIVED &>(*this).Walk(child);
+	}
+};
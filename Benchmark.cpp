@@ -0,0 +1,963 @@
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#include <Psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#include <chrono>
+#endif
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <memory>
+#include <cstdlib>
+#include <cstring>
+#include <atomic>
+#include <new>
+#include "Lexer.h"
+#include "Parser.h"
+#include "LL.h"
+#include "LR.h"
+#include "LALR.h"
+#include "Ast.h"
+#include "AstCache.h"
+#include "AstContext.h"
+#include "AstWalker.h"
+#include "FlatAst.h"
+#include "Exception.h"
+#include "CharScanner.h"
+#include "ProgramGenerator.h"
+
+using namespace std;
+
+// Throughput benchmark of the lexer and the parser on generated programs
+// - Usage: Benchmark [-functions N] [-statements N] [-blocks N] [-expressions N]
+//   [-seed N] [-repeat N] [-threads N] [-constructs N] [-out results.json] [-save program.txt]
+//   [-cache directory]
+// - Every benchmark is run the given number of times, the fastest run is reported
+// - Parsing engines (recursive descent, LL(1) table of LL.cpp, LR automaton
+// of LR.cpp and LALR(1) tables) are compared on corpora of the constructs
+// they all handle: variable declarations and 'new' expressions
+// - A pass over the whole program is timed on the tree of nodes
+// (with IVisitor and with AstWalker) and on its flat layout (FlatAst)
+// - With -cache, saving and loading of the tree (AstCache) are timed
+// against lexing and parsing
+// - Results are written as JSON to stdout or to the -out file
+
+#ifdef _MSC_VER
+#define NO_INLINE __declspec(noinline)
+#else
+#define NO_INLINE __attribute__((noinline))
+#endif
+
+namespace
+{
+	// Number of operator new calls in all threads
+	atomic<size_t> g_allocationCount(0);
+}
+
+// Not inlined, otherwise g++ sees free() called on memory of operator new
+// and reports -Wmismatched-new-delete
+NO_INLINE void *operator new(size_t size)
+{
+	g_allocationCount++;
+	void *memory = malloc(size != 0 ? size : 1);
+	if (memory == nullptr)
+	{
+		throw bad_alloc();
+	}
+	return memory;
+}
+
+NO_INLINE void operator delete(void *memory) throw()
+{
+	free(memory);
+}
+
+// Other forms go through the two above, so every allocation is counted once
+// and memory is always freed by the function matching the one that made it
+void *operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete[](void *memory) throw()
+{
+	operator delete(memory);
+}
+
+void operator delete(void *memory, size_t) throw()
+{
+	operator delete(memory);
+}
+
+void operator delete[](void *memory, size_t) throw()
+{
+	operator delete(memory);
+}
+
+namespace
+{
+	const long long NOT_COUNTED = -1;
+
+	struct BenchmarkOptions
+	{
+		BenchmarkOptions()
+			: repeat(5)
+			, threads(0)
+			, constructs(20000)
+		{
+		}
+
+		GeneratorOptions generator;
+		unsigned repeat;
+		unsigned threads;
+		// Size of the corpora for the comparison of parsing engines
+		unsigned constructs;
+		string outputFile;
+		string programFile;
+		// AstCache isn't measured if empty
+		string cacheDirectory;
+	};
+
+	struct Result
+	{
+		string name;
+		// What was counted: tokens, statements, ...
+		string unit;
+		size_t count;
+		double seconds;
+		size_t peakMemory;
+		// Allocations and mispredicted branches of the fastest run,
+		// branch misses are NOT_COUNTED without hardware counters
+		size_t allocations;
+		long long branchMisses;
+	};
+
+	// Hardware counter of mispredicted branches in the calling thread
+	// - perf_event_open on Linux; on other systems, or if the kernel
+	// doesn't allow it (perf_event_paranoid, containers), nothing is counted
+	class BranchMissCounter
+	{
+	public:
+		BranchMissCounter()
+			: m_fd(-1)
+		{
+#ifdef __linux__
+			perf_event_attr attr;
+			memset(&attr, 0, sizeof(attr));
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.size = sizeof(attr);
+			attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+			attr.disabled = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			m_fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+		}
+
+		~BranchMissCounter()
+		{
+#ifdef __linux__
+			if (m_fd >= 0)
+			{
+				close(m_fd);
+			}
+#endif
+		}
+
+		BranchMissCounter(const BranchMissCounter &) = delete;
+		BranchMissCounter &operator=(const BranchMissCounter &) = delete;
+
+		bool IsAvailable() const
+		{
+			return m_fd >= 0;
+		}
+
+		void Start()
+		{
+#ifdef __linux__
+			if (m_fd >= 0)
+			{
+				ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+				ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+			}
+#endif
+		}
+
+		// Returns the misses since Start()
+		long long Stop()
+		{
+#ifdef __linux__
+			long long count = 0;
+			if (m_fd >= 0)
+			{
+				ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+				if (read(m_fd, &count, sizeof(count)) == sizeof(count))
+				{
+					return count;
+				}
+			}
+#endif
+			return NOT_COUNTED;
+		}
+
+	private:
+		int m_fd;
+	};
+
+	// Wall clock time in seconds
+	// - high_resolution_clock of VS2013 ticks once in a millisecond,
+	// so the performance counter is used on Windows
+	double Now()
+	{
+#ifdef _WIN32
+		LARGE_INTEGER frequency, counter;
+		QueryPerformanceFrequency(&frequency);
+		QueryPerformanceCounter(&counter);
+		return static_cast<double>(counter.QuadPart) / frequency.QuadPart;
+#else
+		return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+	}
+
+	// Peak resident memory of the process in bytes
+	size_t GetPeakMemory()
+	{
+#ifdef _WIN32
+		PROCESS_MEMORY_COUNTERS counters;
+		if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		{
+			return 0;
+		}
+		return counters.PeakWorkingSetSize;
+#else
+		rusage usage;
+		if (getrusage(RUSAGE_SELF, &usage) != 0)
+		{
+			return 0;
+		}
+#ifdef __APPLE__
+		return usage.ru_maxrss;
+#else
+		// Linux reports kilobytes
+		return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+	}
+
+	vector<string> SplitLines(const string &text)
+	{
+		vector<string> lines;
+		size_t begin = 0;
+		while (begin < text.size())
+		{
+			size_t end = text.find('\n', begin);
+			if (end == string::npos)
+			{
+				end = text.size();
+			}
+			lines.push_back(text.substr(begin, end - begin));
+			begin = end + 1;
+		}
+		return lines;
+	}
+
+	// Runs the benchmark repeat times, run() returns the number of processed items
+	// - prepare() is called before each run and isn't timed
+	template<class PREPARE, class RUN>
+	Result Measure(const string &name, const string &unit, unsigned repeat,
+		BranchMissCounter &branchMisses, PREPARE prepare, RUN run)
+	{
+		Result result;
+		result.name = name;
+		result.unit = unit;
+		result.count = 0;
+		result.seconds = 0;
+		result.allocations = 0;
+		result.branchMisses = NOT_COUNTED;
+
+		for (unsigned i = 0; i < repeat; i++)
+		{
+			prepare();
+			size_t allocations = g_allocationCount;
+			branchMisses.Start();
+			double start = Now();
+			size_t count = run();
+			double seconds = Now() - start;
+			long long misses = branchMisses.Stop();
+
+			if (i == 0 || seconds < result.seconds)
+			{
+				result.seconds = seconds;
+				result.allocations = g_allocationCount - allocations;
+				result.branchMisses = misses;
+			}
+			result.count = count;
+		}
+
+		result.peakMemory = GetPeakMemory();
+		cerr << name << ": " << result.count / result.seconds << " " << unit << "/s\n";
+		return result;
+	}
+
+	void NoPreparation()
+	{
+	}
+
+	// Pass over the whole tree that counts the nodes of each kind
+	class KindCounter : public IVisitor
+	{
+	public:
+		KindCounter()
+		{
+			fill(m_counts, m_counts + AST_KIND_COUNT, 0);
+		}
+
+		size_t GetTotal() const
+		{
+			size_t total = 0;
+			for (unsigned i = 0; i < AST_KIND_COUNT; i++)
+			{
+				total += m_counts[i];
+			}
+			return total;
+		}
+
+		void visit(const AstError &ref) override
+		{
+			Count(AST_KIND::AST_ERROR);
+		}
+
+		void visit(const AstFloatConst &ref) override
+		{
+			Count(AST_KIND::AST_FLOAT_CONST);
+		}
+
+		void visit(const AstStringConst &ref) override
+		{
+			Count(AST_KIND::AST_STRING_CONST);
+		}
+
+		void visit(const AstIntConst &ref) override
+		{
+			Count(AST_KIND::AST_INT_CONST);
+		}
+
+		void visit(const AstBoolConst &ref) override
+		{
+			Count(AST_KIND::AST_BOOL_CONST);
+		}
+
+		void visit(const AstVariable &ref) override
+		{
+			Count(AST_KIND::AST_VARIABLE);
+		}
+
+		void visit(const AstUnaryExpression &ref) override
+		{
+			Count(AST_KIND::AST_UNARY);
+			ref.GetExpression()->accept(*this);
+		}
+
+		void visit(const AstBinaryExpression &ref) override
+		{
+			Count(AST_KIND::AST_BINARY);
+			ref.GetLeft()->accept(*this);
+			ref.GetRight()->accept(*this);
+		}
+
+		void visit(const AstAssignmentExpression &ref) override
+		{
+			Count(AST_KIND::AST_ASSIGNMENT);
+			ref.GetVariable()->accept(*this);
+			ref.GetExpression()->accept(*this);
+		}
+
+		void visit(const AstList &ref) override
+		{
+			Count(AST_KIND::AST_LIST);
+			for (auto element : ref.GetElements())
+			{
+				element->accept(*this);
+			}
+		}
+
+		void visit(const AstFunction &ref) override
+		{
+			Count(AST_KIND::AST_FUNCTION);
+			ref.GetArguments()->accept(*this);
+			ref.GetCode()->accept(*this);
+		}
+
+		void visit(const AstReturn &ref) override
+		{
+			Count(AST_KIND::AST_RETURN);
+			if (ref.HasExpression())
+			{
+				ref.GetExpression()->accept(*this);
+			}
+		}
+
+		void visit(const AstGlobal &ref) override
+		{
+			Count(AST_KIND::AST_GLOBAL);
+			ref.GetDeclarations()->accept(*this);
+		}
+
+		void visit(const AstFunctionCall &ref) override
+		{
+			Count(AST_KIND::AST_CALL);
+			ref.GetArguments()->accept(*this);
+		}
+
+		void visit(const AstIf &ref) override
+		{
+			Count(AST_KIND::AST_IF);
+			ref.GetCondition()->accept(*this);
+			ref.GetConsequent()->accept(*this);
+			if (ref.HasElse())
+			{
+				ref.GetAlternative()->accept(*this);
+			}
+		}
+
+		void visit(const AstNewDict &ref) override
+		{
+			Count(AST_KIND::AST_NEW_DICT);
+		}
+
+		void visit(const AstDictValue &ref) override
+		{
+			Count(AST_KIND::AST_DICT_VALUE);
+			ref.GetKey()->accept(*this);
+		}
+
+		void visit(const AstDictAssign &ref) override
+		{
+			Count(AST_KIND::AST_DICT_ASSIGN);
+			ref.GetDictValue()->accept(*this);
+			ref.GetExpression()->accept(*this);
+		}
+
+		void visit(const AstConstantDecl &ref) override
+		{
+			Count(AST_KIND::AST_CONSTANT_DECL);
+		}
+
+		void visit(const AstFor &ref) override
+		{
+			Count(AST_KIND::AST_FOR);
+			ref.GetFrom()->accept(*this);
+			ref.GetTo()->accept(*this);
+			ref.GetStep()->accept(*this);
+			ref.GetCode()->accept(*this);
+		}
+
+		void visit(const AstWhile &ref) override
+		{
+			Count(AST_KIND::AST_WHILE);
+			ref.GetCondition()->accept(*this);
+			ref.GetCode()->accept(*this);
+		}
+
+		void visit(const AstNewArray &ref) override
+		{
+			Count(AST_KIND::AST_NEW_ARRAY);
+			for (auto dimension : ref.GetDimensions())
+			{
+				dimension->accept(*this);
+			}
+		}
+
+		void visit(const AstArrayValue &ref) override
+		{
+			Count(AST_KIND::AST_ARRAY_VALUE);
+			ref.GetIndexes()->accept(*this);
+		}
+
+		void visit(const AstArrayAssign &ref) override
+		{
+			Count(AST_KIND::AST_ARRAY_ASSIGN);
+			ref.GetElem()->accept(*this);
+			ref.GetExpression()->accept(*this);
+		}
+
+	private:
+		size_t m_counts[AST_KIND_COUNT];
+
+		void Count(AST_KIND kind)
+		{
+			m_counts[static_cast<unsigned>(kind)]++;
+		}
+	};
+
+	// Same pass with static dispatch, every node goes through Walk()
+	class StaticKindCounter : public AstWalker<StaticKindCounter>
+	{
+	public:
+		StaticKindCounter()
+		{
+			fill(m_counts, m_counts + AST_KIND_COUNT, 0);
+		}
+
+		size_t GetTotal() const
+		{
+			size_t total = 0;
+			for (unsigned i = 0; i < AST_KIND_COUNT; i++)
+			{
+				total += m_counts[i];
+			}
+			return total;
+		}
+
+		void Walk(const IAst *node)
+		{
+			m_counts[static_cast<unsigned>(node->GetKind())]++;
+			AstWalker::Walk(node);
+		}
+
+	private:
+		size_t m_counts[AST_KIND_COUNT];
+	};
+
+	// Same pass over the flat layout, which is one sequential scan
+	size_t CountKinds(const FlatAst &ast)
+	{
+		size_t counts[AST_KIND_COUNT] = {};
+		for (const FlatNode &node : ast.GetNodes())
+		{
+			counts[static_cast<unsigned>(node.kind)]++;
+		}
+
+		size_t total = 0;
+		for (unsigned i = 0; i < AST_KIND_COUNT; i++)
+		{
+			total += counts[i];
+		}
+		return total;
+	}
+
+	vector<Result> RunBenchmarks(const BenchmarkOptions &options, ThreadPool &pool,
+		BranchMissCounter &branchMisses, const string &program, size_t statementCount)
+	{
+		vector<Result> results;
+		vector<string> lines = SplitLines(program);
+		const char *data = program.data();
+		size_t size = program.size();
+
+		results.push_back(Measure("lexer_parse_line", "tokens", options.repeat, branchMisses, NoPreparation, [&]()
+		{
+			Lexer lex;
+			size_t count = 0;
+			for (size_t i = 0; i < lines.size(); i++)
+			{
+				count += lex.ParseLine(lines[i], static_cast<int>(i + 1)).size();
+			}
+			return count;
+		}));
+
+		results.push_back(Measure("lexer_parse_buffer", "tokens", options.repeat, branchMisses, NoPreparation, [&]()
+		{
+			Lexer lex;
+			return lex.ParseBuffer(data, size).size();
+		}));
+
+		results.push_back(Measure("lexer_parse_buffer_parallel", "tokens", options.repeat, branchMisses, NoPreparation, [&]()
+		{
+			Lexer lex;
+			return lex.ParseBufferParallel(data, size, pool).size();
+		}));
+
+		// Tokens are made once, only building of the tree is timed
+		Lexer lex;
+		TokenBuffer tokens(lex.ParseBuffer(data, size));
+		shared_ptr<IAst> ast;
+		results.push_back(Measure("parser", "statements", options.repeat, branchMisses, [&]()
+		{
+			ast.reset();
+		}, [&]()
+		{
+			TokenStream ts(tokens);
+			ast = Parse(ts);
+			return statementCount;
+		}));
+
+		// Same as "parser" with equal expressions shared
+		shared_ptr<IAst> sharedAst;
+		results.push_back(Measure("parser_hash_consing", "statements", options.repeat, branchMisses, [&]()
+		{
+			sharedAst.reset();
+		}, [&]()
+		{
+			TokenStream ts(tokens);
+			ts.GetAstContext().SetHashConsing(true);
+			sharedAst = Parse(ts);
+			return statementCount;
+		}));
+		sharedAst.reset();
+
+		results.push_back(Measure("parser_parallel", "statements", options.repeat, branchMisses, [&]()
+		{
+			ast.reset();
+		}, [&]()
+		{
+			ast = ParseParallel(tokens, pool);
+			return statementCount;
+		}));
+
+		results.push_back(Measure("lexer_and_parser_stream", "statements", options.repeat, branchMisses, [&]()
+		{
+			ast.reset();
+		}, [&]()
+		{
+			Lexer streamLexer;
+			TokenStream ts = streamLexer.ParseStream(data, size);
+			ast = Parse(ts);
+			return statementCount;
+		}));
+
+		// Passes over the whole program, the tree of nodes against its flat layout
+		results.push_back(Measure("ast_walk_tree", "nodes", options.repeat, branchMisses, NoPreparation, [&]()
+		{
+			KindCounter counter;
+			ast->accept(counter);
+			return counter.GetTotal();
+		}));
+
+		results.push_back(Measure("ast_walk_static", "nodes", options.repeat, branchMisses, NoPreparation, [&]()
+		{
+			StaticKindCounter counter;
+			counter.Walk(ast.get());
+			return counter.GetTotal();
+		}));
+
+		unique_ptr<FlatAst> flatAst;
+		results.push_back(Measure("ast_flatten", "nodes", options.repeat, branchMisses, [&]()
+		{
+			flatAst.reset();
+		}, [&]()
+		{
+			flatAst.reset(new FlatAst(*ast));
+			return flatAst->Size();
+		}));
+
+		results.push_back(Measure("ast_walk_flat", "nodes", options.repeat, branchMisses, NoPreparation, [&]()
+		{
+			return CountKinds(*flatAst);
+		}));
+
+		// Loading of the tree from AstCache against lexer_and_parser_stream
+		if (!options.cacheDirectory.empty())
+		{
+			AstCache cache(options.cacheDirectory);
+			results.push_back(Measure("ast_cache_save", "statements", options.repeat, branchMisses, NoPreparation, [&]()
+			{
+				if (!cache.Save(data, size, *ast))
+				{
+					throw InternalError("Cannot write to the cache directory '" + options.cacheDirectory + "'");
+				}
+				return statementCount;
+			}));
+
+			results.push_back(Measure("ast_cache_load", "statements", options.repeat, branchMisses, [&]()
+			{
+				ast.reset();
+			}, [&]()
+			{
+				ast = cache.Load(data, size);
+				if (!ast)
+				{
+					throw InternalError("Saved tree isn't loaded from the cache");
+				}
+				return statementCount;
+			}));
+		}
+
+		return results;
+	}
+
+	// Parses the comma separated constructs of a corpus one by one with parse(),
+	// the way the statement and expression parsers call it
+	// - Tokens before the first construct (isFirst()) and after the last one are skipped
+	// - Returns the number of tokens in the corpus
+	template<class IS_FIRST>
+	size_t ParseConstructs(const TokenBuffer &tokens, IS_FIRST isFirst,
+		IAst *(*parse)(TokenStream &tk))
+	{
+		TokenStream ts(tokens);
+		while (!ts.IsEOS() && !isFirst(ts))
+		{
+			ts.Forward();
+		}
+		while (true)
+		{
+			if (parse(ts)->IsError())
+			{
+				throw InternalError("Benchmark: construct of the corpus isn't parsed");
+			}
+			if (ts.CurrentType() != TOKEN_DELIMETER || !ts.IsKeyword(KW_COMMA))
+			{
+				break;
+			}
+			ts.Forward();
+		}
+		return tokens.Size();
+	}
+
+	// LL.cpp and LR.cpp run their tables and then build the node by recursive
+	// descent, as the parser uses them, so the cost of a table engine is the
+	// difference with the recursive descent on the same corpus
+	vector<Result> RunBackendBenchmarks(const BenchmarkOptions &options, BranchMissCounter &branchMisses,
+		const string &variables, const string &news)
+	{
+		vector<Result> results;
+		Lexer lex;
+		TokenBuffer variableTokens(lex.ParseBuffer(variables.data(), variables.size()));
+		TokenBuffer newTokens(lex.ParseBuffer(news.data(), news.size()));
+
+		auto isVariable = [](const TokenStream &ts)
+		{
+			return ts.CurrentType() == TOKEN_ID;
+		};
+		auto isNew = [](const TokenStream &ts)
+		{
+			return ts.CurrentType() == TOKEN_KEYWORD && ts.IsKeyword(KW_NEW);
+		};
+
+		results.push_back(Measure("variables_recursive_descent", "tokens", options.repeat, branchMisses,
+			NoPreparation, [&]()
+		{
+			return ParseConstructs(variableTokens, isVariable, ParseVariableRDP);
+		}));
+
+		results.push_back(Measure("variables_lr", "tokens", options.repeat, branchMisses,
+			NoPreparation, [&]()
+		{
+			return ParseConstructs(variableTokens, isVariable, ParseVariableLR);
+		}));
+
+		results.push_back(Measure("variables_lalr", "tokens", options.repeat, branchMisses,
+			NoPreparation, [&]()
+		{
+			TokenStream ts(variableTokens);
+			ParseLALR(ts);
+			return variableTokens.Size();
+		}));
+
+		results.push_back(Measure("new_recursive_descent", "tokens", options.repeat, branchMisses,
+			NoPreparation, [&]()
+		{
+			return ParseConstructs(newTokens, isNew, ParseNewRDP);
+		}));
+
+		results.push_back(Measure("new_ll", "tokens", options.repeat, branchMisses,
+			NoPreparation, [&]()
+		{
+			return ParseConstructs(newTokens, isNew, LLParseNew);
+		}));
+
+		results.push_back(Measure("new_lalr", "tokens", options.repeat, branchMisses,
+			NoPreparation, [&]()
+		{
+			TokenStream ts(newTokens);
+			ParseLALR(ts);
+			return newTokens.Size();
+		}));
+
+		return results;
+	}
+
+	void WriteResult(ostream &os, const Result &result, size_t bytes, bool last)
+	{
+		os << "    { \"name\": \"" << result.name << "\""
+			<< ", \"unit\": \"" << result.unit << "\""
+			<< ", \"count\": " << result.count
+			<< ", \"seconds\": " << result.seconds
+			<< ", \"per_second\": " << static_cast<size_t>(result.count / result.seconds)
+			<< ", \"nanoseconds_per_item\": " << result.seconds * 1e9 / result.count
+			<< ", \"megabytes_per_second\": " << bytes / result.seconds / (1024 * 1024)
+			<< ", \"allocations\": " << result.allocations
+			<< ", \"branch_misses\": ";
+		if (result.branchMisses == NOT_COUNTED)
+		{
+			os << "null";
+		}
+		else
+		{
+			os << result.branchMisses;
+		}
+		os << ", \"peak_memory_bytes\": " << result.peakMemory
+			<< " }" << (last ? "" : ",") << "\n";
+	}
+
+	void WriteResults(ostream &os, const BenchmarkOptions &options, unsigned threadCount,
+		bool branchMisses, const ProgramGenerator &generator, const string &program,
+		const vector<Result> &results, const string &variables, const string &news,
+		const vector<Result> &backends)
+	{
+		os << "{\n";
+		os << "  \"scanner\": \"" << CharScanner::GetImplementationName() << "\",\n";
+		os << "  \"threads\": " << threadCount << ",\n";
+		os << "  \"repeat\": " << options.repeat << ",\n";
+		os << "  \"branch_misses_counted\": " << (branchMisses ? "true" : "false") << ",\n";
+		os << "  \"program\": {\n";
+		os << "    \"seed\": " << options.generator.seed << ",\n";
+		os << "    \"functions\": " << generator.GetFunctionCount() << ",\n";
+		os << "    \"statements\": " << generator.GetStatementCount() << ",\n";
+		os << "    \"lines\": " << generator.GetLineCount() << ",\n";
+		os << "    \"bytes\": " << program.size() << "\n";
+		os << "  },\n";
+		os << "  \"results\": [\n";
+		for (size_t i = 0; i < results.size(); i++)
+		{
+			WriteResult(os, results[i], program.size(), i + 1 == results.size());
+		}
+		os << "  ],\n";
+		os << "  \"backends\": {\n";
+		os << "    \"constructs\": " << options.constructs << ",\n";
+		os << "    \"variables_bytes\": " << variables.size() << ",\n";
+		os << "    \"new_bytes\": " << news.size() << ",\n";
+		os << "    \"results\": [\n";
+		for (size_t i = 0; i < backends.size(); i++)
+		{
+			const Result &result = backends[i];
+			size_t bytes = result.name.compare(0, 4, "new_") == 0 ? news.size() : variables.size();
+			os << "  ";
+			WriteResult(os, result, bytes, i + 1 == backends.size());
+		}
+		os << "    ]\n";
+		os << "  }\n";
+		os << "}\n";
+	}
+
+	bool ParseArguments(int argc, char *argv[], BenchmarkOptions &options)
+	{
+		for (int i = 1; i + 1 < argc; i += 2)
+		{
+			string name = argv[i];
+			const char *value = argv[i + 1];
+			unsigned number = static_cast<unsigned>(strtoul(value, nullptr, 10));
+
+			if (name == "-functions")
+			{
+				options.generator.functionCount = number;
+			}
+			else if (name == "-statements")
+			{
+				options.generator.statementsPerFunction = number;
+			}
+			else if (name == "-blocks")
+			{
+				options.generator.maxBlockDepth = number;
+			}
+			else if (name == "-expressions")
+			{
+				options.generator.maxExpressionDepth = number;
+			}
+			else if (name == "-seed")
+			{
+				options.generator.seed = number;
+			}
+			else if (name == "-repeat")
+			{
+				options.repeat = number > 0 ? number : 1;
+			}
+			else if (name == "-threads")
+			{
+				options.threads = number;
+			}
+			else if (name == "-constructs")
+			{
+				options.constructs = number > 0 ? number : 1;
+			}
+			else if (name == "-out")
+			{
+				options.outputFile = value;
+			}
+			else if (name == "-save")
+			{
+				options.programFile = value;
+			}
+			else if (name == "-cache")
+			{
+				options.cacheDirectory = value;
+			}
+			else
+			{
+				cerr << "Unknown option '" << name << "'\n";
+				return false;
+			}
+		}
+		if (argc % 2 == 0)
+		{
+			cerr << "Option '" << argv[argc - 1] << "' has no value\n";
+			return false;
+		}
+		return true;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	BenchmarkOptions options;
+	if (!ParseArguments(argc, argv, options))
+	{
+		return 1;
+	}
+
+	InitOperatorMap();
+
+	ProgramGenerator generator(options.generator);
+	string program = generator.Generate();
+
+	if (!options.programFile.empty())
+	{
+		ofstream file(options.programFile, ios::binary);
+		file << program;
+	}
+
+	// Own generator, statistics of the program are written with the results
+	ProgramGenerator corpusGenerator(options.generator);
+	string variables = corpusGenerator.GenerateVariables(options.constructs);
+	string news = corpusGenerator.GenerateNewExpressions(options.constructs);
+
+	ThreadPool pool(options.threads);
+	BranchMissCounter branchMisses;
+	vector<Result> results, backends;
+	try
+	{
+		results = RunBenchmarks(options, pool, branchMisses, program, generator.GetStatementCount());
+		backends = RunBackendBenchmarks(options, branchMisses, variables, news);
+	}
+	catch (const CompileError &ex)
+	{
+		cerr << "Generated program is invalid: " << ex.what() << endl;
+		return 1;
+	}
+	catch (const InternalError &ex)
+	{
+		cerr << ex.what() << endl;
+		return 1;
+	}
+
+	if (options.outputFile.empty())
+	{
+		WriteResults(cout, options, pool.GetThreadCount(), branchMisses.IsAvailable(), generator, program,
+			results, variables, news, backends);
+	}
+	else
+	{
+		ofstream file(options.outputFile);
+		WriteResults(file, options, pool.GetThreadCount(), branchMisses.IsAvailable(), generator, program,
+			results, variables, news, backends);
+	}
+	return 0;
+}
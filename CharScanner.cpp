@@ -0,0 +1,337 @@
+#include "CharScanner.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define CHAR_SCANNER_X86
+#include <emmintrin.h>
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#ifdef _MSC_VER
+#define TARGET_SSE2
+#define TARGET_AVX2
+#else
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace
+{
+	enum CHAR_FLAG
+	{
+		CHAR_SPACE = 1,
+		CHAR_IDENTIFIER = 2,
+		CHAR_DIGIT = 4,
+		CHAR_QUOTE = 8,
+		CHAR_BACKTICK = 16
+	};
+
+	class CharTable
+	{
+	public:
+		CharTable()
+		{
+			for (int ch = 0; ch < 256; ch++)
+			{
+				flags[ch] = 0;
+			}
+
+			const char spaces[] = " \t\n\v\f\r";
+			for (const char *ch = spaces; *ch; ch++)
+			{
+				flags[static_cast<unsigned char>(*ch)] |= CHAR_SPACE;
+			}
+			for (int ch = 'a'; ch <= 'z'; ch++)
+			{
+				flags[ch] |= CHAR_IDENTIFIER;
+				flags[ch - 'a' + 'A'] |= CHAR_IDENTIFIER;
+			}
+			for (int ch = '0'; ch <= '9'; ch++)
+			{
+				flags[ch] |= CHAR_IDENTIFIER | CHAR_DIGIT;
+			}
+			flags['_'] |= CHAR_IDENTIFIER;
+			flags['"'] |= CHAR_QUOTE;
+			flags['`'] |= CHAR_BACKTICK;
+		}
+
+		unsigned char flags[256];
+	};
+
+	const CharTable g_chars;
+
+	inline unsigned CountTrailingZeros(unsigned mask)
+	{
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return index;
+#else
+		return __builtin_ctz(mask);
+#endif
+	}
+
+	// Every character class is described by a scalar test and
+	// by the tests of a whole vector for each instruction set
+	// - MATCH is true when the function looks for a run of matching characters,
+	// false when it looks for the first matching one
+
+	struct Spaces
+	{
+		static const unsigned char FLAGS = CHAR_SPACE;
+		static const bool MATCH = true;
+#ifdef CHAR_SCANNER_X86
+		// ' ' or '\t'..'\r'
+		TARGET_SSE2 static __m128i Test(__m128i chunk)
+		{
+			__m128i control = _mm_sub_epi8(chunk, _mm_set1_epi8('\t'));
+			return _mm_or_si128(
+				_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')),
+				_mm_cmpeq_epi8(_mm_min_epu8(control, _mm_set1_epi8('\r' - '\t')), control));
+		}
+		TARGET_AVX2 static __m256i Test(__m256i chunk)
+		{
+			__m256i control = _mm256_sub_epi8(chunk, _mm256_set1_epi8('\t'));
+			return _mm256_or_si256(
+				_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(' ')),
+				_mm256_cmpeq_epi8(_mm256_min_epu8(control, _mm256_set1_epi8('\r' - '\t')), control));
+		}
+#endif
+	};
+
+	struct Identifier
+	{
+		static const unsigned char FLAGS = CHAR_IDENTIFIER;
+		static const bool MATCH = true;
+#ifdef CHAR_SCANNER_X86
+		// (ch | 0x20) in 'a'..'z', ch in '0'..'9' or ch == '_'
+		TARGET_SSE2 static __m128i Test(__m128i chunk)
+		{
+			__m128i letter = _mm_sub_epi8(_mm_or_si128(chunk, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+			__m128i digit = _mm_sub_epi8(chunk, _mm_set1_epi8('0'));
+			return _mm_or_si128(
+				_mm_or_si128(
+					_mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8('z' - 'a')), letter),
+					_mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit)),
+				_mm_cmpeq_epi8(chunk, _mm_set1_epi8('_')));
+		}
+		TARGET_AVX2 static __m256i Test(__m256i chunk)
+		{
+			__m256i letter = _mm256_sub_epi8(_mm256_or_si256(chunk, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+			__m256i digit = _mm256_sub_epi8(chunk, _mm256_set1_epi8('0'));
+			return _mm256_or_si256(
+				_mm256_or_si256(
+					_mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8('z' - 'a')), letter),
+					_mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit)),
+				_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('_')));
+		}
+#endif
+	};
+
+	struct Digits
+	{
+		static const unsigned char FLAGS = CHAR_DIGIT;
+		static const bool MATCH = true;
+#ifdef CHAR_SCANNER_X86
+		TARGET_SSE2 static __m128i Test(__m128i chunk)
+		{
+			__m128i digit = _mm_sub_epi8(chunk, _mm_set1_epi8('0'));
+			return _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+		}
+		TARGET_AVX2 static __m256i Test(__m256i chunk)
+		{
+			__m256i digit = _mm256_sub_epi8(chunk, _mm256_set1_epi8('0'));
+			return _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+		}
+#endif
+	};
+
+	struct Quote
+	{
+		static const unsigned char FLAGS = CHAR_QUOTE;
+		static const bool MATCH = false;
+#ifdef CHAR_SCANNER_X86
+		TARGET_SSE2 static __m128i Test(__m128i chunk)
+		{
+			return _mm_cmpeq_epi8(chunk, _mm_set1_epi8('"'));
+		}
+		TARGET_AVX2 static __m256i Test(__m256i chunk)
+		{
+			return _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('"'));
+		}
+#endif
+	};
+
+	struct QuoteOrBacktick
+	{
+		static const unsigned char FLAGS = CHAR_QUOTE | CHAR_BACKTICK;
+		static const bool MATCH = false;
+#ifdef CHAR_SCANNER_X86
+		TARGET_SSE2 static __m128i Test(__m128i chunk)
+		{
+			return _mm_or_si128(
+				_mm_cmpeq_epi8(chunk, _mm_set1_epi8('"')),
+				_mm_cmpeq_epi8(chunk, _mm_set1_epi8('`')));
+		}
+		TARGET_AVX2 static __m256i Test(__m256i chunk)
+		{
+			return _mm256_or_si256(
+				_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('"')),
+				_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('`')));
+		}
+#endif
+	};
+
+	// Returns position of the first character that ends the run
+	// (the first non-matching one if CLASS::MATCH, the first matching one otherwise)
+
+	template<class CLASS> const char *ScanScalar(const char *begin, const char *end)
+	{
+		const char *pos = begin;
+		while (pos != end &&
+			((g_chars.flags[static_cast<unsigned char>(*pos)] & CLASS::FLAGS) != 0) == CLASS::MATCH)
+		{
+			pos++;
+		}
+		return pos;
+	}
+
+#ifdef CHAR_SCANNER_X86
+	template<class CLASS> TARGET_SSE2 const char *ScanSse2(const char *begin, const char *end)
+	{
+		const char *pos = begin;
+		while (end - pos >= 16)
+		{
+			__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos));
+			unsigned mask = _mm_movemask_epi8(CLASS::Test(chunk));
+			if (CLASS::MATCH)
+			{
+				mask = ~mask & 0xFFFF;
+			}
+			if (mask != 0)
+			{
+				return pos + CountTrailingZeros(mask);
+			}
+			pos += 16;
+		}
+		return ScanScalar<CLASS>(pos, end);
+	}
+
+	template<class CLASS> TARGET_AVX2 const char *ScanAvx2(const char *begin, const char *end)
+	{
+		const char *pos = begin;
+		while (end - pos >= 32)
+		{
+			__m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos));
+			unsigned mask = _mm256_movemask_epi8(CLASS::Test(chunk));
+			if (CLASS::MATCH)
+			{
+				mask = ~mask;
+			}
+			if (mask != 0)
+			{
+				return pos + CountTrailingZeros(mask);
+			}
+			pos += 32;
+		}
+		return ScanSse2<CLASS>(pos, end);
+	}
+#endif
+
+	typedef const char *(*SCAN_FN_PTR)(const char *begin, const char *end);
+
+	struct ScanFunctions
+	{
+		const char *name;
+		SCAN_FN_PTR spaces;
+		SCAN_FN_PTR identifier;
+		SCAN_FN_PTR digits;
+		SCAN_FN_PTR quote;
+		SCAN_FN_PTR quoteOrBacktick;
+	};
+
+#define SCAN_FUNCTIONS(NAME, SCAN) {	\
+		NAME,							\
+		SCAN<Spaces>,					\
+		SCAN<Identifier>,				\
+		SCAN<Digits>,					\
+		SCAN<Quote>,					\
+		SCAN<QuoteOrBacktick>			\
+	}
+
+	const ScanFunctions SCALAR_FUNCTIONS = SCAN_FUNCTIONS("scalar", ScanScalar);
+#ifdef CHAR_SCANNER_X86
+	const ScanFunctions SSE2_FUNCTIONS = SCAN_FUNCTIONS("sse2", ScanSse2);
+	const ScanFunctions AVX2_FUNCTIONS = SCAN_FUNCTIONS("avx2", ScanAvx2);
+#endif
+
+	const ScanFunctions &SelectFunctions()
+	{
+#ifdef CHAR_SCANNER_X86
+#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, 0);
+		int maxLeaf = info[0];
+
+		__cpuid(info, 1);
+		bool hasSse2 = (info[3] & (1 << 26)) != 0;
+		// The OS must save YMM registers on context switches
+		bool hasYmm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 6) == 6;
+
+		bool hasAvx2 = false;
+		if (maxLeaf >= 7 && hasYmm)
+		{
+			__cpuidex(info, 7, 0);
+			hasAvx2 = (info[1] & (1 << 5)) != 0;
+		}
+#else
+		__builtin_cpu_init();
+		bool hasSse2 = __builtin_cpu_supports("sse2");
+		bool hasAvx2 = __builtin_cpu_supports("avx2");
+#endif
+		if (hasAvx2)
+		{
+			return AVX2_FUNCTIONS;
+		}
+		if (hasSse2)
+		{
+			return SSE2_FUNCTIONS;
+		}
+#endif
+		return SCALAR_FUNCTIONS;
+	}
+
+	const ScanFunctions &g_scan = SelectFunctions();
+}
+
+size_t CharScanner::SpanSpaces(const char *begin, const char *end)
+{
+	return g_scan.spaces(begin, end) - begin;
+}
+
+size_t CharScanner::SpanIdentifier(const char *begin, const char *end)
+{
+	return g_scan.identifier(begin, end) - begin;
+}
+
+size_t CharScanner::SpanDigits(const char *begin, const char *end)
+{
+	return g_scan.digits(begin, end) - begin;
+}
+
+const char *CharScanner::FindQuote(const char *begin, const char *end)
+{
+	return g_scan.quote(begin, end);
+}
+
+const char *CharScanner::FindQuoteOrBacktick(const char *begin, const char *end)
+{
+	return g_scan.quoteOrBacktick(begin, end);
+}
+
+const char *CharScanner::GetImplementationName()
+{
+	return g_scan.name;
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <stddef.h>
+
+// Vectorized scanning of the source text
+// - Classifies 16 (SSE2) or 32 (AVX2) characters at a time,
+// falls back to a table lookup per character on other CPUs
+// - The implementation is chosen once at startup according to the CPU
+// - All functions work on [begin, end) and never read past end
+class CharScanner
+{
+public:
+	// Length of the run of whitespace characters (as in isspace) at begin
+	static size_t SpanSpaces(const char *begin, const char *end);
+	// Length of the run of identifier characters [A-Za-z0-9_] at begin
+	static size_t SpanIdentifier(const char *begin, const char *end);
+	// Length of the run of digits [0-9] at begin
+	static size_t SpanDigits(const char *begin, const char *end);
+
+	// Returns position of the first '"', or end if there is none
+	static const char *FindQuote(const char *begin, const char *end);
+	// Returns position of the first '"' or '`', or end if there is none
+	static const char *FindQuoteOrBacktick(const char *begin, const char *end);
+
+	// Name of the selected implementation: "avx2", "sse2" or "scalar"
+	static const char *GetImplementationName();
+};
@@ -7,7 +7,7 @@
 class ConstantBase : public Variable
 {
 public:
-	ConstantBase(const std::string &varName, const DataType &varType)
+	ConstantBase(Atom varName, const DataType &varType)
 		: Variable(varName, varType)
 	{
 	}
@@ -21,7 +21,7 @@ public:
 template<class CTYPE, ATOMIC_TYPE ATYPE> class Constant : public ConstantBase
 {
 public:
-	Constant(const std::string &constName, CTYPE constValue)
+	Constant(Atom constName, CTYPE constValue)
 		: ConstantBase(constName, DataType(ATYPE))
 		, m_value(constValue)
 	{
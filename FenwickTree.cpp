@@ -0,0 +1,73 @@
+#include "FenwickTree.h"
+
+using namespace std;
+
+FenwickTree::FenwickTree()
+	: m_tree(1, 0)
+	, m_highBit(0)
+{
+}
+
+void FenwickTree::Assign(const vector<int> &counts)
+{
+	m_tree.assign(counts.size() + 1, 0);
+	for (size_t i = 1; i <= counts.size(); i++)
+	{
+		m_tree[i] += counts[i - 1];
+		size_t parent = i + LowBit(i);
+		if (parent <= counts.size())
+		{
+			m_tree[parent] += m_tree[i];
+		}
+	}
+
+	m_highBit = counts.empty() ? 0 : 1;
+	while (m_highBit * 2 <= counts.size())
+	{
+		m_highBit *= 2;
+	}
+}
+
+size_t FenwickTree::Size() const
+{
+	return m_tree.size() - 1;
+}
+
+void FenwickTree::Add(size_t index, int delta)
+{
+	for (size_t i = index + 1; i < m_tree.size(); i += LowBit(i))
+	{
+		m_tree[i] += delta;
+	}
+}
+
+int FenwickTree::Sum(size_t n) const
+{
+	int sum = 0;
+	for (size_t i = n; i > 0; i -= LowBit(i))
+	{
+		sum += m_tree[i];
+	}
+	return sum;
+}
+
+size_t FenwickTree::Find(int position) const
+{
+	// Descends to the longest prefix whose sum is <= position,
+	// the count after that prefix contains the position
+	size_t index = 0;
+	for (size_t bit = m_highBit; bit != 0; bit /= 2)
+	{
+		if (index + bit < m_tree.size() && m_tree[index + bit] <= position)
+		{
+			index += bit;
+			position -= m_tree[index];
+		}
+	}
+	return index;
+}
+
+size_t FenwickTree::LowBit(size_t i)
+{
+	return i & (~i + 1);
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// Prefix sums of an array of non-negative counts (binary indexed tree)
+// - Changing a count, a prefix sum and finding the count that contains
+// a position all take O(log n)
+// - Used by IncrementalParser to find lines and definitions of its segments
+class FenwickTree
+{
+public:
+	FenwickTree();
+
+	// Replaces all the counts, O(n)
+	void Assign(const std::vector<int> &counts);
+
+	size_t Size() const;
+
+	void Add(size_t index, int delta);
+	// Sum of the first n counts
+	int Sum(size_t n) const;
+	// Index of the count that contains the position (the sum of the counts
+	// before it is <= position < the sum with it), Size() if position is
+	// past the total; empty counts never contain a position
+	size_t Find(int position) const;
+
+private:
+	// 1-based, m_tree[i] is the sum of the counts (i - LowBit(i), i]
+	std::vector<int> m_tree;
+	// Highest power of 2 that is <= Size()
+	size_t m_highBit;
+
+	static size_t LowBit(size_t i);
+};
@@ -0,0 +1,315 @@
+#include "FlatAst.h"
+#include "AstWalker.h"
+#include "Exception.h"
+
+using namespace std;
+
+// Appends the nodes in pre-order, the header of a node is made
+// before its children and its 'next' is set after them
+class FlatAst::Builder : public AstWalker<FlatAst::Builder>
+{
+public:
+	Builder(FlatAst &ast)
+		: m_ast(ast)
+	{
+	}
+
+	void visit(const AstError &ref)
+	{
+		Leaf(AST_KIND::AST_ERROR, VoidType(), 0);
+	}
+
+	void visit(const AstFloatConst &ref)
+	{
+		Leaf(AST_KIND::AST_FLOAT_CONST, ref.GetType(), static_cast<unsigned>(m_ast.m_floats.size()));
+		m_ast.m_floats.push_back(ref.GetValue());
+	}
+
+	void visit(const AstStringConst &ref)
+	{
+		// Literals are interned by the lexer already, folded strings are added
+		Leaf(AST_KIND::AST_STRING_CONST, ref.GetType(), Interner::Intern(ref.GetValue()));
+	}
+
+	void visit(const AstIntConst &ref)
+	{
+		Leaf(AST_KIND::AST_INT_CONST, ref.GetType(), static_cast<unsigned>(ref.GetValue()));
+	}
+
+	void visit(const AstBoolConst &ref)
+	{
+		Leaf(AST_KIND::AST_BOOL_CONST, ref.GetType(), ref.GetValue() ? 1 : 0);
+	}
+
+	void visit(const AstVariable &ref)
+	{
+		Leaf(AST_KIND::AST_VARIABLE, ref.GetType(), ref.GetAtom());
+	}
+
+	void visit(const AstUnaryExpression &ref)
+	{
+		unsigned index = Begin(AST_KIND::AST_UNARY, ref.GetType(), ref.GetOperator());
+		Child(ref.GetExpression());
+		End(index);
+	}
+
+	void visit(const AstBinaryExpression &ref)
+	{
+		unsigned index = Begin(AST_KIND::AST_BINARY, ref.GetType(), ref.GetOperator());
+		Child(ref.GetLeft());
+		Child(ref.GetRight());
+		End(index);
+	}
+
+	void visit(const AstAssignmentExpression &ref)
+	{
+		unsigned index = Begin(AST_KIND::AST_ASSIGNMENT, VoidType(), 0);
+		Child(ref.GetVariable());
+		Child(ref.GetExpression());
+		End(index);
+	}
+
+	void visit(const AstList &ref)
+	{
+		unsigned index = Begin(AST_KIND::AST_LIST, VoidType(), 0);
+		for (auto element : ref.GetElements())
+		{
+			Child(element);
+		}
+		End(index);
+	}
+
+	void visit(const AstFunction &ref)
+	{
+		unsigned index = Begin(AST_KIND::AST_FUNCTION, ref.GetReturnType(), ref.GetAtom());
+		Child(ref.GetArguments());
+		Child(ref.GetCode());
+		End(index);
+	}
+
+	void visit(const AstReturn &ref)
+	{
+		unsigned index = Begin(AST_KIND::AST_RETURN, VoidType(), ref.HasExpression() ? 1 : 0);
+		if (ref.HasExpression())
+		{
+			Child(ref.GetExpression());
+		}
+		End(index);
+	}
+
+	void visit(const AstGlobal &ref)
+	{
+		unsigned index = Begin(AST_KIND::AST_GLOBAL, VoidType(), 0);
+		Child(ref.GetDeclarations());
+		End(index);
+	}
+
+	void visit(const AstFunctionCall &ref)
+	{
+		unsigned index = Begin(AST_KIND::AST_CALL, ref.GetType(), ref.GetAtom());
+		Child(ref.GetArguments());
+		End(index);
+	}
+
+	void visit(const AstIf &ref)
+	{
+		unsigned index = Begin(AST_KIND::AST_IF, VoidType(), ref.HasElse() ? 1 : 0);
+		Child(ref.GetCondition());
+		Child(ref.GetConsequent());
+		if (ref.HasElse())
+		{
+			Child(ref.GetAlternative());
+		}
+		End(index);
+	}
+
+	void visit(const AstNewDict &ref)
+	{
+		Leaf(AST_KIND::AST_NEW_DICT, ref.GetType(), 0);
+	}
+
+	void visit(const AstDictValue &ref)
+	{
+		unsigned index = Begin(AST_KIND::AST_DICT_VALUE, ref.GetDictType(), ref.GetAtom());
+		Child(ref.GetKey());
+		End(index);
+	}
+
+	void visit(const AstDictAssign &ref)
+	{
+		unsigned index = Begin(AST_KIND::AST_DICT_ASSIGN, VoidType(), 0);
+		Child(ref.GetDictValue());
+		Child(ref.GetExpression());
+		End(index);
+	}
+
+	void visit(const AstConstantDecl &ref)
+	{
+		Leaf(AST_KIND::AST_CONSTANT_DECL, VoidType(), static_cast<unsigned>(m_ast.m_constants.size()));
+		m_ast.m_constants.push_back(ref.GetConst());
+	}
+
+	void visit(const AstFor &ref)
+	{
+		unsigned index = Begin(AST_KIND::AST_FOR, VoidType(), 0);
+		Child(ref.GetFrom());
+		Child(ref.GetTo());
+		Child(ref.GetStep());
+		Child(ref.GetCode());
+		End(index);
+	}
+
+	void visit(const AstWhile &ref)
+	{
+		unsigned index = Begin(AST_KIND::AST_WHILE, VoidType(), ref.IsDoWhile() ? 1 : 0);
+		Child(ref.GetCondition());
+		Child(ref.GetCode());
+		End(index);
+	}
+
+	void visit(const AstNewArray &ref)
+	{
+		unsigned index = Begin(AST_KIND::AST_NEW_ARRAY, ref.GetType(), 0);
+		for (auto dimension : ref.GetDimensions())
+		{
+			Child(dimension);
+		}
+		End(index);
+	}
+
+	void visit(const AstArrayValue &ref)
+	{
+		unsigned index = Begin(AST_KIND::AST_ARRAY_VALUE, ref.GetType(), ref.GetAtom());
+		Child(ref.GetIndexes());
+		End(index);
+	}
+
+	void visit(const AstArrayAssign &ref)
+	{
+		unsigned index = Begin(AST_KIND::AST_ARRAY_ASSIGN, VoidType(), 0);
+		Child(ref.GetElem());
+		Child(ref.GetExpression());
+		End(index);
+	}
+
+private:
+	FlatAst &m_ast;
+
+	static DataType VoidType()
+	{
+		return DataType(ATOMIC_TYPE::TYPE_VOID);
+	}
+
+	unsigned Begin(AST_KIND kind, const DataType &type, unsigned payload)
+	{
+		unsigned index = static_cast<unsigned>(m_ast.m_nodes.size());
+		FlatNode node = { kind, type, index + 1, payload };
+		m_ast.m_nodes.push_back(node);
+		return index;
+	}
+
+	void End(unsigned index)
+	{
+		m_ast.m_nodes[index].next = static_cast<unsigned>(m_ast.m_nodes.size());
+	}
+
+	void Leaf(AST_KIND kind, const DataType &type, unsigned payload)
+	{
+		Begin(kind, type, payload);
+	}
+
+	void Child(IAst *child)
+	{
+		if (!child)
+		{
+			throw InternalError("FlatAst: node has no child");
+		}
+		Walk(child);
+	}
+};
+
+FlatAst::FlatAst(IAst &root)
+{
+	Builder builder(*this);
+	builder.Walk(&root);
+}
+
+size_t FlatAst::Size() const
+{
+	return m_nodes.size();
+}
+
+const FlatNode &FlatAst::GetNode(unsigned index) const
+{
+	return m_nodes[index];
+}
+
+const vector<FlatNode> &FlatAst::GetNodes() const
+{
+	return m_nodes;
+}
+
+unsigned FlatAst::GetChildCount(unsigned index) const
+{
+	unsigned count = 0;
+	for (unsigned child = index + 1; child < m_nodes[index].next; child = m_nodes[child].next)
+	{
+		count++;
+	}
+	return count;
+}
+
+unsigned FlatAst::GetChild(unsigned index, unsigned n) const
+{
+	unsigned end = m_nodes[index].next;
+	unsigned child = index + 1;
+	for (unsigned i = 0; i < n && child < end; i++)
+	{
+		child = m_nodes[child].next;
+	}
+	if (child >= end)
+	{
+		throw InternalError("FlatAst::GetChild(): no such child");
+	}
+	return child;
+}
+
+int FlatAst::GetInt(unsigned index) const
+{
+	return static_cast<int>(m_nodes[index].payload);
+}
+
+double FlatAst::GetFloat(unsigned index) const
+{
+	return m_floats[m_nodes[index].payload];
+}
+
+bool FlatAst::GetBool(unsigned index) const
+{
+	return m_nodes[index].payload != 0;
+}
+
+const string &FlatAst::GetString(unsigned index) const
+{
+	return Interner::GetString(m_nodes[index].payload);
+}
+
+Atom FlatAst::GetAtom(unsigned index) const
+{
+	return m_nodes[index].payload;
+}
+
+const string &FlatAst::GetName(unsigned index) const
+{
+	return Interner::GetString(m_nodes[index].payload);
+}
+
+KEYWORD FlatAst::GetOperator(unsigned index) const
+{
+	return static_cast<KEYWORD>(m_nodes[index].payload);
+}
+
+shared_ptr<ConstantBase> FlatAst::GetConst(unsigned index) const
+{
+	return m_constants[m_nodes[index].payload];
+}
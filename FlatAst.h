@@ -0,0 +1,80 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include "AstFwd.h"
+#include "DataType.h"
+#include "Token.h"
+#include "Interner.h"
+
+class ConstantBase;
+
+// Fixed size header of a node of FlatAst
+struct FlatNode
+{
+	AST_KIND kind;
+	// Expressions: type of the value
+	// AST_FUNCTION: return type
+	// AST_DICT_VALUE: type of the dict (type of the value is GetDictValueType())
+	// Others: void
+	DataType type;
+	// Index after the last node of the subtree, which is the next sibling
+	unsigned next;
+	// Depends on the kind:
+	// AST_INT_CONST: value, AST_BOOL_CONST: 0 or 1
+	// AST_FLOAT_CONST, AST_CONSTANT_DECL: index in the side table (see FlatAst)
+	// AST_STRING_CONST: atom of the value
+	// AST_VARIABLE, AST_FUNCTION, AST_CALL, AST_ARRAY_VALUE, AST_DICT_VALUE: atom of the name
+	// AST_UNARY, AST_BINARY: KEYWORD of the operator
+	// AST_IF: 1 if there is 'else', AST_RETURN: 1 if there is a value,
+	// AST_WHILE: 1 for do-while
+	unsigned payload;
+};
+
+// Syntax tree laid out in one array in pre-order, an alternative to the tree
+// of IAst nodes for the passes that walk the whole program
+// - Children of a node follow it: the first one is at index + 1,
+// the next one is at the 'next' of the previous one, the last one ends at
+// the 'next' of the parent:
+//   for (unsigned child = index + 1; child < node.next; child = GetNode(child).next)
+// - Children are in the order of the getters of the IAst classes:
+//   AST_BINARY: left, right; AST_ASSIGNMENT, AST_ARRAY_ASSIGN, AST_DICT_ASSIGN:
+//   target, value; AST_FUNCTION: arguments, code (lists); AST_CALL,
+//   AST_ARRAY_VALUE: arguments, indexes (lists); AST_IF: condition, consequent,
+//   <alternative>; AST_WHILE: condition, code; AST_FOR: from, to, step, code;
+//   AST_NEW_ARRAY: dimensions; AST_DICT_VALUE: key
+// - Values that don't fit the header (floats, constant declarations)
+// are kept in side tables, names and strings are atoms
+// - Doesn't refer to the IAst nodes, so the tree may be freed after flattening
+class FlatAst
+{
+public:
+	// Flattens the tree starting with root
+	explicit FlatAst(IAst &root);
+
+	static const unsigned ROOT = 0;
+
+	size_t Size() const;
+	const FlatNode &GetNode(unsigned index) const;
+	const std::vector<FlatNode> &GetNodes() const;
+
+	unsigned GetChildCount(unsigned index) const;
+	// Index of the n-th child (from 0)
+	unsigned GetChild(unsigned index, unsigned n) const;
+
+	int GetInt(unsigned index) const;
+	double GetFloat(unsigned index) const;
+	bool GetBool(unsigned index) const;
+	const std::string &GetString(unsigned index) const;
+	Atom GetAtom(unsigned index) const;
+	const std::string &GetName(unsigned index) const;
+	KEYWORD GetOperator(unsigned index) const;
+	std::shared_ptr<ConstantBase> GetConst(unsigned index) const;
+
+private:
+	class Builder;
+
+	std::vector<FlatNode> m_nodes;
+	std::vector<double> m_floats;
+	std::vector<std::shared_ptr<ConstantBase>> m_constants;
+};
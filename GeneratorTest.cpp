@@ -0,0 +1,29 @@
+#include "GeneratorTest.h"
+#include "UnitTest.h"
+#include "ProgramGenerator.h"
+
+using namespace std;
+
+void TestGenerator()
+{
+	// Seeds that made divisors folding to 0 before divisors became literals
+	for (unsigned seed = 1; seed <= 10; ++seed)
+	{
+		GeneratorOptions options;
+		options.seed = seed;
+		options.functionCount = 20;
+		options.statementsPerFunction = 30;
+		options.maxBlockDepth = 4;
+		options.maxExpressionDepth = 5;
+
+		ProgramGenerator generator(options);
+		string error = GetParseError(generator.Generate());
+		Check(error.empty(), "program of seed " + to_string(seed) + " is invalid: " + error);
+	}
+
+	// Folding of a constant 'mod' by 0 is an error, the same as of '/'
+	string error = GetParseError(ReadTestProgram("ModByZero.txt"));
+	Check(error.find("Division by zero") != string::npos, "'mod 0' isn't an error: " + error);
+	error = GetParseError(ReadTestProgram("TestDiv.txt"));
+	Check(error.find("Division by zero") != string::npos, "'/ 0' isn't an error: " + error);
+}
@@ -0,0 +1,333 @@
+#include <algorithm>
+#include <iterator>
+#include "IncrementalParser.h"
+#include "Lexer.h"
+#include "Parser.h"
+#include "Ast.h"
+#include "AstContext.h"
+#include "Exception.h"
+
+using namespace std;
+
+struct IncrementalParser::Program
+{
+	AstList list;
+	// Keep the definitions of the list alive, one per segment
+	vector<shared_ptr<AstList>> owners;
+};
+
+// Empty list whose handle keeps the context alive
+static shared_ptr<AstList> MakeList(AstContext &context)
+{
+	return context.Handle(context.Make<AstList>());
+}
+
+// Replaces items [first, last) with the replacement, in place if their number stays the same
+template<class T>
+static void ReplaceRange(vector<T> &items, size_t first, size_t last, vector<T> &replacement)
+{
+	if (replacement.size() == last - first)
+	{
+		move(replacement.begin(), replacement.end(), items.begin() + first);
+		return;
+	}
+	items.erase(items.begin() + first, items.begin() + last);
+	items.insert(items.begin() + first, make_move_iterator(replacement.begin()), make_move_iterator(replacement.end()));
+}
+
+IncrementalParser::Segment::Segment()
+	: isDirty(false)
+{
+}
+
+IncrementalParser::Segment::Segment(Segment &&other)
+	: lines(move(other.lines))
+	, definitions(move(other.definitions))
+	, isDirty(other.isDirty)
+{
+}
+
+IncrementalParser::Segment &IncrementalParser::Segment::operator=(Segment &&other)
+{
+	lines = move(other.lines);
+	definitions = move(other.definitions);
+	isDirty = other.isDirty;
+	return *this;
+}
+
+IncrementalParser::IncrementalParser()
+	: m_dirtyCount(0)
+	, m_program(make_shared<Program>())
+{
+	InitOperatorMap();
+}
+
+void IncrementalParser::Load(const char *data, size_t size)
+{
+	Segment whole;
+	InputStream is(data, size);
+	do
+	{
+		whole.lines.push_back(is.GetLine());
+	} while (is.NextLine());
+	whole.definitions = MakeList(*make_shared<AstContext>());
+	whole.isDirty = true;
+
+	m_segments.clear();
+	m_program = make_shared<Program>();
+	m_program->owners.push_back(whole.definitions);
+	m_lineCounts.Assign(vector<int>(1, static_cast<int>(whole.lines.size())));
+	m_definitionCounts.Assign(vector<int>(1, 0));
+	m_dirtyCount = 1;
+	m_segments.push_back(move(whole));
+
+	Reparse(0, 1);
+}
+
+void IncrementalParser::Edit(int firstLine, int removedCount, const vector<string> &newLines)
+{
+	size_t begin = firstLine - 1;
+	if (firstLine < 1 || removedCount < 0 ||
+		begin + removedCount > static_cast<size_t>(m_lineCounts.Sum(m_segments.size())))
+	{
+		throw InternalError("IncrementalParser::Edit(): lines are out of range");
+	}
+
+	// Find the segments with the edited lines, lines added at the end go to the last one
+	size_t first = min(m_lineCounts.Find(static_cast<int>(begin)), m_segments.size() - 1);
+	size_t last = first + 1;
+	if (removedCount > 0)
+	{
+		last = max(last, m_lineCounts.Find(static_cast<int>(begin + removedCount - 1)) + 1);
+	}
+
+	// The lines of all the edited segments are moved to the first one,
+	// all of them are parsed again anyway
+	vector<string> &lines = m_segments[first].lines;
+	int lineCount = static_cast<int>(lines.size());
+	for (size_t i = first + 1; i < last; i++)
+	{
+		vector<string> &other = m_segments[i].lines;
+		m_lineCounts.Add(i, -static_cast<int>(other.size()));
+		lines.insert(lines.end(), make_move_iterator(other.begin()), make_move_iterator(other.end()));
+		other.clear();
+	}
+
+	// Typing changes lines in place, that doesn't need to move the following lines
+	size_t offset = begin - m_lineCounts.Sum(first);
+	size_t replaced = min(static_cast<size_t>(removedCount), newLines.size());
+	copy(newLines.begin(), newLines.begin() + replaced, lines.begin() + offset);
+	lines.erase(lines.begin() + offset + replaced, lines.begin() + offset + removedCount);
+	lines.insert(lines.begin() + offset + replaced, newLines.begin() + replaced, newLines.end());
+	m_lineCounts.Add(first, static_cast<int>(lines.size()) - lineCount);
+
+	Reparse(first, last);
+
+	// The program isn't correct while there are errors anywhere
+	for (size_t i = 0; m_dirtyCount > 0 && i < m_segments.size(); i++)
+	{
+		if (m_segments[i].isDirty)
+		{
+			Reparse(i, i + 1);
+		}
+	}
+}
+
+shared_ptr<AstList> IncrementalParser::GetProgram() const
+{
+	return shared_ptr<AstList>(m_program, &m_program->list);
+}
+
+vector<string> IncrementalParser::GetLines() const
+{
+	vector<string> lines;
+	lines.reserve(m_lineCounts.Sum(m_segments.size()));
+	for (const Segment &segment : m_segments)
+	{
+		lines.insert(lines.end(), segment.lines.begin(), segment.lines.end());
+	}
+	return lines;
+}
+
+void IncrementalParser::Reparse(size_t first, size_t last)
+{
+	while (true)
+	{
+		vector<Segment> segments;
+		REGION_RESULT result;
+
+		try
+		{
+			result = ParseRegion(first, last, segments);
+		}
+		catch (const CompileError &)
+		{
+			Segment dirty;
+			for (size_t i = first; i < last; i++)
+			{
+				const vector<string> &lines = m_segments[i].lines;
+				dirty.lines.insert(dirty.lines.end(), lines.begin(), lines.end());
+			}
+			dirty.definitions = MakeList(*make_shared<AstContext>());
+			dirty.isDirty = true;
+
+			segments.clear();
+			segments.push_back(move(dirty));
+			ReplaceSegments(first, last, segments);
+			throw;
+		}
+
+		switch (result)
+		{
+		case REGION_EXTEND_BACK:
+			first--;
+			break;
+
+		case REGION_EXTEND_FORWARD:
+			last++;
+			break;
+
+		default:
+			ReplaceSegments(first, last, segments);
+			return;
+		}
+	}
+}
+
+IncrementalParser::REGION_RESULT IncrementalParser::ParseRegion(size_t first, size_t last,
+	vector<Segment> &result) const
+{
+	int firstLine = m_lineCounts.Sum(first);
+
+	// Lines of the region, they are given to the new segments
+	vector<string> lines;
+	lines.reserve(m_lineCounts.Sum(last) - firstLine);
+	for (size_t i = first; i < last; i++)
+	{
+		lines.insert(lines.end(), m_segments[i].lines.begin(), m_segments[i].lines.end());
+	}
+
+	Lexer lexer;
+	TokenBuffer tokens;
+	for (size_t i = 0; i < lines.size(); i++)
+	{
+		tokens.Append(lexer.ParseLine(lines[i], firstLine + static_cast<int>(i) + 1));
+	}
+
+	TokenStream ts(tokens);
+
+	// Segments of the region share the context of the stream
+	Segment segment;
+	segment.definitions = MakeList(ts.GetAstContext());
+	int segmentBegin = firstLine;
+	int previousEnd = -1;
+	bool isEmpty = true;
+
+	try
+	{
+		while (true)
+		{
+			int definitionBegin = ts.Current().GetLineNumber() - 1;
+
+			ParseResult definition = ParseDefinition(ts);
+			if (definition.IsError())
+			{
+				break;
+			}
+
+			// A definition that doesn't share lines with the previous one starts a new segment
+			if (!segment.definitions->IsEmpty() && definitionBegin > previousEnd)
+			{
+				auto from = lines.begin() + (segmentBegin - firstLine);
+				auto to = lines.begin() + (definitionBegin - firstLine);
+				segment.lines.assign(make_move_iterator(from), make_move_iterator(to));
+				result.push_back(move(segment));
+
+				segment.definitions = MakeList(ts.GetAstContext());
+				segmentBegin = definitionBegin;
+			}
+
+			segment.definitions->AddElement(definition.Get());
+			previousEnd = ts.Previous().GetLineNumber() - 1;
+			isEmpty = false;
+		}
+	}
+	catch (const IntermediateError &ex)
+	{
+		// The definition may continue in the next segment
+		if (ts.IsEOS() && last < m_segments.size())
+		{
+			return REGION_EXTEND_FORWARD;
+		}
+		throw CompileError(ex.what(), ts.Previous());
+	}
+
+	if (!ts.IsEOS())
+	{
+		// The tokens may continue the last definition of the previous segment
+		if (isEmpty && first > 0)
+		{
+			return REGION_EXTEND_BACK;
+		}
+		throw CompileError("Syntax error", ts.Current());
+	}
+
+	segment.lines.assign(make_move_iterator(lines.begin() + (segmentBegin - firstLine)), make_move_iterator(lines.end()));
+	result.push_back(move(segment));
+
+	return REGION_PARSED;
+}
+
+void IncrementalParser::ReplaceSegments(size_t first, size_t last, vector<Segment> &segments)
+{
+	// A program held by the caller stays as it was
+	if (m_program.use_count() > 1)
+	{
+		m_program = make_shared<Program>(*m_program);
+	}
+
+	vector<IAst *> definitions;
+	vector<shared_ptr<AstList>> owners;
+	for (const Segment &segment : segments)
+	{
+		const vector<IAst *> &elements = segment.definitions->GetElements();
+		definitions.insert(definitions.end(), elements.begin(), elements.end());
+		owners.push_back(segment.definitions);
+		m_dirtyCount += segment.isDirty ? 1 : 0;
+	}
+	for (size_t i = first; i < last; i++)
+	{
+		m_dirtyCount -= m_segments[i].isDirty ? 1 : 0;
+	}
+
+	m_program->list.ReplaceElements(m_definitionCounts.Sum(first), m_definitionCounts.Sum(last), definitions);
+	ReplaceRange(m_program->owners, first, last, owners);
+
+	if (segments.size() == last - first)
+	{
+		for (size_t i = 0; i < segments.size(); i++)
+		{
+			const Segment &old = m_segments[first + i];
+			m_lineCounts.Add(first + i, static_cast<int>(segments[i].lines.size()) - static_cast<int>(old.lines.size()));
+			m_definitionCounts.Add(first + i, static_cast<int>(segments[i].definitions->GetElements().size()) -
+				static_cast<int>(old.definitions->GetElements().size()));
+		}
+		ReplaceRange(m_segments, first, last, segments);
+		return;
+	}
+
+	// Segments are split or joined, the counts after them have moved
+	ReplaceRange(m_segments, first, last, segments);
+
+	vector<int> lineCounts;
+	vector<int> definitionCounts;
+	lineCounts.reserve(m_segments.size());
+	definitionCounts.reserve(m_segments.size());
+	for (const Segment &segment : m_segments)
+	{
+		lineCounts.push_back(static_cast<int>(segment.lines.size()));
+		definitionCounts.push_back(static_cast<int>(segment.definitions->GetElements().size()));
+	}
+	m_lineCounts.Assign(lineCounts);
+	m_definitionCounts.Assign(definitionCounts);
+}
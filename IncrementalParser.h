@@ -0,0 +1,81 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include "AstFwd.h"
+#include "FenwickTree.h"
+
+// Front end for editors, which recompile the program after every change
+// - Keeps the source lines and the definitions parsed from them
+// - After an edit only the definitions containing the edited lines are
+// tokenized and parsed again, AST of the other definitions is reused
+// - Lines are kept by segment and the segments are found by prefix sums,
+// so an edit inside a definition doesn't touch the lines and definitions
+// of the others
+// - Errors are thrown as CompileError; the parser stays usable,
+// the lines with the error are parsed again on the next edit
+class IncrementalParser
+{
+public:
+	IncrementalParser();
+
+	// Parses the whole text
+	void Load(const char *data, size_t size);
+
+	// Replaces removedCount lines starting with firstLine (numbered from 1)
+	// with newLines and updates the program
+	void Edit(int firstLine, int removedCount, const std::vector<std::string> &newLines);
+
+	// Definitions of the program, as returned by Parse()
+	// - Definitions from the lines that have errors are missing
+	// - Edits splice the reparsed definitions into the program; a program
+	// that is still held by the caller is copied first, so it stays as it was
+	std::shared_ptr<AstList> GetProgram() const;
+
+	// Copy of all the lines
+	std::vector<std::string> GetLines() const;
+
+private:
+	// Lines with one or more definitions, the lines of a definition
+	// are never shared with another segment
+	struct Segment
+	{
+		Segment();
+		// Segments are only moved, so their lines aren't copied
+		Segment(Segment &&other);
+		Segment &operator=(Segment &&other);
+
+		std::vector<std::string> lines;
+		std::shared_ptr<AstList> definitions;
+		// Lines couldn't be parsed, they are parsed again on the next edit
+		bool isDirty;
+	};
+
+	// Definitions of all the segments
+	struct Program;
+
+	enum REGION_RESULT
+	{
+		REGION_PARSED,
+		// Region doesn't begin with a definition, so the previous
+		// segment has to be parsed with it
+		REGION_EXTEND_BACK,
+		// Region ends in the middle of a definition
+		REGION_EXTEND_FORWARD
+	};
+
+	std::vector<Segment> m_segments;
+	// Numbers of lines and of definitions of the segments
+	FenwickTree m_lineCounts;
+	FenwickTree m_definitionCounts;
+	// Number of the dirty segments, the others aren't looked at while it's 0
+	size_t m_dirtyCount;
+	std::shared_ptr<Program> m_program;
+
+	// Parses segments [first, last) again, replacing them with new segments
+	void Reparse(size_t first, size_t last);
+	// Parses the lines of segments [first, last), result gets the lines
+	REGION_RESULT ParseRegion(size_t first, size_t last, std::vector<Segment> &result) const;
+	// Replaces segments [first, last) and their definitions in the program
+	void ReplaceSegments(size_t first, size_t last, std::vector<Segment> &segments);
+};
@@ -1,27 +1,116 @@
 #include "InputStream.h"
 #include <string.h>
+#include "CharScanner.h"
 
 using namespace std;
 
-InputStream::InputStream(const string &text, int lineNumber)
+InputStream::InputStream(const string &text, int lineNumber, LineTable *lines)
 	: m_data(text)
-	, m_pos(m_data.begin())
+	, m_begin(m_data.c_str())
+	, m_end(m_data.c_str() + m_data.size())
+	, m_lineBegin(m_begin)
+	, m_lineEnd(m_end)
+	, m_nextLine(m_end)
+	, m_pos(m_begin)
 	, m_lineNumber(lineNumber)
+	, m_lineTable(lines)
+	, m_lineIndex(0)
 {
+	if (m_lineTable)
+	{
+		m_lineIndex = m_lineTable->AddLine(m_data.c_str(), m_data.size(), m_lineNumber);
+	}
+}
+
+InputStream::InputStream(const char *data, size_t size, LineTable *lines, int firstLineNumber)
+	: m_begin(data)
+	, m_end(data + size)
+	, m_lineNumber(firstLineNumber)
+	, m_lineTable(lines)
+	, m_lineIndex(0)
+{
+	SetLine(m_begin);
+}
+
+bool InputStream::NextLine()
+{
+	if (m_nextLine == m_end)
+	{
+		return false;
+	}
+
+	m_lineNumber++;
+	SetLine(m_nextLine);
+
+	return true;
+}
+
+void InputStream::SetLine(const char *lineBegin)
+{
+	m_lineBegin = lineBegin;
+
+	const char *lineBreak = m_lineBegin != m_end
+		? static_cast<const char *>(memchr(m_lineBegin, '\n', m_end - m_lineBegin))
+		: nullptr;
+	if (lineBreak)
+	{
+		m_lineEnd = lineBreak;
+		m_nextLine = lineBreak + 1;
+	}
+	else
+	{
+		m_lineEnd = m_end;
+		m_nextLine = m_end;
+	}
+
+	// Windows line breaks
+	if (m_lineEnd != m_lineBegin && *(m_lineEnd - 1) == '\r')
+	{
+		m_lineEnd--;
+	}
+
+	m_pos = m_lineBegin;
+
+	if (m_lineTable)
+	{
+		m_lineIndex = m_lineTable->AddExternalLine(m_lineBegin, m_lineEnd - m_lineBegin, m_lineNumber);
+	}
+
+	while (!m_pos_stack.empty())
+	{
+		m_pos_stack.pop();
+	}
+}
+
+void InputStream::Truncate(size_t pos)
+{
+	if (pos < static_cast<size_t>(m_lineEnd - m_lineBegin))
+	{
+		m_lineEnd = m_lineBegin + pos;
+
+		if (m_lineTable)
+		{
+			m_lineTable->Truncate(m_lineIndex, pos);
+		}
+	}
+	if (m_pos > m_lineEnd)
+	{
+		m_pos = m_lineEnd;
+	}
 }
 
 size_t InputStream::Tell() const
 {
-	return m_pos - m_data.begin();
+	return m_pos - m_lineBegin;
 }
 
 size_t InputStream::Seek(size_t pos)
 {
-	if (pos < m_data.size())
+	if (pos < static_cast<size_t>(m_lineEnd - m_lineBegin))
 	{
-		m_pos = m_data.begin() + pos;
+		m_pos = m_lineBegin + pos;
 	} else {
-		m_pos = m_data.end();
+		m_pos = m_lineEnd;
 	}
 
 	return Tell();
@@ -35,30 +124,20 @@ size_t InputStream::Forward(size_t shift)
 
 size_t InputStream::SkipSpaces()
 {
-	size_t skipped = 0;
-
-	for (auto skip_iter = m_pos; skip_iter != m_data.end(); skip_iter++)
-	{
-		if (isspace(*skip_iter))
-		{
-			skipped++;
-		} else {
-			break;
-		}
-	}
-	
-	Forward(skipped);
+	size_t skipped = CharScanner::SpanSpaces(m_pos, m_lineEnd);
+	m_pos += skipped;
 	return skipped;
 }
 
 bool InputStream::IsEOS() const
 {
-	return m_pos == m_data.end();
+	return m_pos == m_lineEnd;
 }
 
 string InputStream::Get(size_t length) const
 {
-	return m_data.substr(Tell(), length);
+	size_t available = m_lineEnd - m_pos;
+	return string(m_pos, length < available ? length : available);
 }
 
 bool InputStream::Match(const char *text) const
@@ -66,7 +145,7 @@ bool InputStream::Match(const char *text) const
 	if (*text == '\0')
 		return true;
 
-	for (auto ch = m_pos; ch != m_data.end(); ch++, text++)
+	for (const char *ch = m_pos; ch != m_lineEnd; ch++, text++)
 	{
 		if (*text == '\0')
 			return true;
@@ -91,7 +170,12 @@ bool InputStream::MatchF(const char *text)
 
 const char *InputStream::GetRemainingText() const
 {
-	return m_data.c_str() + Tell();
+	return m_pos;
+}
+
+size_t InputStream::GetRemainingLength() const
+{
+	return m_lineEnd - m_pos;
 }
 
 int InputStream::GetChar() const
@@ -131,7 +215,17 @@ int InputStream::GetLineNumber() const
 	return m_lineNumber;
 }
 
-const char *InputStream::GetLine() const
+string InputStream::GetLine() const
+{
+	return string(m_lineBegin, m_lineEnd);
+}
+
+const LineTable *InputStream::GetLineTable() const
+{
+	return m_lineTable;
+}
+
+unsigned InputStream::GetLineIndex() const
 {
-	return m_data.c_str();
+	return m_lineIndex;
 }
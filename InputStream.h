@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <stack>
+#include "LineTable.h"
 
 #define EOS		(-1)
 
@@ -8,7 +9,27 @@ class InputStream
 {
 public:
 	//      
-	InputStream(const std::string &text, int lineNumber);
+	// - If lines is not null, the line is added to that table
+	InputStream(const std::string &text, int lineNumber, LineTable *lines = nullptr);
+
+	// Creates input stream over an external buffer without copying it
+	// - The buffer must outlive the stream
+	// - The stream is positioned at the first line of the buffer,
+	// NextLine() moves it to the following one
+	// - If lines is not null, every line is added to that table without
+	// copying it, so the buffer must outlive the table as well
+	InputStream(const char *data, size_t size, LineTable *lines = nullptr, int firstLineNumber = 1);
+
+	InputStream(const InputStream &) = delete;
+	InputStream &operator=(const InputStream &) = delete;
+
+	// Moves to the beginning of the next line of the buffer
+	// Returns false if there are no more lines
+	bool NextLine();
+
+	// Cuts the current line short at position pos
+	// (used to throw away comments)
+	void Truncate(size_t pos);
 
 	//    
 	size_t Tell() const;
@@ -37,10 +58,13 @@ public:
 
 	//   ,     
 	//  
-	bool InputStream::MatchF(const char *text);
+	bool MatchF(const char *text);
 
 	//   
+	// (for a stream over a buffer it isn't null-terminated at the end of line)
 	const char *GetRemainingText() const;
+	// Number of characters left in the current line
+	size_t GetRemainingLength() const;
 
 	//    
 	int GetChar() const;
@@ -55,19 +79,37 @@ public:
 	//      
 	int GetLineNumber() const;
 
-	//    ,
-	//      
-	const char *GetLine() const;
+	// Returns text of the current line
+	std::string GetLine() const;
+
+	// Table where the lines are registered (can be null)
+	const LineTable *GetLineTable() const;
+	// Index of the current line in the table
+	unsigned GetLineIndex() const;
 
 private:
+	// Holds the text if stream was created from std::string
 	const std::string m_data;
 
+	// Whole buffer
+	const char *m_begin, *m_end;
+	// Current line, without line break
+	const char *m_lineBegin, *m_lineEnd;
+	// Beginning of the next line
+	const char *m_nextLine;
+
 	//  
-	std::string::const_iterator m_pos;
+	const char *m_pos;
 
 	// ,     
 	std::stack<size_t> m_pos_stack;
 
 	//     
 	int m_lineNumber;
+
+	LineTable *m_lineTable;
+	unsigned m_lineIndex;
+
+	// Makes the line starting at lineBegin current
+	void SetLine(const char *lineBegin);
 };
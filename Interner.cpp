@@ -0,0 +1,235 @@
+#include <ctype.h>
+#include "Interner.h"
+#include "Exception.h"
+
+using namespace std;
+
+// Slots of the hash table that hold no atom
+static const Atom EMPTY_SLOT = Interner::NO_ATOM;
+
+// Function-local statics aren't initialized thread safely by VS2013,
+// so the interner is created during static initialization, before any threads
+static const Atom EMPTY_STRING = Interner::Intern("", 0);
+
+Interner::SlotTable::SlotTable(size_t size)
+	: mask(size - 1)
+	, slots(new atomic<Atom>[size])
+{
+	for (size_t i = 0; i < size; i++)
+	{
+		slots[i].store(EMPTY_SLOT, memory_order_relaxed);
+	}
+}
+
+Interner::SlotTable::~SlotTable()
+{
+	delete[] slots;
+}
+
+Interner::Interner()
+	: m_blocks(MAX_BLOCKS, nullptr)
+	, m_count(0)
+	, m_table(new SlotTable(1024))
+{
+}
+
+Interner::~Interner()
+{
+	for (Entry *block : m_blocks)
+	{
+		delete[] block;
+	}
+	for (SlotTable *table : m_oldTables)
+	{
+		delete table;
+	}
+	delete m_table.load();
+}
+
+Interner &Interner::Instance()
+{
+	static Interner instance;
+	return instance;
+}
+
+Atom Interner::Intern(const char *text, size_t length)
+{
+	return Instance().FindOrAdd(text, length, false);
+}
+
+Atom Interner::Intern(const string &text)
+{
+	return Instance().FindOrAdd(text.data(), text.size(), false);
+}
+
+Atom Interner::InternLowercase(const char *text, size_t length)
+{
+	return Instance().FindOrAdd(text, length, true);
+}
+
+Atom Interner::Find(const char *text, size_t length)
+{
+	Interner &self = Instance();
+	return self.Lookup(self.m_table.load(memory_order_acquire), Hash(text, length, false), text, length, false);
+}
+
+Atom Interner::Find(const string &text)
+{
+	return Find(text.data(), text.size());
+}
+
+const string &Interner::GetString(Atom atom)
+{
+	return Instance().GetEntry(atom).text;
+}
+
+unsigned Interner::Count()
+{
+	Interner &self = Instance();
+	lock_guard<mutex> guard(self.m_lock);
+	return self.m_count;
+}
+
+const Interner::Entry &Interner::GetEntry(Atom atom) const
+{
+	return m_blocks[atom >> BLOCK_BITS][atom & (BLOCK_SIZE - 1)];
+}
+
+Atom Interner::Lookup(const SlotTable *table, size_t hash, const char *text, size_t length, bool toLower) const
+{
+	for (size_t slot = hash & table->mask; ; slot = (slot + 1) & table->mask)
+	{
+		// Acquire pairs with the release in FindOrAdd(), the entry is complete once its atom is seen
+		Atom atom = table->slots[slot].load(memory_order_acquire);
+		if (atom == EMPTY_SLOT)
+		{
+			return EMPTY_SLOT;
+		}
+
+		const Entry &entry = GetEntry(atom);
+		if (entry.hash == hash && Equals(entry.text, text, length, toLower))
+		{
+			return atom;
+		}
+	}
+}
+
+Atom Interner::FindOrAdd(const char *text, size_t length, bool toLower)
+{
+	size_t hash = Hash(text, length, toLower);
+
+	// Most of the time the string is already there
+	Atom atom = Lookup(m_table.load(memory_order_acquire), hash, text, length, toLower);
+	if (atom != EMPTY_SLOT)
+	{
+		return atom;
+	}
+
+	lock_guard<mutex> guard(m_lock);
+
+	SlotTable *table = m_table.load(memory_order_relaxed);
+	for (size_t slot = hash & table->mask; ; slot = (slot + 1) & table->mask)
+	{
+		atom = table->slots[slot].load(memory_order_relaxed);
+		if (atom == EMPTY_SLOT)
+		{
+			atom = Add(text, length, toLower, hash);
+			table->slots[slot].store(atom, memory_order_release);
+
+			// keep load factor under 1/2
+			if (m_count * 2 > table->mask + 1)
+			{
+				Rehash();
+			}
+			return atom;
+		}
+
+		const Entry &entry = GetEntry(atom);
+		if (entry.hash == hash && Equals(entry.text, text, length, toLower))
+		{
+			return atom;
+		}
+	}
+}
+
+Atom Interner::Add(const char *text, size_t length, bool toLower, size_t hash)
+{
+	Atom atom = m_count;
+
+	unsigned block = atom >> BLOCK_BITS;
+	if (block >= MAX_BLOCKS)
+	{
+		throw InternalError("Interner: too many strings");
+	}
+	if (!m_blocks[block])
+	{
+		m_blocks[block] = new Entry[BLOCK_SIZE];
+	}
+
+	Entry &entry = m_blocks[block][atom & (BLOCK_SIZE - 1)];
+	entry.text.assign(text, length);
+	if (toLower)
+	{
+		for (char &ch : entry.text)
+		{
+			ch = tolower(static_cast<unsigned char>(ch));
+		}
+	}
+	entry.hash = hash;
+
+	m_count++;
+
+	return atom;
+}
+
+void Interner::Rehash()
+{
+	SlotTable *oldTable = m_table.load(memory_order_relaxed);
+	SlotTable *table = new SlotTable((oldTable->mask + 1) * 2);
+
+	for (Atom atom = 0; atom < m_count; atom++)
+	{
+		size_t slot = GetEntry(atom).hash & table->mask;
+		while (table->slots[slot].load(memory_order_relaxed) != EMPTY_SLOT)
+		{
+			slot = (slot + 1) & table->mask;
+		}
+		table->slots[slot].store(atom, memory_order_relaxed);
+	}
+
+	m_table.store(table, memory_order_release);
+	m_oldTables.push_back(oldTable);
+}
+
+// FNV-1a
+size_t Interner::Hash(const char *text, size_t length, bool toLower)
+{
+	unsigned hash = 2166136261u;
+
+	for (size_t i = 0; i < length; i++)
+	{
+		unsigned char ch = toLower ? tolower(static_cast<unsigned char>(text[i])) : text[i];
+		hash = (hash ^ ch) * 16777619u;
+	}
+
+	return hash;
+}
+
+bool Interner::Equals(const string &str, const char *text, size_t length, bool toLower)
+{
+	if (str.size() != length)
+	{
+		return false;
+	}
+
+	for (size_t i = 0; i < length; i++)
+	{
+		char ch = toLower ? tolower(static_cast<unsigned char>(text[i])) : text[i];
+		if (str[i] != ch)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
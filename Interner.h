@@ -0,0 +1,86 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <mutex>
+#include <atomic>
+
+// Dense integer id of an interned string
+typedef unsigned Atom;
+
+// Global table of interned strings (identifiers, string literals, symbol names)
+// - Equal strings always get equal atoms, so names can be compared as integers
+// - Atoms are dense (0, 1, 2, ...) and can be used as array indexes
+// - Strings are never removed, references returned by GetString() stay valid
+// - Thread safe; looking up a string that is already there
+// and GetString() don't take a lock
+class Interner
+{
+public:
+	static Atom Intern(const char *text, size_t length);
+	static Atom Intern(const std::string &text);
+	// Interns text converted to lower case without making a copy of it
+	static Atom InternLowercase(const char *text, size_t length);
+
+	// Atom of a string that was interned, NO_ATOM if it wasn't
+	// - Doesn't add the string and doesn't take the lock
+	static Atom Find(const char *text, size_t length);
+	static Atom Find(const std::string &text);
+
+	static const Atom NO_ATOM = static_cast<Atom>(-1);
+
+	static const std::string &GetString(Atom atom);
+
+	// Number of interned strings
+	static unsigned Count();
+
+private:
+	Interner();
+	~Interner();
+
+	static Interner &Instance();
+
+	// Open addressing hash table of atoms
+	struct SlotTable
+	{
+		SlotTable(size_t size);
+		~SlotTable();
+
+		size_t mask;
+		std::atomic<Atom> *slots;
+	};
+
+	// Strings are kept in blocks that are never moved,
+	// block list is allocated once so readers don't need a lock
+	struct Entry
+	{
+		std::string text;
+		size_t hash;
+	};
+
+	Atom FindOrAdd(const char *text, size_t length, bool toLower);
+	// Looks for the string without taking the lock
+	// - Returns NO_ATOM if it's not there
+	Atom Lookup(const SlotTable *table, size_t hash, const char *text, size_t length, bool toLower) const;
+	Atom Add(const char *text, size_t length, bool toLower, size_t hash);
+	void Rehash();
+
+	const Entry &GetEntry(Atom atom) const;
+
+	static size_t Hash(const char *text, size_t length, bool toLower);
+	static bool Equals(const std::string &str, const char *text, size_t length, bool toLower);
+
+	static const unsigned BLOCK_BITS = 12;
+	static const unsigned BLOCK_SIZE = 1 << BLOCK_BITS;
+	static const unsigned MAX_BLOCKS = 1 << 12;
+
+	std::vector<Entry *> m_blocks;
+	unsigned m_count;
+
+	// Readers use the table without a lock, so replaced tables
+	// are kept until the interner is destroyed
+	std::atomic<SlotTable *> m_table;
+	std::vector<SlotTable *> m_oldTables;
+
+	// Taken to add strings
+	std::mutex m_lock;
+};
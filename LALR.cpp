@@ -0,0 +1,381 @@
+#include <vector>
+#include <string>
+#include <algorithm>
+#include "LALR.h"
+#include "LALRTables.h"
+#include "Parser.h"
+#include "Exception.h"
+#include "AstContext.h"
+
+using namespace std;
+
+namespace
+{
+	const int NO_TERMINAL = -1;
+
+	// Terminal of the grammar for each token
+	class TerminalTable
+	{
+	public:
+		TerminalTable()
+			: m_id(NO_TERMINAL)
+			, m_int(NO_TERMINAL)
+			, m_float(NO_TERMINAL)
+			, m_string(NO_TERMINAL)
+			, m_end(NO_TERMINAL)
+		{
+			fill(m_keywords, m_keywords + KEYWORD_COUNT, NO_TERMINAL);
+
+			for (unsigned t = 0; t < LALR_TERMINAL_COUNT; t++)
+			{
+				string spelling = LALR_TERMINALS[t];
+				if (spelling == "id")
+				{
+					m_id = t;
+				}
+				else if (spelling == "int")
+				{
+					m_int = t;
+				}
+				else if (spelling == "float")
+				{
+					m_float = t;
+				}
+				else if (spelling == "string")
+				{
+					m_string = t;
+				}
+				else if (spelling == "$end")
+				{
+					m_end = t;
+				}
+				else
+				{
+					for (unsigned kw = 0; kw < KEYWORD_COUNT; kw++)
+					{
+						if (spelling == KEYWORD_SPELLING[kw])
+						{
+							m_keywords[kw] = t;
+						}
+					}
+				}
+			}
+		}
+
+		// Returns NO_TERMINAL for the tokens the grammar doesn't have
+		int Get(const TokenStream &ts) const
+		{
+			switch (ts.CurrentType())
+			{
+			case TOKEN_ID:
+				return m_id;
+			case TOKEN_INT:
+				return m_int;
+			case TOKEN_FLOAT:
+				return m_float;
+			case TOKEN_STRING:
+				return m_string;
+			case TOKEN_EOF:
+				return m_end;
+			case TOKEN_KEYWORD:
+			case TOKEN_DELIMETER:
+				return m_keywords[ts.CurrentKeyword()];
+			default:
+				return NO_TERMINAL;
+			}
+		}
+
+	private:
+		int m_keywords[KEYWORD_COUNT];
+		int m_id;
+		int m_int;
+		int m_float;
+		int m_string;
+		int m_end;
+	};
+
+	const TerminalTable TERMINALS;
+
+	// Value of a symbol on the stack, fields are set by the actions
+	// (see Backslash.grammar) that need them
+	struct Value
+	{
+		Value()
+			: node(nullptr)
+			, atom(0)
+			, keyword(KW_CONST)
+			, dimension(0)
+		{
+		}
+
+		IAst *node;
+		// id
+		Atom atom;
+		// Keywords and delimiters, Type
+		KEYWORD keyword;
+		// Dimensions
+		int dimension;
+	};
+
+	Value Shift(AstContext &context, const TokenStream &ts)
+	{
+		Value value;
+		switch (ts.CurrentType())
+		{
+		case TOKEN_ID:
+			value.atom = ts.Current().GetValueA();
+			break;
+		case TOKEN_INT:
+			value.node = context.MakeExpression<AstIntConst>(ts.Current().GetValueI());
+			break;
+		case TOKEN_FLOAT:
+			value.node = context.MakeExpression<AstFloatConst>(ts.Current().GetValueF());
+			break;
+		case TOKEN_STRING:
+			value.node = context.MakeExpression<AstStringConst>(ts.Current().GetValueS());
+			break;
+		default:
+			value.keyword = ts.CurrentKeyword();
+			break;
+		}
+		return value;
+	}
+
+	ATOMIC_TYPE ToAtomicType(const Value &type)
+	{
+		switch (type.keyword)
+		{
+		case KW_STRING:
+			return ATOMIC_TYPE::TYPE_STRING;
+		case KW_INT:
+			return ATOMIC_TYPE::TYPE_INT;
+		case KW_FLOAT:
+			return ATOMIC_TYPE::TYPE_FLOAT;
+		case KW_BOOL:
+			return ATOMIC_TYPE::TYPE_BOOL;
+		default:
+			throw InternalError("ParseLALR: Type is not a simple type");
+		}
+	}
+
+	AstList *List(const Value &value)
+	{
+		return Cast<AstList>(value.node);
+	}
+
+	AstExpression *Expression(const Value &value)
+	{
+		return DynCast<AstExpression>(value.node);
+	}
+
+	// Makes the value of the left side of a rule from the values of its right side
+	Value Reduce(AstContext &context, unsigned action, const Value *rhs)
+	{
+		Value result;
+		switch (action)
+		{
+		case ACTION_PASS:
+		case ACTION_TYPE:
+			result = rhs[0];
+			break;
+
+		case ACTION_LIST_EMPTY:
+			result.node = context.Make<AstList>();
+			break;
+		case ACTION_LIST_FIRST:
+		{
+			auto list = context.Make<AstList>();
+			list->AddElement(rhs[0].node);
+			result.node = list;
+			break;
+		}
+		case ACTION_LIST_NEXT:
+			List(rhs[0])->AddElement(rhs[2].node);
+			result = rhs[0];
+			break;
+		case ACTION_LIST_APPEND:
+			List(rhs[0])->AddElement(rhs[1].node);
+			result = rhs[0];
+			break;
+
+		case ACTION_FUNCTION:
+		{
+			auto name = Cast<AstVariable>(rhs[1].node);
+			result.node = context.Make<AstFunction>(name->GetAtom(), name->GetType(), List(rhs[3]), List(rhs[5]));
+			context.ClearExpressions();
+			break;
+		}
+		case ACTION_VOID_NAME:
+			result.node = context.Make<AstVariable>(rhs[0].atom, DataType(ATOMIC_TYPE::TYPE_VOID));
+			break;
+		case ACTION_GLOBAL:
+			result.node = context.Make<AstGlobal>(List(rhs[1]));
+			break;
+		case ACTION_CONST:
+			result.node = CreateConstDecl(context, List(rhs[1]));
+			break;
+
+		case ACTION_SIMPLE_VARIABLE:
+			result.node = context.MakeExpression<AstVariable>(rhs[0].atom, DataType(ToAtomicType(rhs[1])));
+			break;
+		case ACTION_ARRAY_VARIABLE:
+			result.node = context.MakeExpression<AstVariable>(rhs[0].atom, DataType(rhs[2].dimension, ToAtomicType(rhs[1])));
+			break;
+		case ACTION_DICT_VARIABLE:
+			result.node = context.MakeExpression<AstVariable>(rhs[0].atom, DataType(ToAtomicType(rhs[1]), ToAtomicType(rhs[2])));
+			break;
+		case ACTION_DIMENSION_FIRST:
+			result.dimension = 1;
+			break;
+		case ACTION_DIMENSION_NEXT:
+			result.dimension = rhs[0].dimension + 1;
+			break;
+
+		case ACTION_CODE:
+			result = rhs[1];
+			break;
+		case ACTION_CALL_STATEMENT:
+			if (Expression(rhs[0])->GetType().IsNotVoid())
+			{
+				throw IntermediateError("In top level function calls return type must be converted to void");
+			}
+			result = rhs[0];
+			break;
+		case ACTION_ASSIGNMENT:
+			result.node = context.Make<AstAssignmentExpression>(Cast<AstVariable>(rhs[0].node),
+				Expression(rhs[2]));
+			break;
+		case ACTION_DICT_ASSIGNMENT:
+			result.node = context.Make<AstDictAssign>(Cast<AstDictValue>(rhs[0].node),
+				Expression(rhs[2]));
+			break;
+		case ACTION_ARRAY_ASSIGNMENT:
+			result.node = context.Make<AstArrayAssign>(rhs[0].node, rhs[2].node);
+			break;
+		case ACTION_RETURN:
+			result.node = context.Make<AstReturn>();
+			break;
+		case ACTION_RETURN_VALUE:
+			result.node = context.Make<AstReturn>(Expression(rhs[1]));
+			break;
+		case ACTION_IF:
+			result.node = context.Make<AstIf>(rhs[1].node, rhs[2].node, nullptr);
+			break;
+		case ACTION_IF_ELSE:
+			result.node = context.Make<AstIf>(rhs[1].node, rhs[2].node, rhs[4].node);
+			break;
+		case ACTION_FOR:
+			result.node = context.Make<AstFor>(rhs[1].node, rhs[3].node, nullptr, rhs[4].node);
+			break;
+		case ACTION_FOR_STEP:
+			result.node = context.Make<AstFor>(rhs[1].node, rhs[3].node, rhs[5].node, rhs[6].node);
+			break;
+		case ACTION_WHILE:
+			result.node = context.Make<AstWhile>(rhs[1].node, rhs[2].node, false);
+			break;
+		case ACTION_DO_WHILE:
+			result.node = context.Make<AstWhile>(rhs[3].node, rhs[1].node, true);
+			break;
+		case ACTION_CALL:
+		{
+			auto name = Cast<AstVariable>(rhs[0].node);
+			result.node = context.Make<AstFunctionCall>(name->GetAtom(), name->GetType(), List(rhs[2]));
+			break;
+		}
+
+		case ACTION_BINARY:
+			result.node = CreateBinaryExpression(context, rhs[0].node, rhs[1].keyword, rhs[2].node);
+			break;
+		case ACTION_UNARY:
+			result.node = CreateUnaryExpression(context, rhs[0].keyword, rhs[1].node);
+			break;
+		case ACTION_PARENTHESES:
+			result = rhs[1];
+			break;
+
+		case ACTION_NEW_ARRAY:
+		{
+			auto dimensions = List(rhs[4]);
+			if (dimensions->GetElements().size() < 1 ||
+				dimensions->GetElements().size() > 4)
+			{
+				throw IntermediateError("Only 1,2,3 and 4-dimension arrays are supported");
+			}
+			result.node = context.Make<AstNewArray>(ToAtomicType(rhs[2]), dimensions);
+			break;
+		}
+		case ACTION_NEW_DICT:
+			result.node = context.Make<AstNewDict>(ToAtomicType(rhs[2]), ToAtomicType(rhs[3]));
+			break;
+		case ACTION_ARRAY_VALUE:
+			result.node = context.Make<AstArrayValue>(rhs[0].atom, ToAtomicType(rhs[1]), List(rhs[2]));
+			break;
+		case ACTION_INDEX_FIRST:
+		{
+			auto list = context.Make<AstList>();
+			list->AddElement(rhs[1].node);
+			result.node = list;
+			break;
+		}
+		case ACTION_INDEX_NEXT:
+			List(rhs[0])->AddElement(rhs[2].node);
+			result = rhs[0];
+			break;
+		case ACTION_DICT_VALUE:
+			result.node = context.Make<AstDictValue>(rhs[0].atom, ToAtomicType(rhs[1]), ToAtomicType(rhs[2]), rhs[4].node);
+			break;
+
+		default:
+			throw InternalError("ParseLALR: Unknown action");
+		}
+		return result;
+	}
+}
+
+shared_ptr<IAst> ParseLALR(TokenStream &ts)
+{
+	AstContext &context = ts.GetAstContext();
+	// Values are kept for all the states but the first one
+	vector<int> states(1, 0);
+	vector<Value> values;
+
+	try
+	{
+		while (true)
+		{
+			int terminal = TERMINALS.Get(ts);
+			int action = terminal == NO_TERMINAL ? 0 : LALR_ACTIONS[states.back()][terminal];
+
+			if (action > 0)
+			{
+				values.push_back(Shift(context, ts));
+				states.push_back(action);
+				ts.Forward();
+			}
+			else if (action < 0)
+			{
+				const LALRRule &rule = LALR_RULES[-action - 1];
+				if (rule.action == ACTION_ACCEPT)
+				{
+					return context.Handle(values.back().node);
+				}
+
+				Value result = Reduce(context, rule.action, values.data() + values.size() - rule.length);
+
+				values.erase(values.end() - rule.length, values.end());
+				states.erase(states.end() - rule.length, states.end());
+
+				states.push_back(LALR_GOTOS[states.back()][rule.lhs]);
+				values.push_back(result);
+			}
+			else
+			{
+				throw CompileError("Syntax error", ts.Current());
+			}
+		}
+	}
+	catch (const IntermediateError &ex)
+	{
+		throw CompileError(ex.what(), ts.Previous());
+	}
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include <memory>
+#include "Ast.h"
+#include "TokenStream.h"
+
+// Table-driven LALR(1) parser of the whole language, alternative to Parse()
+// - Tables are generated from Backslash.grammar (see LALRTables.h)
+// - Makes the same tree as Parse(), semantic errors are the same,
+// syntax errors are reported as "Syntax error" at the unexpected token
+// - Runs in linear time on explicit stacks, so the depth of nesting
+// isn't limited by the native stack
+std::shared_ptr<IAst> ParseLALR(TokenStream &ts);
@@ -0,0 +1,826 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <algorithm>
+#include <stdexcept>
+#include <cctype>
+
+using namespace std;
+
+// Makes the tables of the LALR(1) parser (LALR.cpp) from a grammar
+// - Usage: LALRGenerator Backslash.grammar LALRTables.h
+// - States are made as the canonical LR(1) collection, then the states
+// with the same core are merged
+// - Shift/reduce conflicts are resolved by shifting, reduce/reduce
+// conflicts are errors in the grammar
+// - Output only depends on the grammar, so the header is the same
+// on every run and can be kept in the repository
+
+namespace
+{
+	const char *const END_SYMBOL = "$end";
+	const char *const START_SYMBOL = "$accept";
+
+	struct Rule
+	{
+		unsigned lhs;
+		// Symbols: terminals are 0 .. terminalCount - 1,
+		// nonterminals are terminalCount + their index
+		vector<unsigned> rhs;
+		unsigned action;
+		int line;
+	};
+
+	struct Grammar
+	{
+		vector<string> terminals;
+		vector<string> nonterminals;
+		vector<string> actions;
+		vector<Rule> rules;
+
+		unsigned TerminalCount() const
+		{
+			return static_cast<unsigned>(terminals.size());
+		}
+
+		bool IsTerminal(unsigned symbol) const
+		{
+			return symbol < TerminalCount();
+		}
+
+		string SymbolName(unsigned symbol) const
+		{
+			return IsTerminal(symbol) ? terminals[symbol] : nonterminals[symbol - TerminalCount()];
+		}
+	};
+
+	class GrammarError : public runtime_error
+	{
+	public:
+		GrammarError(int line, const string &message)
+			: runtime_error("line " + to_string(line) + ": " + message)
+		{
+		}
+	};
+
+	// -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+	//  Reading of the grammar
+	// -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+	enum LEXEME_TYPE
+	{
+		LEXEME_NAME,
+		LEXEME_QUOTED,
+		LEXEME_PUNCT,
+		LEXEME_END
+	};
+
+	struct Lexeme
+	{
+		LEXEME_TYPE type;
+		string text;
+		int line;
+	};
+
+	vector<Lexeme> Split(const string &text)
+	{
+		vector<Lexeme> result;
+		int line = 1;
+		size_t i = 0;
+		while (i < text.size())
+		{
+			char c = text[i];
+			if (c == '\n')
+			{
+				line++;
+				i++;
+			}
+			else if (isspace(static_cast<unsigned char>(c)))
+			{
+				i++;
+			}
+			else if (c == '#')
+			{
+				while (i < text.size() && text[i] != '\n')
+				{
+					i++;
+				}
+			}
+			else if (c == '\'')
+			{
+				size_t end = text.find('\'', i + 1);
+				if (end == string::npos || end == i + 1)
+				{
+					throw GrammarError(line, "Bad quoted terminal");
+				}
+				Lexeme lexeme = { LEXEME_QUOTED, text.substr(i + 1, end - i - 1), line };
+				result.push_back(lexeme);
+				i = end + 1;
+			}
+			else if (isalpha(static_cast<unsigned char>(c)) || c == '_')
+			{
+				size_t begin = i;
+				while (i < text.size() && (isalnum(static_cast<unsigned char>(text[i])) || text[i] == '_'))
+				{
+					i++;
+				}
+				Lexeme lexeme = { LEXEME_NAME, text.substr(begin, i - begin), line };
+				result.push_back(lexeme);
+			}
+			else if (c == ':' || c == '|' || c == ';' || c == '{' || c == '}')
+			{
+				Lexeme lexeme = { LEXEME_PUNCT, string(1, c), line };
+				result.push_back(lexeme);
+				i++;
+			}
+			else
+			{
+				throw GrammarError(line, string("Unexpected character '") + c + "'");
+			}
+		}
+		Lexeme end = { LEXEME_END, "", line };
+		result.push_back(end);
+		return result;
+	}
+
+	unsigned IndexOf(vector<string> &names, const string &name)
+	{
+		auto it = find(names.begin(), names.end(), name);
+		if (it != names.end())
+		{
+			return static_cast<unsigned>(it - names.begin());
+		}
+		names.push_back(name);
+		return static_cast<unsigned>(names.size() - 1);
+	}
+
+	struct RawAlternative
+	{
+		// Quoted terminals keep their quotes
+		vector<string> symbols;
+		string action;
+		int line;
+	};
+
+	struct RawRule
+	{
+		string lhs;
+		vector<RawAlternative> alternatives;
+	};
+
+	bool IsPunct(const Lexeme &lexeme, char c)
+	{
+		return lexeme.type == LEXEME_PUNCT && lexeme.text[0] == c;
+	}
+
+	Grammar ReadGrammar(const string &text)
+	{
+		vector<Lexeme> lexemes = Split(text);
+		vector<RawRule> rawRules;
+
+		size_t i = 0;
+		while (lexemes[i].type != LEXEME_END)
+		{
+			if (lexemes[i].type != LEXEME_NAME || !IsPunct(lexemes[i + 1], ':'))
+			{
+				throw GrammarError(lexemes[i].line, "Expected 'Name :'");
+			}
+			RawRule rule;
+			rule.lhs = lexemes[i].text;
+			i += 2;
+
+			while (true)
+			{
+				RawAlternative alternative;
+				alternative.line = lexemes[i].line;
+				while (lexemes[i].type == LEXEME_NAME || lexemes[i].type == LEXEME_QUOTED)
+				{
+					string symbol = lexemes[i].text;
+					if (lexemes[i].type == LEXEME_QUOTED)
+					{
+						symbol = "'" + symbol + "'";
+					}
+					alternative.symbols.push_back(symbol);
+					i++;
+				}
+				if (!IsPunct(lexemes[i], '{') || lexemes[i + 1].type != LEXEME_NAME || !IsPunct(lexemes[i + 2], '}'))
+				{
+					throw GrammarError(lexemes[i].line, "Expected '{ ACTION }' at the end of an alternative");
+				}
+				alternative.action = lexemes[i + 1].text;
+				i += 3;
+				rule.alternatives.push_back(alternative);
+
+				if (IsPunct(lexemes[i], '|'))
+				{
+					i++;
+				}
+				else if (IsPunct(lexemes[i], ';'))
+				{
+					i++;
+					break;
+				}
+				else
+				{
+					throw GrammarError(lexemes[i].line, "Expected '|' or ';'");
+				}
+			}
+			rawRules.push_back(rule);
+		}
+
+		if (rawRules.empty())
+		{
+			throw GrammarError(1, "Grammar has no rules");
+		}
+
+		Grammar grammar;
+		grammar.terminals.push_back(END_SYMBOL);
+		grammar.nonterminals.push_back(START_SYMBOL);
+		for (auto &rule : rawRules)
+		{
+			if (find(grammar.nonterminals.begin(), grammar.nonterminals.end(), rule.lhs) != grammar.nonterminals.end())
+			{
+				throw GrammarError(rule.alternatives[0].line, "Rule '" + rule.lhs + "' is defined twice");
+			}
+			grammar.nonterminals.push_back(rule.lhs);
+		}
+
+		// Terminals are numbered in order of appearance
+		for (auto &rule : rawRules)
+		{
+			for (auto &alternative : rule.alternatives)
+			{
+				for (auto &symbol : alternative.symbols)
+				{
+					if (find(grammar.nonterminals.begin(), grammar.nonterminals.end(), symbol) == grammar.nonterminals.end())
+					{
+						IndexOf(grammar.terminals, symbol);
+					}
+				}
+			}
+		}
+
+		unsigned terminalCount = grammar.TerminalCount();
+
+		// Rule 0: $accept -> start symbol
+		Rule start;
+		start.lhs = 0;
+		start.rhs.push_back(terminalCount + 1);
+		start.action = IndexOf(grammar.actions, "ACCEPT");
+		start.line = 0;
+		grammar.rules.push_back(start);
+
+		for (auto &rawRule : rawRules)
+		{
+			unsigned lhs = IndexOf(grammar.nonterminals, rawRule.lhs);
+			for (auto &alternative : rawRule.alternatives)
+			{
+				Rule rule;
+				rule.lhs = lhs;
+				rule.action = IndexOf(grammar.actions, alternative.action);
+				rule.line = alternative.line;
+				for (auto &symbol : alternative.symbols)
+				{
+					auto it = find(grammar.nonterminals.begin(), grammar.nonterminals.end(), symbol);
+					if (it != grammar.nonterminals.end())
+					{
+						rule.rhs.push_back(terminalCount + static_cast<unsigned>(it - grammar.nonterminals.begin()));
+					}
+					else
+					{
+						rule.rhs.push_back(IndexOf(grammar.terminals, symbol));
+					}
+				}
+				grammar.rules.push_back(rule);
+			}
+		}
+
+		return grammar;
+	}
+
+	// -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+	//  Construction of the tables
+	// -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+	struct Item
+	{
+		unsigned rule;
+		unsigned dot;
+		unsigned lookahead;
+
+		bool operator<(const Item &other) const
+		{
+			if (rule != other.rule)
+			{
+				return rule < other.rule;
+			}
+			if (dot != other.dot)
+			{
+				return dot < other.dot;
+			}
+			return lookahead < other.lookahead;
+		}
+
+		bool operator==(const Item &other) const
+		{
+			return rule == other.rule && dot == other.dot && lookahead == other.lookahead;
+		}
+	};
+
+	typedef vector<Item> ItemSet;
+	typedef vector<pair<unsigned, unsigned>> Core;
+
+	class TableBuilder
+	{
+	public:
+		explicit TableBuilder(const Grammar &grammar)
+			: m_grammar(grammar)
+			, m_conflicts(0)
+		{
+			ComputeFirst();
+			BuildCanonical();
+			MergeCores();
+			BuildTables();
+		}
+
+		// Action table: 0 - error, > 0 - shift to that state,
+		// < 0 - reduce by rule -value - 1 (rule 0 accepts)
+		const vector<vector<int>> &GetActions() const
+		{
+			return m_actions;
+		}
+
+		// Goto table: state after a nonterminal is reduced, 0 - none
+		const vector<vector<int>> &GetGotos() const
+		{
+			return m_gotos;
+		}
+
+		unsigned GetConflictCount() const
+		{
+			return m_conflicts;
+		}
+
+	private:
+		const Grammar &m_grammar;
+		unsigned m_conflicts;
+
+		vector<bool> m_nullable;
+		vector<set<unsigned>> m_first;
+
+		vector<ItemSet> m_states;
+		map<ItemSet, unsigned> m_stateIndex;
+		vector<map<unsigned, unsigned>> m_transitions;
+
+		// LALR states, index of the LALR state of each canonical one
+		vector<Core> m_cores;
+		vector<map<pair<unsigned, unsigned>, set<unsigned>>> m_lookaheads;
+		vector<map<unsigned, unsigned>> m_lalrTransitions;
+		vector<unsigned> m_lalrOf;
+
+		vector<vector<int>> m_actions;
+		vector<vector<int>> m_gotos;
+
+		unsigned NonterminalIndex(unsigned symbol) const
+		{
+			return symbol - m_grammar.TerminalCount();
+		}
+
+		void ComputeFirst()
+		{
+			size_t count = m_grammar.nonterminals.size();
+			m_nullable.assign(count, false);
+			m_first.assign(count, set<unsigned>());
+
+			bool changed = true;
+			while (changed)
+			{
+				changed = false;
+				for (auto &rule : m_grammar.rules)
+				{
+					unsigned lhs = rule.lhs;
+					bool allNullable = true;
+					for (unsigned symbol : rule.rhs)
+					{
+						if (m_grammar.IsTerminal(symbol))
+						{
+							changed |= m_first[lhs].insert(symbol).second;
+							allNullable = false;
+							break;
+						}
+						for (unsigned first : m_first[NonterminalIndex(symbol)])
+						{
+							changed |= m_first[lhs].insert(first).second;
+						}
+						if (!m_nullable[NonterminalIndex(symbol)])
+						{
+							allNullable = false;
+							break;
+						}
+					}
+					if (allNullable && !m_nullable[lhs])
+					{
+						m_nullable[lhs] = true;
+						changed = true;
+					}
+				}
+			}
+		}
+
+		// FIRST of rhs[dot..] followed by lookahead
+		void FirstOfSequence(const Rule &rule, unsigned from, unsigned lookahead, set<unsigned> &result) const
+		{
+			for (unsigned i = from; i < rule.rhs.size(); i++)
+			{
+				unsigned symbol = rule.rhs[i];
+				if (m_grammar.IsTerminal(symbol))
+				{
+					result.insert(symbol);
+					return;
+				}
+				const set<unsigned> &first = m_first[NonterminalIndex(symbol)];
+				result.insert(first.begin(), first.end());
+				if (!m_nullable[NonterminalIndex(symbol)])
+				{
+					return;
+				}
+			}
+			result.insert(lookahead);
+		}
+
+		ItemSet Closure(const ItemSet &kernel) const
+		{
+			set<Item> items(kernel.begin(), kernel.end());
+			vector<Item> work(kernel.begin(), kernel.end());
+			while (!work.empty())
+			{
+				Item item = work.back();
+				work.pop_back();
+
+				const Rule &rule = m_grammar.rules[item.rule];
+				if (item.dot >= rule.rhs.size() || m_grammar.IsTerminal(rule.rhs[item.dot]))
+				{
+					continue;
+				}
+
+				unsigned lhs = NonterminalIndex(rule.rhs[item.dot]);
+				set<unsigned> lookaheads;
+				FirstOfSequence(rule, item.dot + 1, item.lookahead, lookaheads);
+
+				for (unsigned r = 0; r < m_grammar.rules.size(); r++)
+				{
+					if (m_grammar.rules[r].lhs != lhs)
+					{
+						continue;
+					}
+					for (unsigned lookahead : lookaheads)
+					{
+						Item added = { r, 0, lookahead };
+						if (items.insert(added).second)
+						{
+							work.push_back(added);
+						}
+					}
+				}
+			}
+			return ItemSet(items.begin(), items.end());
+		}
+
+		unsigned AddState(const ItemSet &kernel)
+		{
+			ItemSet state = Closure(kernel);
+			auto it = m_stateIndex.find(state);
+			if (it != m_stateIndex.end())
+			{
+				return it->second;
+			}
+			unsigned index = static_cast<unsigned>(m_states.size());
+			m_states.push_back(state);
+			m_stateIndex[state] = index;
+			m_transitions.push_back(map<unsigned, unsigned>());
+			return index;
+		}
+
+		void BuildCanonical()
+		{
+			Item start = { 0, 0, 0 };
+			AddState(ItemSet(1, start));
+
+			for (unsigned s = 0; s < m_states.size(); s++)
+			{
+				// Kernels of the next states by the symbol after the dot
+				map<unsigned, ItemSet> kernels;
+				for (auto &item : m_states[s])
+				{
+					const Rule &rule = m_grammar.rules[item.rule];
+					if (item.dot < rule.rhs.size())
+					{
+						Item next = { item.rule, item.dot + 1, item.lookahead };
+						kernels[rule.rhs[item.dot]].push_back(next);
+					}
+				}
+				for (auto &kernel : kernels)
+				{
+					sort(kernel.second.begin(), kernel.second.end());
+					unsigned target = AddState(kernel.second);
+					m_transitions[s][kernel.first] = target;
+				}
+			}
+		}
+
+		static Core CoreOf(const ItemSet &state)
+		{
+			Core core;
+			for (auto &item : state)
+			{
+				pair<unsigned, unsigned> entry(item.rule, item.dot);
+				if (core.empty() || core.back() != entry)
+				{
+					core.push_back(entry);
+				}
+			}
+			return core;
+		}
+
+		void MergeCores()
+		{
+			map<Core, unsigned> coreIndex;
+			m_lalrOf.resize(m_states.size());
+
+			// Canonical states are numbered breadth first, so are the merged ones
+			for (unsigned s = 0; s < m_states.size(); s++)
+			{
+				Core core = CoreOf(m_states[s]);
+				auto it = coreIndex.find(core);
+				unsigned index;
+				if (it == coreIndex.end())
+				{
+					index = static_cast<unsigned>(m_cores.size());
+					coreIndex[core] = index;
+					m_cores.push_back(core);
+					m_lookaheads.push_back(map<pair<unsigned, unsigned>, set<unsigned>>());
+				}
+				else
+				{
+					index = it->second;
+				}
+				m_lalrOf[s] = index;
+
+				for (auto &item : m_states[s])
+				{
+					m_lookaheads[index][make_pair(item.rule, item.dot)].insert(item.lookahead);
+				}
+			}
+
+			m_lalrTransitions.assign(m_cores.size(), map<unsigned, unsigned>());
+			for (unsigned s = 0; s < m_states.size(); s++)
+			{
+				for (auto &transition : m_transitions[s])
+				{
+					m_lalrTransitions[m_lalrOf[s]][transition.first] = m_lalrOf[transition.second];
+				}
+			}
+		}
+
+		void Report(unsigned state, unsigned terminal, const string &message) const
+		{
+			cerr << "State " << state << ", '" << m_grammar.terminals[terminal] << "': " << message << "\n";
+		}
+
+		string RuleText(unsigned rule) const
+		{
+			const Rule &r = m_grammar.rules[rule];
+			string text = m_grammar.nonterminals[r.lhs] + " :";
+			for (unsigned symbol : r.rhs)
+			{
+				text += " " + m_grammar.SymbolName(symbol);
+			}
+			return text + " (line " + to_string(r.line) + ")";
+		}
+
+		void BuildTables()
+		{
+			unsigned terminalCount = m_grammar.TerminalCount();
+			size_t stateCount = m_cores.size();
+			m_actions.assign(stateCount, vector<int>(terminalCount, 0));
+			m_gotos.assign(stateCount, vector<int>(m_grammar.nonterminals.size(), 0));
+
+			bool reduceConflict = false;
+			vector<vector<bool>> conflicts(stateCount, vector<bool>(terminalCount, false));
+			for (unsigned s = 0; s < stateCount; s++)
+			{
+				for (auto &transition : m_lalrTransitions[s])
+				{
+					if (m_grammar.IsTerminal(transition.first))
+					{
+						m_actions[s][transition.first] = static_cast<int>(transition.second);
+					}
+					else
+					{
+						m_gotos[s][NonterminalIndex(transition.first)] = static_cast<int>(transition.second);
+					}
+				}
+
+				for (auto &entry : m_lookaheads[s])
+				{
+					unsigned rule = entry.first.first;
+					if (entry.first.second != m_grammar.rules[rule].rhs.size())
+					{
+						continue;
+					}
+					for (unsigned lookahead : entry.second)
+					{
+						int &action = m_actions[s][lookahead];
+						int reduce = -static_cast<int>(rule) - 1;
+						if (action > 0)
+						{
+							// Shift wins
+							if (!conflicts[s][lookahead])
+							{
+								conflicts[s][lookahead] = true;
+								m_conflicts++;
+							}
+						}
+						else if (action < 0)
+						{
+							Report(s, lookahead, "reduce/reduce conflict between " +
+								RuleText(-action - 1) + " and " + RuleText(rule));
+							reduceConflict = true;
+						}
+						else
+						{
+							action = reduce;
+						}
+					}
+				}
+			}
+
+			if (reduceConflict)
+			{
+				throw runtime_error("Grammar is not LALR(1)");
+			}
+		}
+	};
+
+	// -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+	//  Output
+	// -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
+
+	string Escape(const string &text)
+	{
+		string result;
+		for (char c : text)
+		{
+			if (c == '"' || c == '\\')
+			{
+				result += '\\';
+			}
+			result += c;
+		}
+		return result;
+	}
+
+	// Terminal as it is written in the grammar, without quotes
+	string Spelling(const string &terminal)
+	{
+		if (terminal.size() > 2 && terminal[0] == '\'')
+		{
+			return terminal.substr(1, terminal.size() - 2);
+		}
+		return terminal;
+	}
+
+	void WriteTable(ostream &os, const char *name, const vector<vector<int>> &table, const char *rows, const char *columns)
+	{
+		os << "static const short " << name << "[" << rows << "][" << columns << "] =\n{\n";
+		for (size_t s = 0; s < table.size(); s++)
+		{
+			os << "\t{";
+			for (size_t i = 0; i < table[s].size(); i++)
+			{
+				os << (i > 0 ? "," : "") << table[s][i];
+			}
+			os << "}" << (s + 1 < table.size() ? "," : "") << "\t// " << s << "\n";
+		}
+		os << "};\n\n";
+	}
+
+	void WriteHeader(ostream &os, const string &grammarFile, const Grammar &grammar, const TableBuilder &builder)
+	{
+		const vector<vector<int>> &actions = builder.GetActions();
+
+		os << "#pragma once\n\n";
+		os << "// Generated by LALRGenerator from " << grammarFile << ", don't edit\n";
+		os << "// - " << actions.size() << " states, " << grammar.rules.size() << " rules, "
+			<< builder.GetConflictCount() << " shift/reduce conflicts resolved by shifting\n\n";
+
+		os << "enum LALR_ACTION\n{\n";
+		for (size_t i = 0; i < grammar.actions.size(); i++)
+		{
+			os << "\tACTION_" << grammar.actions[i] << (i + 1 < grammar.actions.size() ? "," : "") << "\n";
+		}
+		os << "};\n\n";
+
+		os << "static const unsigned LALR_TERMINAL_COUNT = " << grammar.TerminalCount() << ";\n";
+		os << "static const unsigned LALR_NONTERMINAL_COUNT = " << grammar.nonterminals.size() << ";\n";
+		os << "static const unsigned LALR_RULE_COUNT = " << grammar.rules.size() << ";\n";
+		os << "static const unsigned LALR_STATE_COUNT = " << actions.size() << ";\n\n";
+
+		os << "// Spelling of keywords and delimiters, token class of the other terminals\n";
+		os << "static const char *const LALR_TERMINALS[LALR_TERMINAL_COUNT] =\n{\n";
+		for (size_t i = 0; i < grammar.terminals.size(); i++)
+		{
+			os << "\t\"" << Escape(Spelling(grammar.terminals[i])) << "\""
+				<< (i + 1 < grammar.terminals.size() ? "," : "") << "\n";
+		}
+		os << "};\n\n";
+
+		os << "static const char *const LALR_NONTERMINALS[LALR_NONTERMINAL_COUNT] =\n{\n";
+		for (size_t i = 0; i < grammar.nonterminals.size(); i++)
+		{
+			os << "\t\"" << grammar.nonterminals[i] << "\"" << (i + 1 < grammar.nonterminals.size() ? "," : "") << "\n";
+		}
+		os << "};\n\n";
+
+		os << "struct LALRRule\n{\n";
+		os << "\tunsigned char lhs;\n";
+		os << "\tunsigned char length;\n";
+		os << "\tunsigned char action;\n";
+		os << "};\n\n";
+
+		os << "static const LALRRule LALR_RULES[LALR_RULE_COUNT] =\n{\n";
+		for (size_t i = 0; i < grammar.rules.size(); i++)
+		{
+			const Rule &rule = grammar.rules[i];
+			os << "\t{ " << rule.lhs << ", " << rule.rhs.size() << ", ACTION_" << grammar.actions[rule.action] << " }"
+				<< (i + 1 < grammar.rules.size() ? "," : "") << "\t// " << grammar.nonterminals[rule.lhs] << " :";
+			for (unsigned symbol : rule.rhs)
+			{
+				os << " " << grammar.SymbolName(symbol);
+			}
+			os << "\n";
+		}
+		os << "};\n\n";
+
+		os << "// 0 - error, > 0 - shift to that state, < 0 - reduce by rule -value - 1\n";
+		WriteTable(os, "LALR_ACTIONS", actions, "LALR_STATE_COUNT", "LALR_TERMINAL_COUNT");
+		os << "// State after a nonterminal is reduced\n";
+		WriteTable(os, "LALR_GOTOS", builder.GetGotos(), "LALR_STATE_COUNT", "LALR_NONTERMINAL_COUNT");
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc != 3)
+	{
+		cerr << "Usage: LALRGenerator grammar output.h\n";
+		return 1;
+	}
+
+	ifstream input(argv[1], ios::binary);
+	if (!input)
+	{
+		cerr << "Cannot open file '" << argv[1] << "'\n";
+		return 1;
+	}
+	stringstream text;
+	text << input.rdbuf();
+
+	try
+	{
+		Grammar grammar = ReadGrammar(text.str());
+		TableBuilder builder(grammar);
+
+		// File name without the path, so the output doesn't depend on where it's built
+		string grammarFile = argv[1];
+		size_t slash = grammarFile.find_last_of("/\\");
+		if (slash != string::npos)
+		{
+			grammarFile = grammarFile.substr(slash + 1);
+		}
+
+		stringstream header;
+		WriteHeader(header, grammarFile, grammar, builder);
+
+		ofstream output(argv[2], ios::binary);
+		output << header.str();
+		if (!output)
+		{
+			cerr << "Cannot write file '" << argv[2] << "'\n";
+			return 1;
+		}
+
+		cerr << builder.GetActions().size() << " states, " << builder.GetConflictCount()
+			<< " shift/reduce conflicts\n";
+	}
+	catch (const exception &ex)
+	{
+		cerr << argv[1] << ": " << ex.what() << "\n";
+		return 1;
+	}
+	return 0;
+}
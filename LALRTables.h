@@ -0,0 +1,581 @@
+#pragma once
+
+// Generated by LALRGenerator from Backslash.grammar, don't edit
+// - 163 states, 89 rules, 39 shift/reduce conflicts resolved by shifting
+
+enum LALR_ACTION
+{
+	ACTION_ACCEPT,
+	ACTION_PASS,
+	ACTION_LIST_EMPTY,
+	ACTION_LIST_APPEND,
+	ACTION_FUNCTION,
+	ACTION_VOID_NAME,
+	ACTION_GLOBAL,
+	ACTION_CONST,
+	ACTION_LIST_FIRST,
+	ACTION_LIST_NEXT,
+	ACTION_SIMPLE_VARIABLE,
+	ACTION_ARRAY_VARIABLE,
+	ACTION_DICT_VARIABLE,
+	ACTION_TYPE,
+	ACTION_DIMENSION_FIRST,
+	ACTION_DIMENSION_NEXT,
+	ACTION_CODE,
+	ACTION_CALL_STATEMENT,
+	ACTION_ASSIGNMENT,
+	ACTION_DICT_ASSIGNMENT,
+	ACTION_ARRAY_ASSIGNMENT,
+	ACTION_RETURN,
+	ACTION_RETURN_VALUE,
+	ACTION_IF,
+	ACTION_IF_ELSE,
+	ACTION_FOR,
+	ACTION_FOR_STEP,
+	ACTION_WHILE,
+	ACTION_DO_WHILE,
+	ACTION_CALL,
+	ACTION_BINARY,
+	ACTION_PARENTHESES,
+	ACTION_UNARY,
+	ACTION_NEW_ARRAY,
+	ACTION_NEW_DICT,
+	ACTION_ARRAY_VALUE,
+	ACTION_INDEX_FIRST,
+	ACTION_INDEX_NEXT,
+	ACTION_DICT_VALUE
+};
+
+static const unsigned LALR_TERMINAL_COUNT = 46;
+static const unsigned LALR_NONTERMINAL_COUNT = 37;
+static const unsigned LALR_RULE_COUNT = 89;
+static const unsigned LALR_STATE_COUNT = 163;
+
+// Spelling of keywords and delimiters, token class of the other terminals
+static const char *const LALR_TERMINALS[LALR_TERMINAL_COUNT] =
+{
+	"$end",
+	"def",
+	"(",
+	")",
+	"id",
+	"global",
+	"const",
+	",",
+	"%",
+	"#",
+	"$",
+	"!",
+	"[",
+	"]",
+	"{",
+	"}",
+	"=",
+	"return",
+	"if",
+	"else",
+	"for",
+	"to",
+	"step",
+	"while",
+	"do",
+	"or",
+	"and",
+	"==",
+	"<>",
+	"<",
+	"<=",
+	">",
+	">=",
+	"+",
+	"-",
+	"*",
+	"/",
+	"mod",
+	"~",
+	"not",
+	"int",
+	"float",
+	"string",
+	"new",
+	"array",
+	"dict"
+};
+
+static const char *const LALR_NONTERMINALS[LALR_NONTERMINAL_COUNT] =
+{
+	"$accept",
+	"Program",
+	"Definitions",
+	"Definition",
+	"Function",
+	"FunctionName",
+	"Global",
+	"Const",
+	"Assignments",
+	"VariableList",
+	"Variables",
+	"Variable",
+	"Type",
+	"Dimensions",
+	"Code",
+	"Statements",
+	"Statement",
+	"Assignment",
+	"Return",
+	"If",
+	"For",
+	"While",
+	"DoWhile",
+	"Call",
+	"ExpressionList",
+	"Expressions",
+	"Expression",
+	"And",
+	"Equality",
+	"Comparison",
+	"Additive",
+	"Multiplicative",
+	"Primary",
+	"New",
+	"ArrayValue",
+	"Indexes",
+	"DictValue"
+};
+
+struct LALRRule
+{
+	unsigned char lhs;
+	unsigned char length;
+	unsigned char action;
+};
+
+static const LALRRule LALR_RULES[LALR_RULE_COUNT] =
+{
+	{ 0, 1, ACTION_ACCEPT },	// $accept : Program
+	{ 1, 1, ACTION_PASS },	// Program : Definitions
+	{ 2, 0, ACTION_LIST_EMPTY },	// Definitions :
+	{ 2, 2, ACTION_LIST_APPEND },	// Definitions : Definitions Definition
+	{ 3, 1, ACTION_PASS },	// Definition : Function
+	{ 3, 1, ACTION_PASS },	// Definition : Const
+	{ 3, 1, ACTION_PASS },	// Definition : Global
+	{ 4, 6, ACTION_FUNCTION },	// Function : 'def' FunctionName '(' VariableList ')' Code
+	{ 5, 1, ACTION_VOID_NAME },	// FunctionName : id
+	{ 5, 1, ACTION_PASS },	// FunctionName : Variable
+	{ 6, 2, ACTION_GLOBAL },	// Global : 'global' Variables
+	{ 7, 2, ACTION_CONST },	// Const : 'const' Assignments
+	{ 8, 1, ACTION_LIST_FIRST },	// Assignments : Assignment
+	{ 8, 3, ACTION_LIST_NEXT },	// Assignments : Assignments ',' Assignment
+	{ 9, 0, ACTION_LIST_EMPTY },	// VariableList :
+	{ 9, 1, ACTION_PASS },	// VariableList : Variables
+	{ 10, 1, ACTION_LIST_FIRST },	// Variables : Variable
+	{ 10, 3, ACTION_LIST_NEXT },	// Variables : Variables ',' Variable
+	{ 11, 2, ACTION_SIMPLE_VARIABLE },	// Variable : id Type
+	{ 11, 3, ACTION_ARRAY_VARIABLE },	// Variable : id Type Dimensions
+	{ 11, 5, ACTION_DICT_VARIABLE },	// Variable : id Type Type '(' ')'
+	{ 12, 1, ACTION_TYPE },	// Type : '%'
+	{ 12, 1, ACTION_TYPE },	// Type : '#'
+	{ 12, 1, ACTION_TYPE },	// Type : '$'
+	{ 12, 1, ACTION_TYPE },	// Type : '!'
+	{ 13, 2, ACTION_DIMENSION_FIRST },	// Dimensions : '[' ']'
+	{ 13, 3, ACTION_DIMENSION_NEXT },	// Dimensions : Dimensions '[' ']'
+	{ 14, 3, ACTION_CODE },	// Code : '{' Statements '}'
+	{ 15, 0, ACTION_LIST_EMPTY },	// Statements :
+	{ 15, 2, ACTION_LIST_APPEND },	// Statements : Statements Statement
+	{ 16, 1, ACTION_PASS },	// Statement : Assignment
+	{ 16, 1, ACTION_PASS },	// Statement : Return
+	{ 16, 1, ACTION_PASS },	// Statement : If
+	{ 16, 1, ACTION_PASS },	// Statement : For
+	{ 16, 1, ACTION_PASS },	// Statement : While
+	{ 16, 1, ACTION_PASS },	// Statement : DoWhile
+	{ 16, 1, ACTION_CALL_STATEMENT },	// Statement : Call
+	{ 17, 3, ACTION_ASSIGNMENT },	// Assignment : Variable '=' Expression
+	{ 17, 3, ACTION_DICT_ASSIGNMENT },	// Assignment : DictValue '=' Expression
+	{ 17, 3, ACTION_ARRAY_ASSIGNMENT },	// Assignment : ArrayValue '=' Expression
+	{ 18, 1, ACTION_RETURN },	// Return : 'return'
+	{ 18, 2, ACTION_RETURN_VALUE },	// Return : 'return' Expression
+	{ 19, 3, ACTION_IF },	// If : 'if' Expression Code
+	{ 19, 5, ACTION_IF_ELSE },	// If : 'if' Expression Code 'else' Code
+	{ 20, 5, ACTION_FOR },	// For : 'for' Assignment 'to' Expression Code
+	{ 20, 7, ACTION_FOR_STEP },	// For : 'for' Assignment 'to' Expression 'step' Expression Code
+	{ 21, 3, ACTION_WHILE },	// While : 'while' Expression Code
+	{ 22, 4, ACTION_DO_WHILE },	// DoWhile : 'do' Code 'while' Expression
+	{ 23, 4, ACTION_CALL },	// Call : FunctionName '(' ExpressionList ')'
+	{ 24, 0, ACTION_LIST_EMPTY },	// ExpressionList :
+	{ 24, 1, ACTION_PASS },	// ExpressionList : Expressions
+	{ 25, 1, ACTION_LIST_FIRST },	// Expressions : Expression
+	{ 25, 3, ACTION_LIST_NEXT },	// Expressions : Expressions ',' Expression
+	{ 26, 3, ACTION_BINARY },	// Expression : Expression 'or' And
+	{ 26, 1, ACTION_PASS },	// Expression : And
+	{ 27, 3, ACTION_BINARY },	// And : And 'and' Equality
+	{ 27, 1, ACTION_PASS },	// And : Equality
+	{ 28, 3, ACTION_BINARY },	// Equality : Equality '==' Comparison
+	{ 28, 3, ACTION_BINARY },	// Equality : Equality '<>' Comparison
+	{ 28, 1, ACTION_PASS },	// Equality : Comparison
+	{ 29, 3, ACTION_BINARY },	// Comparison : Comparison '<' Additive
+	{ 29, 3, ACTION_BINARY },	// Comparison : Comparison '<=' Additive
+	{ 29, 3, ACTION_BINARY },	// Comparison : Comparison '>' Additive
+	{ 29, 3, ACTION_BINARY },	// Comparison : Comparison '>=' Additive
+	{ 29, 1, ACTION_PASS },	// Comparison : Additive
+	{ 30, 3, ACTION_BINARY },	// Additive : Additive '+' Multiplicative
+	{ 30, 3, ACTION_BINARY },	// Additive : Additive '-' Multiplicative
+	{ 30, 1, ACTION_PASS },	// Additive : Multiplicative
+	{ 31, 3, ACTION_BINARY },	// Multiplicative : Multiplicative '*' Primary
+	{ 31, 3, ACTION_BINARY },	// Multiplicative : Multiplicative '/' Primary
+	{ 31, 3, ACTION_BINARY },	// Multiplicative : Multiplicative 'mod' Primary
+	{ 31, 1, ACTION_PASS },	// Multiplicative : Primary
+	{ 32, 3, ACTION_PARENTHESES },	// Primary : '(' Expression ')'
+	{ 32, 2, ACTION_UNARY },	// Primary : '~' Primary
+	{ 32, 2, ACTION_UNARY },	// Primary : 'not' Expression
+	{ 32, 1, ACTION_PASS },	// Primary : int
+	{ 32, 1, ACTION_PASS },	// Primary : float
+	{ 32, 1, ACTION_PASS },	// Primary : string
+	{ 32, 1, ACTION_PASS },	// Primary : Variable
+	{ 32, 1, ACTION_PASS },	// Primary : Call
+	{ 32, 1, ACTION_PASS },	// Primary : New
+	{ 32, 1, ACTION_PASS },	// Primary : ArrayValue
+	{ 32, 1, ACTION_PASS },	// Primary : DictValue
+	{ 33, 6, ACTION_NEW_ARRAY },	// New : 'new' 'array' Type '(' ExpressionList ')'
+	{ 33, 6, ACTION_NEW_DICT },	// New : 'new' 'dict' Type Type '(' ')'
+	{ 34, 3, ACTION_ARRAY_VALUE },	// ArrayValue : id Type Indexes
+	{ 35, 3, ACTION_INDEX_FIRST },	// Indexes : '[' Expression ']'
+	{ 35, 4, ACTION_INDEX_NEXT },	// Indexes : Indexes '[' Expression ']'
+	{ 36, 6, ACTION_DICT_VALUE }	// DictValue : id Type Type '(' Expression ')'
+};
+
+// 0 - error, > 0 - shift to that state, < 0 - reduce by rule -value - 1
+static const short LALR_ACTIONS[LALR_STATE_COUNT][LALR_TERMINAL_COUNT] =
+{
+	{-3,-3,0,0,0,-3,-3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 0
+	{-1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 1
+	{-2,3,0,0,0,4,5,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 2
+	{0,0,0,0,10,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 3
+	{0,0,0,0,13,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 4
+	{0,0,0,0,16,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 5
+	{-4,-4,0,0,0,-4,-4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 6
+	{-5,-5,0,0,0,-5,-5,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 7
+	{-7,-7,0,0,0,-7,-7,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 8
+	{-6,-6,0,0,0,-6,-6,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 9
+	{0,0,-9,0,0,0,0,0,22,23,24,25,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 10
+	{0,0,27,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 11
+	{0,0,-10,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 12
+	{0,0,0,0,0,0,0,0,22,23,24,25,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 13
+	{-11,-11,0,0,0,-11,-11,28,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 14
+	{-17,-17,0,-17,0,-17,-17,-17,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 15
+	{0,0,0,0,0,0,0,0,22,23,24,25,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 16
+	{-12,-12,0,0,0,-12,-12,30,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 17
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,31,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 18
+	{-13,-13,0,0,0,-13,-13,-13,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 19
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,32,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 20
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,33,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 21
+	{-22,-22,-22,-22,-22,-22,-22,-22,-22,-22,-22,-22,-22,-22,-22,-22,-22,-22,-22,0,-22,-22,-22,-22,-22,-22,-22,-22,-22,-22,-22,-22,-22,-22,-22,-22,-22,-22,0,0,0,0,0,0,0,0},	// 22
+	{-23,-23,-23,-23,-23,-23,-23,-23,-23,-23,-23,-23,-23,-23,-23,-23,-23,-23,-23,0,-23,-23,-23,-23,-23,-23,-23,-23,-23,-23,-23,-23,-23,-23,-23,-23,-23,-23,0,0,0,0,0,0,0,0},	// 23
+	{-24,-24,-24,-24,-24,-24,-24,-24,-24,-24,-24,-24,-24,-24,-24,-24,-24,-24,-24,0,-24,-24,-24,-24,-24,-24,-24,-24,-24,-24,-24,-24,-24,-24,-24,-24,-24,-24,0,0,0,0,0,0,0,0},	// 24
+	{-25,-25,-25,-25,-25,-25,-25,-25,-25,-25,-25,-25,-25,-25,-25,-25,-25,-25,-25,0,-25,-25,-25,-25,-25,-25,-25,-25,-25,-25,-25,-25,-25,-25,-25,-25,-25,-25,0,0,0,0,0,0,0,0},	// 25
+	{-19,-19,-19,-19,0,-19,-19,-19,22,23,24,25,34,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 26
+	{0,0,0,-15,13,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 27
+	{0,0,0,0,13,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 28
+	{-19,-19,-19,-19,-19,-19,-19,-19,22,23,24,25,40,-19,-19,-19,-19,-19,-19,0,-19,-19,-19,-19,-19,-19,-19,-19,-19,-19,-19,-19,-19,-19,-19,-19,-19,-19,0,0,0,0,0,0,0,0},	// 29
+	{0,0,0,0,16,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 30
+	{0,0,44,0,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 31
+	{0,0,44,0,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 32
+	{0,0,44,0,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 33
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,67,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 34
+	{0,0,68,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 35
+	{-20,-20,-20,-20,-20,-20,-20,-20,0,0,0,0,69,-20,-20,-20,-20,-20,-20,0,-20,-20,-20,-20,-20,-20,-20,-20,-20,-20,-20,-20,-20,-20,-20,-20,-20,-20,0,0,0,0,0,0,0,0},	// 36
+	{0,0,0,70,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 37
+	{0,0,0,-16,0,0,0,28,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 38
+	{-18,-18,0,-18,0,-18,-18,-18,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 39
+	{0,0,44,0,45,0,0,0,0,0,0,0,0,67,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 40
+	{0,0,72,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 41
+	{-86,-86,0,-86,-86,-86,-86,-86,0,0,0,0,73,-86,-86,-86,-86,-86,-86,0,-86,-86,-86,-86,-86,-86,-86,-86,-86,-86,-86,-86,-86,-86,-86,-86,-86,-86,0,0,0,0,0,0,0,0},	// 42
+	{-14,-14,0,0,0,-14,-14,-14,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 43
+	{0,0,44,0,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 44
+	{0,0,-9,0,0,0,0,0,22,23,24,25,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 45
+	{0,0,44,0,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 46
+	{0,0,44,0,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 47
+	{-76,-76,0,-76,-76,-76,-76,-76,0,0,0,0,0,-76,-76,-76,0,-76,-76,0,-76,-76,-76,-76,-76,-76,-76,-76,-76,-76,-76,-76,-76,-76,-76,-76,-76,-76,0,0,0,0,0,0,0,0},	// 48
+	{-77,-77,0,-77,-77,-77,-77,-77,0,0,0,0,0,-77,-77,-77,0,-77,-77,0,-77,-77,-77,-77,-77,-77,-77,-77,-77,-77,-77,-77,-77,-77,-77,-77,-77,-77,0,0,0,0,0,0,0,0},	// 49
+	{-78,-78,0,-78,-78,-78,-78,-78,0,0,0,0,0,-78,-78,-78,0,-78,-78,0,-78,-78,-78,-78,-78,-78,-78,-78,-78,-78,-78,-78,-78,-78,-78,-78,-78,-78,0,0,0,0,0,0,0,0},	// 50
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,77,78},	// 51
+	{0,0,79,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 52
+	{-79,-79,-10,-79,-79,-79,-79,-79,0,0,0,0,0,-79,-79,-79,0,-79,-79,0,-79,-79,-79,-79,-79,-79,-79,-79,-79,-79,-79,-79,-79,-79,-79,-79,-79,-79,0,0,0,0,0,0,0,0},	// 53
+	{-80,-80,0,-80,-80,-80,-80,-80,0,0,0,0,0,-80,-80,-80,0,-80,-80,0,-80,-80,-80,-80,-80,-80,-80,-80,-80,-80,-80,-80,-80,-80,-80,-80,-80,-80,0,0,0,0,0,0,0,0},	// 54
+	{-38,-38,0,0,-38,-38,-38,-38,0,0,0,0,0,0,0,-38,0,-38,-38,0,-38,-38,0,-38,-38,80,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 55
+	{-55,-55,0,-55,-55,-55,-55,-55,0,0,0,0,0,-55,-55,-55,0,-55,-55,0,-55,-55,-55,-55,-55,-55,81,-55,-55,-55,-55,-55,-55,-55,-55,-55,-55,-55,0,0,0,0,0,0,0,0},	// 56
+	{-57,-57,0,-57,-57,-57,-57,-57,0,0,0,0,0,-57,-57,-57,0,-57,-57,0,-57,-57,-57,-57,-57,-57,-57,82,83,-57,-57,-57,-57,-57,-57,-57,-57,-57,0,0,0,0,0,0,0,0},	// 57
+	{-60,-60,0,-60,-60,-60,-60,-60,0,0,0,0,0,-60,-60,-60,0,-60,-60,0,-60,-60,-60,-60,-60,-60,-60,-60,-60,84,85,86,87,-60,-60,-60,-60,-60,0,0,0,0,0,0,0,0},	// 58
+	{-65,-65,0,-65,-65,-65,-65,-65,0,0,0,0,0,-65,-65,-65,0,-65,-65,0,-65,-65,-65,-65,-65,-65,-65,-65,-65,-65,-65,-65,-65,88,89,-65,-65,-65,0,0,0,0,0,0,0,0},	// 59
+	{-68,-68,0,-68,-68,-68,-68,-68,0,0,0,0,0,-68,-68,-68,0,-68,-68,0,-68,-68,-68,-68,-68,-68,-68,-68,-68,-68,-68,-68,-68,-68,-68,90,91,92,0,0,0,0,0,0,0,0},	// 60
+	{-72,-72,0,-72,-72,-72,-72,-72,0,0,0,0,0,-72,-72,-72,0,-72,-72,0,-72,-72,-72,-72,-72,-72,-72,-72,-72,-72,-72,-72,-72,-72,-72,-72,-72,-72,0,0,0,0,0,0,0,0},	// 61
+	{-81,-81,0,-81,-81,-81,-81,-81,0,0,0,0,0,-81,-81,-81,0,-81,-81,0,-81,-81,-81,-81,-81,-81,-81,-81,-81,-81,-81,-81,-81,-81,-81,-81,-81,-81,0,0,0,0,0,0,0,0},	// 62
+	{-82,-82,0,-82,-82,-82,-82,-82,0,0,0,0,0,-82,-82,-82,0,-82,-82,0,-82,-82,-82,-82,-82,-82,-82,-82,-82,-82,-82,-82,-82,-82,-82,-82,-82,-82,0,0,0,0,0,0,0,0},	// 63
+	{-83,-83,0,-83,-83,-83,-83,-83,0,0,0,0,0,-83,-83,-83,0,-83,-83,0,-83,-83,-83,-83,-83,-83,-83,-83,-83,-83,-83,-83,-83,-83,-83,-83,-83,-83,0,0,0,0,0,0,0,0},	// 64
+	{-40,-40,0,0,-40,-40,-40,-40,0,0,0,0,0,0,0,-40,0,-40,-40,0,-40,-40,0,-40,-40,80,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 65
+	{-39,-39,0,0,-39,-39,-39,-39,0,0,0,0,0,0,0,-39,0,-39,-39,0,-39,-39,0,-39,-39,80,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 66
+	{-26,-26,-26,-26,-26,-26,-26,-26,0,0,0,0,-26,-26,-26,-26,-26,-26,-26,0,-26,-26,-26,-26,-26,-26,-26,-26,-26,-26,-26,-26,-26,-26,-26,-26,-26,-26,0,0,0,0,0,0,0,0},	// 67
+	{0,0,0,93,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 68
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,94,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 69
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,95,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 70
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,97,0,0,0,0,0,0,0,0,0,0,0,80,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 71
+	{0,0,44,93,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 72
+	{0,0,44,0,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 73
+	{0,0,0,100,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,80,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 74
+	{-74,-74,0,-74,-74,-74,-74,-74,0,0,0,0,0,-74,-74,-74,0,-74,-74,0,-74,-74,-74,-74,-74,-74,-74,-74,-74,-74,-74,-74,-74,-74,-74,-74,-74,-74,0,0,0,0,0,0,0,0},	// 75
+	{-75,-75,0,-75,-75,-75,-75,-75,0,0,0,0,0,-75,-75,-75,0,-75,-75,0,-75,-75,-75,-75,-75,80,-75,-75,-75,-75,-75,-75,-75,-75,-75,-75,-75,-75,0,0,0,0,0,0,0,0},	// 76
+	{0,0,0,0,0,0,0,0,22,23,24,25,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 77
+	{0,0,0,0,0,0,0,0,22,23,24,25,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 78
+	{0,0,44,-50,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 79
+	{0,0,44,0,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 80
+	{0,0,44,0,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 81
+	{0,0,44,0,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 82
+	{0,0,44,0,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 83
+	{0,0,44,0,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 84
+	{0,0,44,0,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 85
+	{0,0,44,0,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 86
+	{0,0,44,0,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 87
+	{0,0,44,0,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 88
+	{0,0,44,0,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 89
+	{0,0,44,0,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 90
+	{0,0,44,0,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 91
+	{0,0,44,0,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 92
+	{-21,-21,-21,-21,-21,-21,-21,-21,0,0,0,0,0,-21,-21,-21,-21,-21,-21,0,-21,-21,-21,-21,-21,-21,-21,-21,-21,-21,-21,-21,-21,-21,-21,-21,-21,-21,0,0,0,0,0,0,0,0},	// 93
+	{-27,-27,-27,-27,-27,-27,-27,-27,0,0,0,0,-27,-27,-27,-27,-27,-27,-27,0,-27,-27,-27,-27,-27,-27,-27,-27,-27,-27,-27,-27,-27,-27,-27,-27,-27,-27,0,0,0,0,0,0,0,0},	// 94
+	{0,0,0,0,-29,0,0,0,0,0,0,0,0,0,0,-29,0,-29,-29,0,-29,0,0,-29,-29,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 95
+	{-8,-8,0,0,0,-8,-8,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 96
+	{-87,-87,0,-87,-87,-87,-87,-87,0,0,0,0,-87,-87,-87,-87,-87,-87,-87,0,-87,-87,-87,-87,-87,-87,-87,-87,-87,-87,-87,-87,-87,-87,-87,-87,-87,-87,0,0,0,0,0,0,0,0},	// 97
+	{0,0,0,120,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,80,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 98
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,121,0,0,0,0,0,0,0,0,0,0,0,80,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 99
+	{-73,-73,0,-73,-73,-73,-73,-73,0,0,0,0,0,-73,-73,-73,0,-73,-73,0,-73,-73,-73,-73,-73,-73,-73,-73,-73,-73,-73,-73,-73,-73,-73,-73,-73,-73,0,0,0,0,0,0,0,0},	// 100
+	{0,0,122,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 101
+	{0,0,0,0,0,0,0,0,22,23,24,25,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 102
+	{0,0,0,124,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 103
+	{0,0,0,-51,0,0,0,125,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 104
+	{0,0,0,-52,0,0,0,-52,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,80,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 105
+	{-54,-54,0,-54,-54,-54,-54,-54,0,0,0,0,0,-54,-54,-54,0,-54,-54,0,-54,-54,-54,-54,-54,-54,81,-54,-54,-54,-54,-54,-54,-54,-54,-54,-54,-54,0,0,0,0,0,0,0,0},	// 106
+	{-56,-56,0,-56,-56,-56,-56,-56,0,0,0,0,0,-56,-56,-56,0,-56,-56,0,-56,-56,-56,-56,-56,-56,-56,82,83,-56,-56,-56,-56,-56,-56,-56,-56,-56,0,0,0,0,0,0,0,0},	// 107
+	{-58,-58,0,-58,-58,-58,-58,-58,0,0,0,0,0,-58,-58,-58,0,-58,-58,0,-58,-58,-58,-58,-58,-58,-58,-58,-58,84,85,86,87,-58,-58,-58,-58,-58,0,0,0,0,0,0,0,0},	// 108
+	{-59,-59,0,-59,-59,-59,-59,-59,0,0,0,0,0,-59,-59,-59,0,-59,-59,0,-59,-59,-59,-59,-59,-59,-59,-59,-59,84,85,86,87,-59,-59,-59,-59,-59,0,0,0,0,0,0,0,0},	// 109
+	{-61,-61,0,-61,-61,-61,-61,-61,0,0,0,0,0,-61,-61,-61,0,-61,-61,0,-61,-61,-61,-61,-61,-61,-61,-61,-61,-61,-61,-61,-61,88,89,-61,-61,-61,0,0,0,0,0,0,0,0},	// 110
+	{-62,-62,0,-62,-62,-62,-62,-62,0,0,0,0,0,-62,-62,-62,0,-62,-62,0,-62,-62,-62,-62,-62,-62,-62,-62,-62,-62,-62,-62,-62,88,89,-62,-62,-62,0,0,0,0,0,0,0,0},	// 111
+	{-63,-63,0,-63,-63,-63,-63,-63,0,0,0,0,0,-63,-63,-63,0,-63,-63,0,-63,-63,-63,-63,-63,-63,-63,-63,-63,-63,-63,-63,-63,88,89,-63,-63,-63,0,0,0,0,0,0,0,0},	// 112
+	{-64,-64,0,-64,-64,-64,-64,-64,0,0,0,0,0,-64,-64,-64,0,-64,-64,0,-64,-64,-64,-64,-64,-64,-64,-64,-64,-64,-64,-64,-64,88,89,-64,-64,-64,0,0,0,0,0,0,0,0},	// 113
+	{-66,-66,0,-66,-66,-66,-66,-66,0,0,0,0,0,-66,-66,-66,0,-66,-66,0,-66,-66,-66,-66,-66,-66,-66,-66,-66,-66,-66,-66,-66,-66,-66,90,91,92,0,0,0,0,0,0,0,0},	// 114
+	{-67,-67,0,-67,-67,-67,-67,-67,0,0,0,0,0,-67,-67,-67,0,-67,-67,0,-67,-67,-67,-67,-67,-67,-67,-67,-67,-67,-67,-67,-67,-67,-67,90,91,92,0,0,0,0,0,0,0,0},	// 115
+	{-69,-69,0,-69,-69,-69,-69,-69,0,0,0,0,0,-69,-69,-69,0,-69,-69,0,-69,-69,-69,-69,-69,-69,-69,-69,-69,-69,-69,-69,-69,-69,-69,-69,-69,-69,0,0,0,0,0,0,0,0},	// 116
+	{-70,-70,0,-70,-70,-70,-70,-70,0,0,0,0,0,-70,-70,-70,0,-70,-70,0,-70,-70,-70,-70,-70,-70,-70,-70,-70,-70,-70,-70,-70,-70,-70,-70,-70,-70,0,0,0,0,0,0,0,0},	// 117
+	{-71,-71,0,-71,-71,-71,-71,-71,0,0,0,0,0,-71,-71,-71,0,-71,-71,0,-71,-71,-71,-71,-71,-71,-71,-71,-71,-71,-71,-71,-71,-71,-71,-71,-71,-71,0,0,0,0,0,0,0,0},	// 118
+	{0,0,0,0,45,0,0,0,0,0,0,0,0,0,0,126,0,127,128,0,129,0,0,130,131,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 119
+	{-89,-89,0,-89,-89,-89,-89,-89,0,0,0,0,0,-89,-89,-89,-89,-89,-89,0,-89,-89,-89,-89,-89,-89,-89,-89,-89,-89,-89,-89,-89,-89,-89,-89,-89,-89,0,0,0,0,0,0,0,0},	// 120
+	{-88,-88,0,-88,-88,-88,-88,-88,0,0,0,0,-88,-88,-88,-88,-88,-88,-88,0,-88,-88,-88,-88,-88,-88,-88,-88,-88,-88,-88,-88,-88,-88,-88,-88,-88,-88,0,0,0,0,0,0,0,0},	// 121
+	{0,0,44,-50,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 122
+	{0,0,142,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 123
+	{-49,-49,0,-49,-49,-49,-49,-49,0,0,0,0,0,-49,-49,-49,0,-49,-49,0,-49,-49,-49,-49,-49,-49,-49,-49,-49,-49,-49,-49,-49,-49,-49,-49,-49,-49,0,0,0,0,0,0,0,0},	// 124
+	{0,0,44,0,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 125
+	{-28,-28,0,0,-28,-28,-28,0,0,0,0,0,0,0,0,-28,0,-28,-28,-28,-28,0,0,-28,-28,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 126
+	{0,0,44,0,45,0,0,0,0,0,0,0,0,0,0,-41,0,-41,-41,0,-41,0,0,-41,-41,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 127
+	{0,0,44,0,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 128
+	{0,0,0,0,16,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 129
+	{0,0,44,0,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 130
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,95,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 131
+	{0,0,-10,0,0,0,0,0,0,0,0,0,0,0,0,0,31,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 132
+	{0,0,0,0,-30,0,0,0,0,0,0,0,0,0,0,-30,0,-30,-30,0,-30,0,0,-30,-30,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 133
+	{0,0,0,0,-31,0,0,0,0,0,0,0,0,0,0,-31,0,-31,-31,0,-31,0,0,-31,-31,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 134
+	{0,0,0,0,-32,0,0,0,0,0,0,0,0,0,0,-32,0,-32,-32,0,-32,0,0,-32,-32,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 135
+	{0,0,0,0,-33,0,0,0,0,0,0,0,0,0,0,-33,0,-33,-33,0,-33,0,0,-33,-33,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 136
+	{0,0,0,0,-34,0,0,0,0,0,0,0,0,0,0,-34,0,-34,-34,0,-34,0,0,-34,-34,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 137
+	{0,0,0,0,-35,0,0,0,0,0,0,0,0,0,0,-35,0,-35,-35,0,-35,0,0,-35,-35,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 138
+	{0,0,0,0,-36,0,0,0,0,0,0,0,0,0,0,-36,0,-36,-36,0,-36,0,0,-36,-36,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 139
+	{0,0,0,0,-37,0,0,0,0,0,0,0,0,0,0,-37,0,-37,-37,0,-37,0,0,-37,-37,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 140
+	{0,0,0,149,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 141
+	{0,0,0,150,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 142
+	{0,0,0,-53,0,0,0,-53,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,80,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 143
+	{0,0,0,0,-42,0,0,0,0,0,0,0,0,0,0,-42,0,-42,-42,0,-42,0,0,-42,-42,80,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 144
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,95,0,0,0,0,0,0,0,0,0,0,80,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 145
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,152,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 146
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,95,0,0,0,0,0,0,0,0,0,0,80,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 147
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,154,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 148
+	{-84,-84,0,-84,-84,-84,-84,-84,0,0,0,0,0,-84,-84,-84,0,-84,-84,0,-84,-84,-84,-84,-84,-84,-84,-84,-84,-84,-84,-84,-84,-84,-84,-84,-84,-84,0,0,0,0,0,0,0,0},	// 149
+	{-85,-85,0,-85,-85,-85,-85,-85,0,0,0,0,0,-85,-85,-85,0,-85,-85,0,-85,-85,-85,-85,-85,-85,-85,-85,-85,-85,-85,-85,-85,-85,-85,-85,-85,-85,0,0,0,0,0,0,0,0},	// 150
+	{0,0,0,0,-43,0,0,0,0,0,0,0,0,0,0,-43,0,-43,-43,155,-43,0,0,-43,-43,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 151
+	{0,0,44,0,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 152
+	{0,0,0,0,-47,0,0,0,0,0,0,0,0,0,0,-47,0,-47,-47,0,-47,0,0,-47,-47,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 153
+	{0,0,44,0,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 154
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,95,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 155
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,95,0,0,0,0,0,0,0,159,0,0,80,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 156
+	{0,0,0,0,-48,0,0,0,0,0,0,0,0,0,0,-48,0,-48,-48,0,-48,0,0,-48,-48,80,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 157
+	{0,0,0,0,-44,0,0,0,0,0,0,0,0,0,0,-44,0,-44,-44,0,-44,0,0,-44,-44,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 158
+	{0,0,44,0,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,48,49,50,51,0,0},	// 159
+	{0,0,0,0,-45,0,0,0,0,0,0,0,0,0,0,-45,0,-45,-45,0,-45,0,0,-45,-45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 160
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,95,0,0,0,0,0,0,0,0,0,0,80,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 161
+	{0,0,0,0,-46,0,0,0,0,0,0,0,0,0,0,-46,0,-46,-46,0,-46,0,0,-46,-46,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0}	// 162
+};
+
+// State after a nonterminal is reduced
+static const short LALR_GOTOS[LALR_STATE_COUNT][LALR_NONTERMINAL_COUNT] =
+{
+	{0,1,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 0
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 1
+	{0,0,0,6,7,0,8,9,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 2
+	{0,0,0,0,0,11,0,0,0,0,0,12,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 3
+	{0,0,0,0,0,0,0,0,0,0,14,15,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 4
+	{0,0,0,0,0,0,0,0,17,0,0,18,0,0,0,0,0,19,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,21},	// 5
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 6
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 7
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 8
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 9
+	{0,0,0,0,0,0,0,0,0,0,0,0,26,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 10
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 11
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 12
+	{0,0,0,0,0,0,0,0,0,0,0,0,26,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 13
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 14
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 15
+	{0,0,0,0,0,0,0,0,0,0,0,0,29,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 16
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 17
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 18
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 19
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 20
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 21
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 22
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 23
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 24
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 25
+	{0,0,0,0,0,0,0,0,0,0,0,0,35,36,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 26
+	{0,0,0,0,0,0,0,0,0,37,38,15,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 27
+	{0,0,0,0,0,0,0,0,0,0,0,39,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 28
+	{0,0,0,0,0,0,0,0,0,0,0,0,41,36,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,42,0},	// 29
+	{0,0,0,0,0,0,0,0,0,0,0,18,0,0,0,0,0,43,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,21},	// 30
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,55,56,57,58,59,60,61,62,63,0,64},	// 31
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,65,56,57,58,59,60,61,62,63,0,64},	// 32
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,66,56,57,58,59,60,61,62,63,0,64},	// 33
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 34
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 35
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 36
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 37
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 38
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 39
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,71,56,57,58,59,60,61,62,63,0,64},	// 40
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 41
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 42
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 43
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,74,56,57,58,59,60,61,62,63,0,64},	// 44
+	{0,0,0,0,0,0,0,0,0,0,0,0,29,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 45
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,0,0,0,0,0,0,75,62,63,0,64},	// 46
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,76,56,57,58,59,60,61,62,63,0,64},	// 47
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 48
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 49
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 50
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 51
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 52
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 53
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 54
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 55
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 56
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 57
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 58
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 59
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 60
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 61
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 62
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 63
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 64
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 65
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 66
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 67
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 68
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 69
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,96,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 70
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 71
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,98,56,57,58,59,60,61,62,63,0,64},	// 72
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,99,56,57,58,59,60,61,62,63,0,64},	// 73
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 74
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 75
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 76
+	{0,0,0,0,0,0,0,0,0,0,0,0,101,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 77
+	{0,0,0,0,0,0,0,0,0,0,0,0,102,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 78
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,103,104,105,56,57,58,59,60,61,62,63,0,64},	// 79
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,0,106,57,58,59,60,61,62,63,0,64},	// 80
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,0,0,107,58,59,60,61,62,63,0,64},	// 81
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,0,0,0,108,59,60,61,62,63,0,64},	// 82
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,0,0,0,109,59,60,61,62,63,0,64},	// 83
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,0,0,0,0,110,60,61,62,63,0,64},	// 84
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,0,0,0,0,111,60,61,62,63,0,64},	// 85
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,0,0,0,0,112,60,61,62,63,0,64},	// 86
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,0,0,0,0,113,60,61,62,63,0,64},	// 87
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,0,0,0,0,0,114,61,62,63,0,64},	// 88
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,0,0,0,0,0,115,61,62,63,0,64},	// 89
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,0,0,0,0,0,0,116,62,63,0,64},	// 90
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,0,0,0,0,0,0,117,62,63,0,64},	// 91
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,0,0,0,0,0,0,118,62,63,0,64},	// 92
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 93
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 94
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,119,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 95
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 96
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 97
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 98
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 99
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 100
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 101
+	{0,0,0,0,0,0,0,0,0,0,0,0,123,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 102
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 103
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 104
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 105
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 106
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 107
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 108
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 109
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 110
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 111
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 112
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 113
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 114
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 115
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 116
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 117
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 118
+	{0,0,0,0,0,52,0,0,0,0,0,132,0,0,0,0,133,134,135,136,137,138,139,140,0,0,0,0,0,0,0,0,0,0,20,0,21},	// 119
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 120
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 121
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,141,104,105,56,57,58,59,60,61,62,63,0,64},	// 122
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 123
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 124
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,143,56,57,58,59,60,61,62,63,0,64},	// 125
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 126
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,144,56,57,58,59,60,61,62,63,0,64},	// 127
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,145,56,57,58,59,60,61,62,63,0,64},	// 128
+	{0,0,0,0,0,0,0,0,0,0,0,18,0,0,0,0,0,146,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,21},	// 129
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,147,56,57,58,59,60,61,62,63,0,64},	// 130
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,148,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 131
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 132
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 133
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 134
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 135
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 136
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 137
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 138
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 139
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 140
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 141
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 142
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 143
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 144
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,151,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 145
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 146
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,153,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 147
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 148
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 149
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 150
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 151
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,156,56,57,58,59,60,61,62,63,0,64},	// 152
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 153
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,157,56,57,58,59,60,61,62,63,0,64},	// 154
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,158,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 155
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,160,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 156
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 157
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 158
+	{0,0,0,0,0,52,0,0,0,0,0,53,0,0,0,0,0,0,0,0,0,0,0,54,0,0,161,56,57,58,59,60,61,62,63,0,64},	// 159
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 160
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,162,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// 161
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0}	// 162
+};
+
@@ -75,15 +75,15 @@ enum class NSymbol
 
 TSymbol Lex(TokenStream &tk)
 {
-	const Token &t = tk.Current();
+	TOKEN_TYPE type = tk.CurrentType();
 
-	if (t.GetType() == TOKEN_ID)
+	if (type == TOKEN_ID)
 	{
 		return TSymbol::T_ID;
 	}
-	else if (t.GetType() == TOKEN_KEYWORD || t.GetType() == TOKEN_DELIMETER)
+	else if (type == TOKEN_KEYWORD || type == TOKEN_DELIMETER)
 	{
-		switch (t.GetValueK())
+		switch (tk.CurrentKeyword())
 		{
 		case KW_NEW:
 			return TSymbol::T_NEW;
@@ -109,7 +109,7 @@ TSymbol Lex(TokenStream &tk)
 			return TSymbol::T_INDEX_R;
 		}
 	}
-	else if (t.GetType() == TOKEN_EOF)
+	else if (type == TOKEN_EOF)
 	{
 		return TSymbol::T_END;
 	}
@@ -117,7 +117,7 @@ TSymbol Lex(TokenStream &tk)
 	return TSymbol::T_INVALID;
 }
 
-shared_ptr<IAst> LLParseNew(TokenStream &tk)
+IAst *LLParseNew(TokenStream &tk)
 {
 	tk.PushPosition();
 
@@ -3,4 +3,4 @@
 #include "Ast.h"
 #include "TokenStream.h"
 
-std::shared_ptr<IAst> LLParseNew(TokenStream &tk);
+IAst *LLParseNew(TokenStream &tk);
@@ -1,96 +1,88 @@
+#include <algorithm>
 #include "LR.h"
 #include "Parser.h"
 #include "IAst.h"
 
 /**/
-VarDeclLR::VarDeclLR()
-	: m_index(0)
+const VarDeclLR::Table VarDeclLR::TABLE;
+
+VarDeclLR::Table::Table()
 {
+	for (auto &actions : m_actions)
 	{
-		std::map<TOKEN, PARSEFN> m;
-		m[TOKEN::VarDecl] = &Confirm;
-		m[TOKEN::id] = &ID11;
-		m_table[STATEMENT::BEGIN] = m;
-	}
-	{
-		std::map<TOKEN, PARSEFN> m;
-		m[TOKEN::VarType] = &VarType12;
-		m[TOKEN::AtomicType] = &AT21AT31AT71;
-		m[TOKEN::DictType] = &DT31;
-		m[TOKEN::ArrType] = &ArT41;
-		m[TOKEN::TypeInt] = &SimpleType;
-		m[TOKEN::TypeBool] = &SimpleType;
-		m[TOKEN::TypeDouble] = &SimpleType;
-		m[TOKEN::TypeStr] = &SimpleType;
-		m_table[STATEMENT::ID11] = m;
-	}
-	{
-		std::map<TOKEN, PARSEFN> m;
-		m[TOKEN::EOLN] = &Reduce1;
-		m_table[STATEMENT::VT12] = m;
-	}
-	{
-		std::map<TOKEN, PARSEFN> m;
-		m[TOKEN::AtomicType] = &AT62;
-		m[TOKEN::DimDecl] = &DimD72;
-		m[TOKEN::indexL] = &RSB81RSB91;
-		m[TOKEN::EOLN] = &Reduce2;
-		m_table[STATEMENT::AT21AT61AT71] = m;
-	}
-	{
-		std::map<TOKEN, PARSEFN> m;
-		m[TOKEN::EOLN] = &Reduce3;
-		m_table[STATEMENT::DT31] = m;
-	}
-	{
-		std::map<TOKEN, PARSEFN> m;
-		m[TOKEN::EOLN] = &Reduce4;
-		m_table[STATEMENT::ArT41] = m;
-	}
-	{
-		std::map<TOKEN, PARSEFN> m;
-		m[TOKEN::AtomicType] = &Reduce5;
-		m[TOKEN::BraceR] = &Reduce5;
-		m[TOKEN::DimDecl] = &Reduce5;
-		m[TOKEN::EOLN] = &Reduce5;
-		m_table[STATEMENT::Type51] = m;
-	}
-	{
-		std::map<TOKEN, PARSEFN> m;
-		m[TOKEN::BraceR] = &Br63;
-		m_table[STATEMENT::AT62] = m;
-	}
-	{
-		std::map<TOKEN, PARSEFN> m;
-		m[TOKEN::EOLN] = &Reduce7;
-		m_table[STATEMENT::DimD72] = m;
-	}
-	{
-		std::map<TOKEN, PARSEFN> m;
-		m[TOKEN::indexR] = &LSB82LSB92;
-		m_table[STATEMENT::RSB81RSB91] = m;
-	}
-	{
-		std::map<TOKEN, PARSEFN> m;
-		m[TOKEN::BraceR] = &Br64;
-		m_table[STATEMENT::Br63] = m;
-	}
-	{
-		std::map<TOKEN, PARSEFN> m;
-		m[TOKEN::DimDecl] = &DimD82;
-		m[TOKEN::EOLN] = &Reduce9;
-		m_table[STATEMENT::LSB82LSB92] = m;
-	}
-	{
-		std::map<TOKEN, PARSEFN> m;
-		m[TOKEN::EOLN] = &Reduce6;
-		m_table[STATEMENT::Br64] = m;
-	}
-	{
-		std::map<TOKEN, PARSEFN> m;
-		m[TOKEN::EOLN] = &Reduce8;
-		m_table[STATEMENT::DimD82] = m;
+		std::fill(actions, actions + TOKEN_COUNT, nullptr);
 	}
+
+	Set(STATEMENT::BEGIN, TOKEN::VarDecl, &Confirm);
+	Set(STATEMENT::BEGIN, TOKEN::id, &ID11);
+
+	Set(STATEMENT::ID11, TOKEN::VarType, &VarType12);
+	Set(STATEMENT::ID11, TOKEN::AtomicType, &AT21AT31AT71);
+	Set(STATEMENT::ID11, TOKEN::DictType, &DT31);
+	Set(STATEMENT::ID11, TOKEN::ArrType, &ArT41);
+	Set(STATEMENT::ID11, TOKEN::TypeInt, &SimpleType);
+	Set(STATEMENT::ID11, TOKEN::TypeBool, &SimpleType);
+	Set(STATEMENT::ID11, TOKEN::TypeDouble, &SimpleType);
+	Set(STATEMENT::ID11, TOKEN::TypeStr, &SimpleType);
+
+	Set(STATEMENT::VT12, TOKEN::EOLN, &Reduce1);
+
+	Set(STATEMENT::AT21AT61AT71, TOKEN::AtomicType, &AT62);
+	Set(STATEMENT::AT21AT61AT71, TOKEN::DimDecl, &DimD72);
+	Set(STATEMENT::AT21AT61AT71, TOKEN::indexL, &RSB81RSB91);
+	Set(STATEMENT::AT21AT61AT71, TOKEN::EOLN, &Reduce2);
+
+	Set(STATEMENT::DT31, TOKEN::EOLN, &Reduce3);
+
+	Set(STATEMENT::ArT41, TOKEN::EOLN, &Reduce4);
+
+	Set(STATEMENT::Type51, TOKEN::AtomicType, &Reduce5);
+	Set(STATEMENT::Type51, TOKEN::BraceR, &Reduce5);
+	Set(STATEMENT::Type51, TOKEN::DimDecl, &Reduce5);
+	Set(STATEMENT::Type51, TOKEN::EOLN, &Reduce5);
+
+	Set(STATEMENT::AT62, TOKEN::BraceR, &Br63);
+
+	Set(STATEMENT::DimD72, TOKEN::EOLN, &Reduce7);
+
+	Set(STATEMENT::RSB81RSB91, TOKEN::indexR, &LSB82LSB92);
+
+	Set(STATEMENT::Br63, TOKEN::BraceR, &Br64);
+
+	Set(STATEMENT::LSB82LSB92, TOKEN::DimDecl, &DimD82);
+	Set(STATEMENT::LSB82LSB92, TOKEN::EOLN, &Reduce9);
+
+	Set(STATEMENT::Br64, TOKEN::EOLN, &Reduce6);
+
+	Set(STATEMENT::DimD82, TOKEN::EOLN, &Reduce8);
+}
+
+PARSEFN VarDeclLR::Table::Find(STATEMENT state, TOKEN symbol) const
+{
+	return m_actions[static_cast<size_t>(state)][static_cast<size_t>(symbol)];
+}
+
+void VarDeclLR::Table::Set(STATEMENT state, TOKEN symbol, PARSEFN action)
+{
+	m_actions[static_cast<size_t>(state)][static_cast<size_t>(symbol)] = action;
+}
+
+// Stacks of a parser start with this capacity, which is enough
+// for the declarations of the arrays with up to 4 dimensions
+static const size_t STACK_RESERVE = 16;
+
+template<class T> std::stack<T, std::vector<T>> MakeStack()
+{
+	std::vector<T> items;
+	items.reserve(STACK_RESERVE);
+	return std::stack<T, std::vector<T>>(std::move(items));
+}
+
+VarDeclLR::VarDeclLR()
+	: m_ss(MakeStack<STATEMENT>())
+	, m_st(MakeStack<TOKEN>())
+	, m_index(0)
+{
 	m_ss.push(STATEMENT::BEGIN);
 }
 
@@ -303,25 +295,27 @@ bool VarDeclLR::Parse(const std::vector<TOKEN> &arg, size_t num)
 	bool res = false;
 	do
 	{
-		auto it = m_table[m_ss.top()].find(arg[m_index]);
-		notEx = it == m_table[m_ss.top()].end();
+		PARSEFN action = TABLE.Find(m_ss.top(), arg[m_index]);
+		notEx = action == nullptr;
 		if (!notEx)
 		{
-			res = m_table[m_ss.top()][arg[m_index]](*this);
+			res = action(*this);
 		}
 	} while (!notEx && !res);
 	return res;
 }
 
-TOKEN Lex(const Token &t)
+TOKEN Lex(const TokenStream &tk)
 {
-	if (t.GetType() == TOKEN_ID)
+	TOKEN_TYPE type = tk.CurrentType();
+
+	if (type == TOKEN_ID)
 	{
 		return TOKEN::id;
 	}
-	else if (t.GetType() == TOKEN_KEYWORD || t.GetType() == TOKEN_DELIMETER)
+	else if (type == TOKEN_KEYWORD || type == TOKEN_DELIMETER)
 	{
-		switch (t.GetValueK())
+		switch (tk.CurrentKeyword())
 		{
 		case KW_BRACE_L:
 			return TOKEN::BraceL;
@@ -345,17 +339,20 @@ TOKEN Lex(const Token &t)
 	return TOKEN::EOLN;
 }
 
-std::shared_ptr<IAst> ParseVariableLR(TokenStream &tk)
+IAst *ParseVariableLR(TokenStream &tk)
 {
 	tk.PushPosition();
 
+	// Declarations are short, so the tokens fit in one allocation
 	std::vector<TOKEN> tokens;
+	tokens.reserve(STACK_RESERVE);
 
-	while (!tk.IsEOS())
+	// EOLN is never shifted, so the parser doesn't look past it
+	do
 	{
-		tokens.push_back(Lex(tk.Current()));
+		tokens.push_back(Lex(tk));
 		tk.Forward();
-	}
+	} while (tokens.back() != TOKEN::EOLN);
 
 	VarDeclLR parser;
 	auto res = parser.Parse(tokens, 0);
@@ -7,7 +7,7 @@
 #include "Ast.h"
 #include "TokenStream.h"
 
-std::shared_ptr<IAst> ParseVariableLR(TokenStream &tk);
+IAst *ParseVariableLR(TokenStream &tk);
 
 /*
 VarDecl -> id VarType
@@ -91,8 +91,28 @@ private:
 	static bool Br64(VarDeclLR &c);
 	static bool DimD82(VarDeclLR &c);
 
-	std::stack<STATEMENT> m_ss;
-	std::stack<TOKEN> m_st;
+	static const size_t STATEMENT_COUNT = static_cast<size_t>(STATEMENT::DimD82) + 1;
+	static const size_t TOKEN_COUNT = static_cast<size_t>(TOKEN::EOLN) + 1;
+
+	// Actions of the states for the symbols, made once for all the parsers
+	// (a parser is made for every variable, so it must be cheap to make)
+	class Table
+	{
+	public:
+		Table();
+
+		// Returns null if the state has no action for the symbol
+		PARSEFN Find(STATEMENT state, TOKEN symbol) const;
+
+	private:
+		PARSEFN m_actions[STATEMENT_COUNT][TOKEN_COUNT];
+
+		void Set(STATEMENT state, TOKEN symbol, PARSEFN action);
+	};
+
+	static const Table TABLE;
+
+	std::stack<STATEMENT, std::vector<STATEMENT>> m_ss;
+	std::stack<TOKEN, std::vector<TOKEN>> m_st;
 	size_t m_index;
-	std::map<STATEMENT, std::map<TOKEN, PARSEFN>> m_table;
 };
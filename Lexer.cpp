@@ -1,226 +1,491 @@
 #include <assert.h>
 #include <iostream>
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <memory>
+#include <algorithm>
 #include "Lexer.h"
 #include "Exception.h"
+#include "CharScanner.h"
 
 using namespace std;
 
-// These should be in Lexer's privates, but I get
-// an unresolved external if I put them there
-std::map<std::string, KEYWORD> m_tokens;
-std::set<std::string> m_delim;
-
-string Lexer::StripComments(const string &line)
+namespace
 {
-	bool isInsideString = false;
+	// Character classes of the scanner, every delimiter
+	// character gets a class of its own
+	enum CHAR_CLASS
+	{
+		CLASS_OTHER,
+		CLASS_LETTER,
+		CLASS_DIGIT,
+		CLASS_DOT,
+		CLASS_QUOTE,
+		CLASS_FIRST_DELIMETER
+	};
 
-	for (unsigned int i = 0; i < line.size(); i++)
+	enum STATE
 	{
-		char ch = line[i];
+		STATE_START,
+		STATE_ID,
+		STATE_INT,
+		// Digits followed by a dot, a float if a digit follows
+		STATE_INT_DOT,
+		STATE_FLOAT,
+		STATE_STRING,
+		STATE_STRING_END,
+		STATE_FIRST_DELIMETER,
+		// No transition
+		STATE_NONE = 0xFF
+	};
+
+	// Run of characters a state loops over, skipped with CharScanner
+	enum RUN
+	{
+		RUN_NONE,
+		RUN_IDENTIFIER,
+		RUN_DIGITS,
+		RUN_STRING
+	};
+
+	// What token a state of the scanner stops with
+	enum ACCEPT
+	{
+		ACCEPT_NONE,
+		ACCEPT_ID,
+		ACCEPT_INT,
+		// Int followed by a dot, the dot is left for the next token
+		ACCEPT_INT_DOT,
+		ACCEPT_FLOAT,
+		ACCEPT_STRING,
+		ACCEPT_UNCLOSED_STRING,
+		ACCEPT_DELIMETER
+	};
+
+	const unsigned MAX_CLASSES = 32;
+	const unsigned MAX_STATES = 64;
+	// Size of the keyword hash table, must be a power of two
+	const unsigned KEYWORD_HASH_SIZE = 64;
+
+	// Transition tables of the scanner DFA and perfect hash of the keywords,
+	// built from the keyword spellings in Token.h
+	// - Tables are built once during static initialization
+	// and are read only afterwards
+	class ScannerTables
+	{
+	public:
+		ScannerTables();
+
+		unsigned char charClass[256];
+		unsigned char next[MAX_STATES][MAX_CLASSES];
+		unsigned char accept[MAX_STATES];
+		unsigned char run[MAX_STATES];
+		KEYWORD delimeter[MAX_STATES];
 
-		if (ch == '"')
+		// Returns keyword spelled as text (case insensitive) or -1
+		int FindKeyword(const char *text, size_t length) const;
+
+	private:
+		signed char m_keywordSlots[KEYWORD_HASH_SIZE];
+		unsigned m_keywordSeed;
+
+		unsigned KeywordHash(const char *text, size_t length, unsigned seed) const;
+		bool BuildKeywordHash(unsigned seed);
+	};
+
+	ScannerTables::ScannerTables()
+	{
+		memset(charClass, CLASS_OTHER, sizeof(charClass));
+		memset(next, STATE_NONE, sizeof(next));
+		memset(accept, ACCEPT_NONE, sizeof(accept));
+		memset(run, RUN_NONE, sizeof(run));
+
+		for (int ch = 'a'; ch <= 'z'; ch++)
 		{
-			isInsideString = !isInsideString;
+			charClass[ch] = CLASS_LETTER;
+			charClass[toupper(ch)] = CLASS_LETTER;
 		}
-		else if (ch == '`' && !isInsideString)
+		charClass['_'] = CLASS_LETTER;
+		for (int ch = '0'; ch <= '9'; ch++)
 		{
-			return line.substr(0, i);
+			charClass[ch] = CLASS_DIGIT;
 		}
-	}
+		charClass['.'] = CLASS_DOT;
+		charClass['"'] = CLASS_QUOTE;
+
+		// id: [a-z_][a-z0-9_]*
+		next[STATE_START][CLASS_LETTER] = STATE_ID;
+		next[STATE_ID][CLASS_LETTER] = STATE_ID;
+		next[STATE_ID][CLASS_DIGIT] = STATE_ID;
+		accept[STATE_ID] = ACCEPT_ID;
+		run[STATE_ID] = RUN_IDENTIFIER;
+
+		// int: ~?[0-9]+, float: ~?[0-9]+.[0-9]+
+		next[STATE_START][CLASS_DIGIT] = STATE_INT;
+		next[STATE_INT][CLASS_DIGIT] = STATE_INT;
+		next[STATE_INT][CLASS_DOT] = STATE_INT_DOT;
+		next[STATE_INT_DOT][CLASS_DIGIT] = STATE_FLOAT;
+		next[STATE_FLOAT][CLASS_DIGIT] = STATE_FLOAT;
+		accept[STATE_INT] = ACCEPT_INT;
+		accept[STATE_INT_DOT] = ACCEPT_INT_DOT;
+		accept[STATE_FLOAT] = ACCEPT_FLOAT;
+		run[STATE_INT] = RUN_DIGITS;
+		run[STATE_FLOAT] = RUN_DIGITS;
+
+		// string: "[^"]*"
+		next[STATE_START][CLASS_QUOTE] = STATE_STRING;
+		accept[STATE_STRING] = ACCEPT_UNCLOSED_STRING;
+		accept[STATE_STRING_END] = ACCEPT_STRING;
+		run[STATE_STRING] = RUN_STRING;
+
+		// Delimiters: a state for every prefix of their spellings
+		unsigned classCount = CLASS_FIRST_DELIMETER;
+		unsigned stateCount = STATE_FIRST_DELIMETER;
+		for (unsigned kw = 0; kw < KEYWORD_COUNT; kw++)
+		{
+			const char *spelling = KEYWORD_SPELLING[kw];
+			if (charClass[static_cast<unsigned char>(*spelling)] == CLASS_LETTER)
+			{
+				continue;
+			}
 
-	return line;
-}
+			unsigned state = STATE_START;
+			for (const char *ch = spelling; *ch; ch++)
+			{
+				unsigned char &cls = charClass[static_cast<unsigned char>(*ch)];
+				if (cls == CLASS_OTHER)
+				{
+					assert(classCount < MAX_CLASSES);
+					cls = classCount++;
+				}
 
-string Lexer::GetUInt(InputStream &is)
-{
-	string result;
+				if (next[state][cls] == STATE_NONE)
+				{
+					assert(stateCount < MAX_STATES);
+					next[state][cls] = stateCount++;
+				}
+				state = next[state][cls];
+			}
 
-	int ch = is.GetChar();
-	while (ch >= '0' && ch <= '9')
-	{
-		result += ch;
-		is.Forward();
-		ch = is.GetChar();
-	}
+			accept[state] = ACCEPT_DELIMETER;
+			delimeter[state] = static_cast<KEYWORD>(kw);
+		}
 
-	return result;
-}
+		// Inside of a string everything but the quote is allowed
+		for (unsigned cls = 0; cls < classCount; cls++)
+		{
+			next[STATE_STRING][cls] = STATE_STRING;
+		}
+		next[STATE_STRING][CLASS_QUOTE] = STATE_STRING_END;
 
-string Lexer::GetInt(InputStream &is)
-{
-	string result;
+		// '~' directly followed by a digit is a negative number
+		unsigned minus = next[STATE_START][charClass['~']];
+		next[minus][CLASS_DIGIT] = STATE_INT;
 
-	is.PushPosition();
-	if (is.GetChar() == '~')
-	{
-		result += "-";
-		is.Forward();
+		// Look for a seed that gives no collisions
+		for (m_keywordSeed = 1; !BuildKeywordHash(m_keywordSeed); m_keywordSeed++)
+		{
+			assert(m_keywordSeed < 10000);
+		}
 	}
 
-	result += GetUInt(is);
-
-	if (result == "-" || result.size() == 0)
+	unsigned ScannerTables::KeywordHash(const char *text, size_t length, unsigned seed) const
 	{
-		is.RestorePosition();
-		return "";
+		unsigned first = tolower(static_cast<unsigned char>(text[0]));
+		unsigned last = tolower(static_cast<unsigned char>(text[length - 1]));
+		return (first * seed + last + length) & (KEYWORD_HASH_SIZE - 1);
 	}
 
-	is.PopPosition();
-	return result;
-}
+	bool ScannerTables::BuildKeywordHash(unsigned seed)
+	{
+		memset(m_keywordSlots, -1, sizeof(m_keywordSlots));
 
-Token Lexer::ParseFloat(InputStream &is)
-{
-	is.PushPosition();
-	string numAccum(GetInt(is));
+		for (unsigned kw = 0; kw < KEYWORD_COUNT; kw++)
+		{
+			const char *spelling = KEYWORD_SPELLING[kw];
+			if (charClass[static_cast<unsigned char>(*spelling)] != CLASS_LETTER)
+			{
+				continue;
+			}
 
-	if (numAccum.size() == 0)
-	{
-		is.RestorePosition();
-		return Token::TokenError(is, is.Tell());
+			signed char &slot = m_keywordSlots[KeywordHash(spelling, strlen(spelling), seed)];
+			if (slot != -1)
+			{
+				return false;
+			}
+			slot = kw;
+		}
+
+		return true;
 	}
 
-	if (is.GetChar() != '.')
+	int ScannerTables::FindKeyword(const char *text, size_t length) const
 	{
-		is.RestorePosition();
-		return Token::TokenError(is, is.Tell());
-	}
+		int kw = m_keywordSlots[KeywordHash(text, length, m_keywordSeed)];
+		if (kw == -1)
+		{
+			return -1;
+		}
 
-	numAccum += '.';
-	is.Forward();
+		const char *spelling = KEYWORD_SPELLING[kw];
+		for (size_t i = 0; i < length; i++)
+		{
+			if (spelling[i] != tolower(static_cast<unsigned char>(text[i])))
+			{
+				return -1;
+			}
+		}
 
-	string rightPart = GetUInt(is);
-	if (rightPart.size() == 0)
-	{
-		is.RestorePosition();
-		return Token::TokenError(is, is.Tell());
+		return spelling[length] == '\0' ? kw : -1;
 	}
 
-	numAccum += rightPart;
+	const ScannerTables g_scanner;
 
-	return Token::TokenFloat(atof(numAccum.c_str()), is, is.PopPosition());
-}
+	// Converts int literal ~?[0-9]+
+	// - Returns false if the value doesn't fit into int
+	bool ConvertInt(const char *begin, const char *end, int &value)
+	{
+		bool isNegative = *begin == '~';
+		if (isNegative)
+		{
+			begin++;
+		}
 
-Token Lexer::ParseNumber(InputStream &is)
-{
-	// TODO: proper overflow check
+		// |INT_MIN| = INT_MAX + 1
+		const unsigned limit = isNegative ? 2147483648u : 2147483647u;
 
-	is.PushPosition();
-	string number(GetInt(is));
+		unsigned result = 0;
+		for (const char *pos = begin; pos != end; pos++)
+		{
+			unsigned digit = *pos - '0';
+			if (result > (limit - digit) / 10)
+			{
+				return false;
+			}
+			result = result * 10 + digit;
+		}
 
-	if (number.size() == 0)
-	{
-		is.RestorePosition();
-		return Token::TokenError(is, is.Tell());
+		value = isNegative ? static_cast<int>(0u - result) : static_cast<int>(result);
+		return true;
 	}
 
-	if (number.size() > 10)
-	{
-		throw CompileError("Number too long", Token::TokenError(is, is.PopPosition()));
-	}
+	// Significant digits enough to round any decimal number to double correctly
+	const size_t MAX_SIGNIFICANT_DIGITS = 780;
 
-	return Token::TokenInt(atoi(number.c_str()), is, is.PopPosition());
-}
+	const double POWERS_OF_10[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
 
-Token Lexer::ParseString(InputStream &is)
-{
-	if (is.GetChar() == '"')
+	// Converts float literal ~?[0-9]+.[0-9]+ with correct rounding
+	double ConvertFloat(const char *begin, const char *end)
 	{
-		string stringValue;
+		bool isNegative = *begin == '~';
+		if (isNegative)
+		{
+			begin++;
+		}
+
+		// Value is digits * 10^exponent
+		char digits[MAX_SIGNIFICANT_DIGITS + 32];
+		size_t digitCount = 0;
+		int exponent = 0;
+		bool isDroppedNonZero = false;
+		bool isFraction = false;
+		unsigned long long mantissa = 0;
 
-		is.PushPosition();
-		while (true)
+		for (const char *pos = begin; pos != end; pos++)
 		{
-			is.Forward();
+			if (*pos == '.')
+			{
+				isFraction = true;
+				continue;
+			}
+			if (isFraction)
+			{
+				exponent--;
+			}
+
+			// Leading zeros
+			if (digitCount == 0 && *pos == '0')
+			{
+				continue;
+			}
 
-			int ch = is.GetChar();
-			switch (ch)
+			if (digitCount < MAX_SIGNIFICANT_DIGITS)
 			{
-			case '"':
-				is.Forward();
-				return Token::TokenString(stringValue, is, is.PopPosition());
-			case EOS:
-				throw CompileError("Unclosed double quote", Token::TokenError(is, is.PopPosition()));
-			default:
-				stringValue += ch;
+				digits[digitCount++] = *pos;
+				mantissa = mantissa * 10 + (*pos - '0');
+			}
+			else
+			{
+				exponent++;
+				isDroppedNonZero |= *pos != '0';
 			}
 		}
-	}
 
-	return Token::TokenError(is, is.Tell());
-}
+		double result;
+		if (digitCount == 0)
+		{
+			result = 0.0;
+		}
+		else if (digitCount <= 15 && -exponent <= 22)
+		{
+			// Both numbers are exact, so is the rounded quotient
+			result = static_cast<double>(mantissa) / POWERS_OF_10[-exponent];
+		}
+		else
+		{
+			// Digits that were dropped only matter if they aren't all zeros
+			if (isDroppedNonZero)
+			{
+				digits[digitCount++] = '1';
+				exponent--;
+			}
 
-Token Lexer::ParseDelimeter(InputStream &is)
-{
-	string delim;
-	if (m_delim.find(delim = is.Get(2)) != m_delim.end() ||
-		m_delim.find(delim = is.Get(1)) != m_delim.end())
-	{
-		is.Forward(delim.size());
-		return Token::TokenDelimeter(m_tokens[delim], is, is.Tell() - delim.size());
-	}
+			size_t length = digitCount;
+			digits[length++] = 'e';
+			if (exponent < 0)
+			{
+				digits[length++] = '-';
+			}
 
-	return Token::TokenError(is, is.Tell());
+			char exponentDigits[16];
+			size_t exponentLength = 0;
+			unsigned absExponent = exponent < 0 ? -exponent : exponent;
+			do
+			{
+				exponentDigits[exponentLength++] = '0' + absExponent % 10;
+				absExponent /= 10;
+			} while (absExponent != 0);
+			while (exponentLength != 0)
+			{
+				digits[length++] = exponentDigits[--exponentLength];
+			}
+			digits[length] = '\0';
+
+			result = strtod(digits, nullptr);
+		}
+
+		return isNegative ? -result : result;
+	}
 }
 
-Token Lexer::ParseID(InputStream &is)
+void Lexer::StripComments(InputStream &is)
 {
-	int startPos = is.Tell();
+	bool isInsideString = false;
 
-	int ch = tolower(is.GetChar());
-	if ((ch >= 'a' && ch <= 'z') || ch == '_')
+	const char *begin = is.GetRemainingText();
+	const char *end = begin + is.GetRemainingLength();
+	for (const char *pos = CharScanner::FindQuoteOrBacktick(begin, end); pos != end;
+		pos = CharScanner::FindQuoteOrBacktick(pos + 1, end))
 	{
-		string idName;
-
-		do
+		if (*pos == '"')
 		{
-			idName += ch;
-			is.Forward();
-			ch = tolower(is.GetChar());
-		} while ((ch >= 'a' && ch <= 'z') || (ch >= '0' && ch <= '9') || ch == '_');
-		
-		if (m_tokens.find(idName) != m_tokens.end())
-		{
-			return Token::TokenKeyword(m_tokens[idName], is, startPos);
+			isInsideString = !isInsideString;
 		}
-		else
+		else if (!isInsideString)
 		{
-			return Token::TokenID(idName, is, startPos);
+			is.Truncate(is.Tell() + (pos - begin));
+			return;
 		}
 	}
-
-	return Token::TokenError(is, is.Tell());
 }
 
-typedef Token (*PARSE_FN_PTR)(InputStream &is);
-
 Token Lexer::ParseToken(InputStream &is)
 {
-	PARSE_FN_PTR parseFunctions[] = {
-		ParseFloat,
-		ParseNumber,
-		ParseString,
-		ParseDelimeter,
-		ParseID
-	};
+	const char *begin = is.GetRemainingText();
+	const char *end = begin + is.GetRemainingLength();
 
-	for (auto fn : parseFunctions)
+	unsigned state = STATE_START;
+	const char *pos = begin;
+	while (pos != end)
 	{
-		Token result = fn(is);
-		if (!result.IsError())
+		unsigned nextState = g_scanner.next[state][g_scanner.charClass[static_cast<unsigned char>(*pos)]];
+		if (nextState == STATE_NONE)
 		{
-			return result;
+			break;
+		}
+		state = nextState;
+		pos++;
+
+		// Skip whole runs of characters the state loops over
+		switch (g_scanner.run[state])
+		{
+		case RUN_IDENTIFIER:
+			pos += CharScanner::SpanIdentifier(pos, end);
+			break;
+		case RUN_DIGITS:
+			pos += CharScanner::SpanDigits(pos, end);
+			break;
+		case RUN_STRING:
+			pos = CharScanner::FindQuote(pos, end);
+			break;
 		}
 	}
 
-	return Token::TokenError(is, is.Tell());
+	size_t startPos = is.Tell();
+	size_t length = pos - begin;
+
+	switch (g_scanner.accept[state])
+	{
+	case ACCEPT_ID:
+		{
+			is.Forward(length);
+
+			int kw = g_scanner.FindKeyword(begin, length);
+			if (kw != -1)
+			{
+				return Token::TokenKeyword(static_cast<KEYWORD>(kw), is, startPos);
+			}
+			return Token::TokenID(Interner::InternLowercase(begin, length), is, startPos);
+		}
+
+	case ACCEPT_INT_DOT:
+		length--;
+		// fall through
+	case ACCEPT_INT:
+		{
+			int value;
+			if (!ConvertInt(begin, begin + length, value))
+			{
+				throw CompileError("Number is out of range", Token::TokenError(is, startPos));
+			}
+
+			is.Forward(length);
+			return Token::TokenInt(value, is, startPos);
+		}
+
+	case ACCEPT_FLOAT:
+		{
+			double value = ConvertFloat(begin, begin + length);
+
+			is.Forward(length);
+			return Token::TokenFloat(value, is, startPos);
+		}
+
+	case ACCEPT_STRING:
+		is.Forward(length);
+		return Token::TokenString(Interner::Intern(begin + 1, length - 2), is, startPos);
+
+	case ACCEPT_UNCLOSED_STRING:
+		throw CompileError("Unclosed double quote", Token::TokenError(is, startPos));
+
+	case ACCEPT_DELIMETER:
+		is.Forward(length);
+		return Token::TokenDelimeter(g_scanner.delimeter[state], is, startPos);
+
+	default:
+		return Token::TokenError(is, startPos);
+	}
 }
 
-vector<Token> Lexer::ParseLine(const string &line, int lineNumber) const
+void Lexer::ParseTokens(InputStream &is, vector<Token> &result)
 {
-	InputStream is = InputStream(StripComments(line), lineNumber);
-	vector<Token> result;
+	StripComments(is);
 
+	size_t lineStart = result.size();
 	bool whitespaceSkipped = is.SkipSpaces() != 0;
 	while (!is.IsEOS())
 	{
@@ -231,7 +496,7 @@ vector<Token> Lexer::ParseLine(const string &line, int lineNumber) const
 		}
 		result.push_back(token);
 
-		if (result.size() >= 2)
+		if (result.size() - lineStart >= 2)
 		{
 			if (!result[result.size() - 2].IsDelimeter() &&
 				!result[result.size() - 1].IsDelimeter())
@@ -251,99 +516,205 @@ vector<Token> Lexer::ParseLine(const string &line, int lineNumber) const
 
 		whitespaceSkipped = is.SkipSpaces() != 0;
 	}
+}
+
+vector<Token> Lexer::ParseLine(const string &line, int lineNumber)
+{
+	InputStream is(line, lineNumber, &m_lines);
+	vector<Token> result;
+
+	ParseTokens(is, result);
 
 	return result;
 }
 
-TokenStream Lexer::Parse(const std::string &line, int lineNumber) const
+vector<Token> Lexer::ParseBuffer(const char *data, size_t size)
 {
-	return TokenStream(ParseLine(line, lineNumber));
+	InputStream is(data, size, &m_lines);
+	vector<Token> result;
+
+	do
+	{
+		ParseTokens(is, result);
+	} while (is.NextLine());
+
+	return result;
 }
 
-Lexer::Lexer()
+class Lexer::BufferSource : public ITokenSource
 {
-	if (m_tokens.size() == 0)
+public:
+	BufferSource(const char *data, size_t size, LineTable *lines)
+		: m_is(data, size, lines)
+		, m_lines(lines)
+		, m_finished(false)
 	{
-		m_tokens["const"] = KW_CONST;
-		m_tokens["global"] = KW_GLOBAL;
-		m_tokens["def"] = KW_DEF;
-
-		m_tokens["return"] = KW_RETURN;
-		m_tokens["if"] = KW_IF;
-		m_tokens["else"] = KW_ELSE;
-		m_tokens["do"] = KW_DO;
-		m_tokens["while"] = KW_WHILE;
-		m_tokens["for"] = KW_FOR;
-		m_tokens["to"] = KW_TO;
-		m_tokens["step"] = KW_STEP;
-		
-		m_tokens["="] = KW_ASSIGN;
-		m_tokens[","] = KW_COMMA;
-
-		m_tokens["("] = KW_BRACE_L;
-		m_tokens[")"] = KW_BRACE_R;
-		m_tokens["{"] = KW_BLOCK_L;
-		m_tokens["}"] = KW_BLOCK_R;
-		m_tokens["["] = KW_INDEX_L;
-		m_tokens["]"] = KW_INDEX_R;
-
-		m_tokens["~"] = KW_UNARY_MINUS;
-		m_tokens["+"] = KW_PLUS;
-		m_tokens["-"] = KW_MINUS;
-		m_tokens["*"] = KW_MUL;
-		m_tokens["/"] = KW_DIV;
-		m_tokens["mod"] = KW_MOD;
-
-		m_tokens["or"] = KW_OR;
-		m_tokens["and"] = KW_AND;
-		m_tokens["not"] = KW_NOT;
-
-		m_tokens["<"] = KW_LESS;
-		m_tokens[">"] = KW_GREATER;
-		m_tokens["=="] = KW_EQUAL;
-		m_tokens[">="] = KW_GR_EQ;
-		m_tokens["<="] = KW_LE_EQ;
-		m_tokens["<>"] = KW_NOT_EQ;
-
-		m_tokens["$"] = KW_STRING;
-		m_tokens["%"] = KW_INT;
-		m_tokens["#"] = KW_FLOAT;
-		m_tokens["!"] = KW_BOOL;
-
-		m_tokens["new"] = KW_NEW;
-		m_tokens["delete"] = KW_DELETE;
-		m_tokens["array"] = KW_ARRAY;
-		m_tokens["dict"] = KW_DICT;
 	}
 
-	if (m_delim.size() == 0)
+	bool ReadTokens(TokenBuffer &tokens) override
+	{
+		if (m_finished)
+		{
+			return false;
+		}
+
+		m_lineTokens.clear();
+		ParseTokens(m_is, m_lineTokens);
+		tokens.Append(m_lineTokens);
+		m_finished = !m_is.NextLine();
+
+		return true;
+	}
+
+	void Release(const Token &first) override
 	{
-		m_delim.insert("==");
-		m_delim.insert(">=");
-		m_delim.insert("<=");
-		m_delim.insert("<>");
-		m_delim.insert("<");
-		m_delim.insert(">");
-
-		m_delim.insert("$");
-		m_delim.insert("%");
-		m_delim.insert("#");
-		m_delim.insert("!");
-
-		m_delim.insert(",");
-
-		m_delim.insert("(");
-		m_delim.insert(")");
-		m_delim.insert("{");
-		m_delim.insert("}");
-		m_delim.insert("[");
-		m_delim.insert("]");
-
-		m_delim.insert("=");
-		m_delim.insert("+");
-		m_delim.insert("-");
-		m_delim.insert("*");
-		m_delim.insert("/");
-		m_delim.insert("~");
+		m_lines->Release(first.GetLineIndex());
 	}
+
+private:
+	InputStream m_is;
+	LineTable *m_lines;
+	bool m_finished;
+	// Tokens of the current line
+	vector<Token> m_lineTokens;
+};
+
+TokenStream Lexer::ParseStream(const char *data, size_t size)
+{
+	m_streamLines.emplace_back();
+	return TokenStream(make_shared<BufferSource>(data, size, &m_streamLines.back()));
+}
+
+// Chunks for parallel tokenizing are at least this long
+static const size_t MIN_CHUNK_SIZE = 64 * 1024;
+// Having more chunks than threads evens out the load
+static const size_t CHUNKS_PER_THREAD = 4;
+
+vector<Token> Lexer::ParseBufferParallel(const char *data, size_t size, ThreadPool &pool)
+{
+	size_t chunkCount = min(pool.GetThreadCount() * CHUNKS_PER_THREAD, size / MIN_CHUNK_SIZE);
+	if (chunkCount < 2)
+	{
+		return ParseBuffer(data, size);
+	}
+
+	struct Chunk
+	{
+		const char *begin;
+		const char *end;
+		int firstLineNumber;
+		LineTable lines;
+		vector<Token> tokens;
+	};
+
+	// Every chunk but the last one ends with a line break
+	vector<Chunk> chunks(chunkCount);
+	const char *end = data + size;
+	const char *chunkBegin = data;
+	size_t used = 0;
+	while (chunkBegin != end)
+	{
+		const char *split = data + size * (used + 1) / chunkCount;
+		if (split < chunkBegin)
+		{
+			split = chunkBegin;
+		}
+
+		const char *lineBreak = split != end
+			? static_cast<const char *>(memchr(split, '\n', end - split))
+			: nullptr;
+
+		Chunk &chunk = chunks[used++];
+		chunk.begin = chunkBegin;
+		chunk.end = lineBreak && used != chunkCount ? lineBreak + 1 : end;
+		chunkBegin = chunk.end;
+	}
+	chunks.resize(used);
+
+	// Line numbers of the chunks come from the number of line breaks before them
+	vector<future<void>> results;
+	vector<int> lineBreaks(chunks.size());
+	for (size_t i = 0; i < chunks.size(); i++)
+	{
+		results.push_back(pool.Submit([&chunks, &lineBreaks, i]
+		{
+			int count = 0;
+			const char *pos = chunks[i].begin;
+			while ((pos = static_cast<const char *>(memchr(pos, '\n', chunks[i].end - pos))) != nullptr)
+			{
+				count++;
+				pos++;
+			}
+			lineBreaks[i] = count;
+		}));
+	}
+	for (auto &result : results)
+	{
+		result.get();
+	}
+
+	int lineNumber = 1;
+	for (size_t i = 0; i < chunks.size(); i++)
+	{
+		chunks[i].firstLineNumber = lineNumber;
+		lineNumber += lineBreaks[i];
+	}
+
+	results.clear();
+	for (size_t i = 0; i < chunks.size(); i++)
+	{
+		results.push_back(pool.Submit([&chunks, i]
+		{
+			Chunk &chunk = chunks[i];
+			InputStream is(chunk.begin, chunk.end - chunk.begin, &chunk.lines, chunk.firstLineNumber);
+			do
+			{
+				ParseTokens(is, chunk.tokens);
+			} while (is.NextLine());
+		}));
+	}
+
+	// All the tasks must finish before chunks go out of scope
+	for (auto &result : results)
+	{
+		result.wait();
+	}
+	for (auto &result : results)
+	{
+		result.get();
+	}
+
+	size_t tokenCount = 0;
+	for (auto &chunk : chunks)
+	{
+		tokenCount += chunk.tokens.size();
+	}
+
+	vector<Token> result;
+	result.reserve(tokenCount);
+	for (auto &chunk : chunks)
+	{
+		unsigned lineShift = m_lines.Append(chunk.lines);
+		for (Token token : chunk.tokens)
+		{
+			token.RebaseLine(&m_lines, lineShift);
+			result.push_back(token);
+		}
+	}
+
+	return result;
+}
+
+TokenStream Lexer::Parse(const std::string &line, int lineNumber)
+{
+	return TokenStream(ParseLine(line, lineNumber));
+}
+
+const LineTable &Lexer::GetLines() const
+{
+	return m_lines;
+}
+
+Lexer::Lexer()
+{
 }
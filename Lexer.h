@@ -1,11 +1,12 @@
 #pragma once
+#include <list>
 #include <string>
 #include <vector>
-#include <map>
-#include <set>
 #include "InputStream.h"
 #include "TokenStream.h"
 #include "Token.h"
+#include "LineTable.h"
+#include "ThreadPool.h"
 
 class Lexer
 {
@@ -13,6 +14,11 @@ public:
 	// Lexer(InputStream &is);
 	Lexer();
 
+	// Tokens refer to the lines stored in lexer,
+	// so lexer must outlive them and can't be copied
+	Lexer(const Lexer &) = delete;
+	Lexer &operator=(const Lexer &) = delete;
+
 	// should return token stream instead of vector of tokens
 	// token stream: nextToken, reset, forward, token
 	// returns TokenEOF when there's noting more
@@ -28,24 +34,50 @@ public:
 	// -       lineNumber
 	// -      CompileError
 	// -      !
-	std::vector<Token> ParseLine(const std::string &line, int lineNumber = 0) const;
+	std::vector<Token> ParseLine(const std::string &line, int lineNumber = 0);
+
+	// Tokenizes whole source text (e.g. a memory mapped file) in a single pass
+	// - Lines are numbered starting with 1
+	// - Lines stay in the buffer, the line table of the lexer only refers
+	// to them, so the buffer must outlive the tokens
+	// - Throws CompileError in case of an error
+	std::vector<Token> ParseBuffer(const char *data, size_t size);
+
+	// Same as ParseBuffer(), but the text is split into chunks at line
+	// breaks and the chunks are tokenized on the threads of the pool
+	// - Small texts are tokenized on the calling thread
+	// - If there are errors in several chunks, the first one is thrown
+	std::vector<Token> ParseBufferParallel(const char *data, size_t size, ThreadPool &pool);
+
+	// Creates a stream that tokenizes the source text line by line
+	// as the parser reads it
+	// - The buffer and the lexer must outlive the stream
+	// - Lexical errors are thrown by the stream when it gets to them
+	// - Lines have a table of their own, where the lines of the tokens
+	// dropped by the stream are released, so memory doesn't grow with the text
+	TokenStream ParseStream(const char *data, size_t size);
 
-	TokenStream Parse(const std::string &line, int lineNumber = 0) const;
+	TokenStream Parse(const std::string &line, int lineNumber = 0);
 
 	//     -  
 	const std::vector<Token> *GetTokens() const;
 
+	// Returns lines of all the text tokenized by this lexer, except ParseStream()
+	const LineTable &GetLines() const;
+
 private:
-	// make InputStream &is a private variable
-	// so we won't have to pass it to all those static
-	// functions manually
-	static std::string StripComments(const std::string &line);
-	static std::string GetUInt(InputStream &is);
-	static std::string GetInt(InputStream &is);
-	static Token ParseFloat(InputStream &is);
-	static Token ParseNumber(InputStream &is);
-	static Token ParseString(InputStream &is);
-	static Token ParseDelimeter(InputStream &is);
-	static Token ParseID(InputStream &is);
+	LineTable m_lines;
+	// Tables of the streams, list keeps their addresses
+	std::list<LineTable> m_streamLines;
+
+	// Token source of ParseStream()
+	class BufferSource;
+
+	static void StripComments(InputStream &is);
+	// Recognizes the token at the current position of the stream
+	// with the scanner DFA, in one pass and without backtracking
+	// - Returns TokenError if there is no token at that position
 	static Token ParseToken(InputStream &is);
+	// Tokenizes current line of the stream and appends tokens to result
+	static void ParseTokens(InputStream &is, std::vector<Token> &result);
 };
@@ -0,0 +1,540 @@
+#include <cctype>
+#include <climits>
+#include <cstdlib>
+#include <sstream>
+#include <vector>
+#include "LexerTest.h"
+#include "UnitTest.h"
+#include "Exception.h"
+#include "Lexer.h"
+#include "Parser.h"
+#include "ProgramGenerator.h"
+#include "SymbolTable.h"
+#include "ThreadPool.h"
+#include "Variable.h"
+
+using namespace std;
+
+namespace
+{
+	vector<Token> Lex(const string &text)
+	{
+		Lexer lex;
+		return lex.ParseBuffer(text.data(), text.size());
+	}
+
+	bool IsLetter(char c)
+	{
+		return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+	}
+
+	// Kinds of the tokens of the text, e.g. "TOKEN_ID KW_INT"
+	string Describe(const string &text)
+	{
+		string result;
+		for (const Token &token : Lex(text))
+		{
+			if (!result.empty())
+			{
+				result += ' ';
+			}
+			TOKEN_TYPE type = token.GetType();
+			result += type == TOKEN_KEYWORD || type == TOKEN_DELIMETER ?
+				KEYWORD_STRING[token.GetValueK()] : TOKEN_TYPE_STRING[type];
+		}
+		return result;
+	}
+
+	// Text is a single token of the keyword
+	void CheckKeyword(const string &text, KEYWORD kw)
+	{
+		vector<Token> tokens = Lex(text);
+		Check(tokens.size() == 1, "'" + text + "' isn't one token");
+		TOKEN_TYPE type = IsLetter(KEYWORD_SPELLING[kw][0]) ? TOKEN_KEYWORD : TOKEN_DELIMETER;
+		Check(tokens[0].GetType() == type && tokens[0].GetValueK() == kw,
+			"'" + text + "' isn't " + KEYWORD_STRING[kw] + ": " + Describe(text));
+	}
+
+	// Text is a single identifier, which isn't a keyword
+	void CheckIdentifier(const string &text)
+	{
+		vector<Token> tokens = Lex(text);
+		Check(tokens.size() == 1 && tokens[0].GetType() == TOKEN_ID,
+			"'" + text + "' isn't an identifier");
+	}
+
+	// Type, value and place of the token
+	string Describe(const Token &token)
+	{
+		string result = string(TOKEN_TYPE_STRING[token.GetType()]) + " ";
+		switch (token.GetType())
+		{
+		case TOKEN_KEYWORD:
+		case TOKEN_DELIMETER:
+			result += KEYWORD_STRING[token.GetValueK()];
+			break;
+		case TOKEN_INT:
+			result += to_string(token.GetValueI());
+			break;
+		case TOKEN_FLOAT:
+			result += to_string(token.GetValueF());
+			break;
+		case TOKEN_STRING:
+		case TOKEN_ID:
+			result += token.GetValueS();
+			break;
+		default:
+			break;
+		}
+		return result + " at " + to_string(token.GetLineNumber()) + ":" + to_string(token.GetOffset()) +
+			" of '" + token.GetLine() + "'";
+	}
+
+	// Error of ParseBuffer() or ParseBufferParallel() of the text,
+	// empty if the text is valid, tokens are compared too
+	string CompareLexers(const string &text, ThreadPool &pool)
+	{
+		string error;
+		vector<Token> tokens;
+		Lexer lex;
+		try
+		{
+			tokens = lex.ParseBuffer(text.data(), text.size());
+		}
+		catch (const CompileError &e)
+		{
+			error = e.what();
+		}
+
+		string parallelError;
+		vector<Token> parallelTokens;
+		Lexer parallelLex;
+		try
+		{
+			parallelTokens = parallelLex.ParseBufferParallel(text.data(), text.size(), pool);
+		}
+		catch (const CompileError &e)
+		{
+			parallelError = e.what();
+		}
+
+		Check(parallelError == error, "error '" + parallelError + "' instead of '" + error + "'");
+		Check(parallelTokens.size() == tokens.size(), to_string(parallelTokens.size()) +
+			" tokens instead of " + to_string(tokens.size()));
+		for (size_t i = 0; i < tokens.size(); i++)
+		{
+			string expected = Describe(tokens[i]);
+			string actual = Describe(parallelTokens[i]);
+			Check(actual == expected, "token " + expected + " is " + actual);
+		}
+		return error;
+	}
+
+	// Text is an int literal of the value
+	void CheckInt(const string &text, int value)
+	{
+		vector<Token> tokens = Lex(text);
+		Check(tokens.size() == 1 && tokens[0].GetType() == TOKEN_INT && tokens[0].GetValueI() == value,
+			"'" + text + "' isn't " + to_string(value) + ": " + Describe(text));
+	}
+
+	// Text is a float literal, rounded the same as by strtod()
+	void CheckFloat(const string &text)
+	{
+		string cText = text;
+		if (cText[0] == '~')
+		{
+			cText[0] = '-';
+		}
+		double value = strtod(cText.c_str(), nullptr);
+
+		vector<Token> tokens = Lex(text);
+		Check(tokens.size() == 1 && tokens[0].GetType() == TOKEN_FLOAT && tokens[0].GetValueF() == value,
+			"'" + text.substr(0, 40) + "' isn't " + to_string(value) + ": " + Describe(text).substr(0, 40));
+	}
+
+	bool IsOutOfRange(const string &text)
+	{
+		try
+		{
+			Lex(text);
+		}
+		catch (const CompileError &e)
+		{
+			return string(e.what()).find("Number is out of range") != string::npos;
+		}
+		return false;
+	}
+
+	// Tokens of the lines of a text, records how far the stream has dropped them
+	class LineSource : public ITokenSource
+	{
+	public:
+		explicit LineSource(const string &text)
+			: m_lineNumber(0)
+			, m_released(0)
+		{
+			istringstream lines(text);
+			string line;
+			while (getline(lines, line))
+			{
+				m_lines.push_back(line);
+			}
+		}
+
+		bool ReadTokens(TokenBuffer &tokens) override
+		{
+			if (m_lineNumber == m_lines.size())
+			{
+				return false;
+			}
+			m_lineNumber++;
+			tokens.Append(m_lexer.ParseLine(m_lines[m_lineNumber - 1], static_cast<int>(m_lineNumber)));
+			return true;
+		}
+
+		void Release(const Token &first) override
+		{
+			m_released = first.GetLineNumber();
+		}
+
+		size_t GetLineCount() const
+		{
+			return m_lines.size();
+		}
+
+		// Line of the first token the stream has kept
+		int GetReleased() const
+		{
+			return m_released;
+		}
+
+	private:
+		Lexer m_lexer;
+		vector<string> m_lines;
+		size_t m_lineNumber;
+		int m_released;
+	};
+
+	// Error of parsing the tokens of the stream, empty if there is none
+	string GetStreamError(TokenStream ts)
+	{
+		try
+		{
+			Parse(ts);
+		}
+		catch (const CompileError &ex)
+		{
+			return ex.what();
+		}
+		return string();
+	}
+
+	bool IsKeywordSpelling(const string &text)
+	{
+		for (unsigned kw = 0; kw < KEYWORD_COUNT; kw++)
+		{
+			if (text == KEYWORD_SPELLING[kw])
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+}
+
+void TestScanner()
+{
+	// Every spelling of Token.h, in any case, is found by the perfect hash
+	for (unsigned kw = 0; kw < KEYWORD_COUNT; kw++)
+	{
+		string spelling = KEYWORD_SPELLING[kw];
+		CheckKeyword(spelling, static_cast<KEYWORD>(kw));
+		CheckKeyword(" " + spelling + "\t", static_cast<KEYWORD>(kw));
+
+		if (IsLetter(spelling[0]))
+		{
+			string upper = spelling;
+			for (char &c : upper)
+			{
+				c = static_cast<char>(toupper(c));
+			}
+			CheckKeyword(upper, static_cast<KEYWORD>(kw));
+
+			// Words that differ from a keyword only at the end
+			// may fall into its slot of the hash
+			CheckIdentifier(spelling + "x");
+			CheckIdentifier(spelling + "1");
+			CheckIdentifier("x" + spelling);
+			if (spelling.size() > 1 && !IsKeywordSpelling(spelling.substr(0, spelling.size() - 1)))
+			{
+				CheckIdentifier(spelling.substr(0, spelling.size() - 1));
+			}
+		}
+	}
+
+	// All the words of up to 3 letters
+	const string LETTERS = "abcdefghijklmnopqrstuvwxyz";
+	for (char a : LETTERS)
+	{
+		string word1(1, a);
+		if (!IsKeywordSpelling(word1))
+		{
+			CheckIdentifier(word1);
+		}
+		for (char b : LETTERS)
+		{
+			string word2 = word1 + b;
+			if (!IsKeywordSpelling(word2))
+			{
+				CheckIdentifier(word2);
+			}
+			for (char c : LETTERS)
+			{
+				string word3 = word2 + c;
+				if (!IsKeywordSpelling(word3))
+				{
+					CheckIdentifier(word3);
+				}
+			}
+		}
+	}
+
+	// Delimiters are matched by the longest spelling
+	Check(Describe("a%<=b%") == "TOKEN_ID KW_INT KW_LE_EQ TOKEN_ID KW_INT", Describe("a%<=b%"));
+	Check(Describe("<<>>=") == "KW_LESS KW_NOT_EQ KW_GR_EQ", Describe("<<>>="));
+	Check(Describe("===") == "KW_EQUAL KW_ASSIGN", Describe("==="));
+	Check(Describe("x$[]()") == "TOKEN_ID KW_STRING KW_INDEX_L KW_INDEX_R KW_BRACE_L KW_BRACE_R",
+		Describe("x$[]()"));
+	Check(Describe("ifx%=do1") == "TOKEN_ID KW_INT KW_ASSIGN TOKEN_ID", Describe("ifx%=do1"));
+	Check(Describe("12.5 \"if\" mod") == "TOKEN_FLOAT TOKEN_STRING KW_MOD", Describe("12.5 \"if\" mod"));
+
+	// A character that starts no token is an error, as are
+	// adjoining tokens that aren't delimiters
+	const char *const ERRORS[] = { "a% = 1 @ 2", "5f6", "12.5\"if\"", "\"a\"mod" };
+	for (const char *text : ERRORS)
+	{
+		bool isError = false;
+		try
+		{
+			Lex(text);
+		}
+		catch (const CompileError &)
+		{
+			isError = true;
+		}
+		Check(isError, string("'") + text + "' isn't an error");
+	}
+}
+
+void TestInterner()
+{
+	// Identifiers are interned in lower case, string literals as they are
+	vector<Token> tokens = Lex("InternerTestName% = \"InternerTestString\"");
+	Check(Interner::Find("internertestname") == tokens[0].GetValueA(), "identifier isn't found");
+	Check(Interner::Find("InternerTestString") == tokens[3].GetValueA(), "string isn't found");
+	Check(Interner::Find("InternerTestName") == Interner::NO_ATOM, "identifier is found in upper case");
+
+	// Looking up a string that isn't there doesn't add it
+	unsigned count = Interner::Count();
+	Check(Interner::Find("internertestabsent") == Interner::NO_ATOM, "absent string is found");
+	Check(Interner::Find(string("internertestabsent", 10)) == Interner::NO_ATOM, "prefix of a string is found");
+
+	SymbolTable<Variable> symbols;
+	symbols.Define(make_shared<Variable>("internertestvar", ATOMIC_TYPE::TYPE_INT));
+	Check(symbols.IsDefined("internertestvar") && symbols.GetIndex("internertestvar") == 0, "symbol isn't found");
+	Check(!symbols.IsDefined("internertestundefined"), "undefined symbol is found");
+
+	string error;
+	try
+	{
+		symbols.GetIndex("internertestundefined");
+	}
+	catch (const IntermediateError &ex)
+	{
+		error = ex.what();
+	}
+	Check(error == "Symbol 'internertestundefined' is undefined", "wrong error: " + error);
+	Check(Interner::Count() == count + 1, "lookups added strings");
+}
+
+void TestParallelLexer()
+{
+	GeneratorOptions options;
+	options.seed = 3;
+	options.functionCount = 300;
+	options.statementsPerFunction = 30;
+	string text = ProgramGenerator(options).Generate();
+
+	// Chunks are at least 64K long, there must be several per thread
+	ThreadPool pool(4);
+	Check(text.size() >= 16 * 64 * 1024, "program is too short: " + to_string(text.size()));
+	string error = CompareLexers(text, pool);
+	Check(error.empty(), "generated program has lexical errors: " + error);
+
+	// Lines ending with "\r\n"
+	string crlf;
+	for (char c : text)
+	{
+		if (c == '\n')
+		{
+			crlf += "\r\n";
+		}
+		else
+		{
+			crlf += c;
+		}
+	}
+	CompareLexers(crlf, pool);
+
+	// Errors in the middle and in the last chunk, the first one is thrown
+	string invalid = text;
+	invalid.insert(invalid.find('\n', invalid.size() / 2) + 1, "a% = 1 @ 2\n");
+	error = CompareLexers(invalid, pool);
+	Check(!error.empty(), "error in the middle isn't found");
+	invalid.insert(invalid.size() - 1, "\n5f6\n");
+	Check(CompareLexers(invalid, pool) == error, "error in the middle isn't the first one");
+
+	// Text that is too short for chunks
+	CompareLexers("a% = 1\nb$ = \"2\"\n", pool);
+}
+
+void TestNumbers()
+{
+	CheckInt("0", 0);
+	CheckInt("~0", 0);
+	CheckInt("2147483647", INT_MAX);
+	CheckInt("~2147483648", INT_MIN);
+	CheckInt("000000000002147483647", INT_MAX);
+	CheckInt("~000000000002147483648", INT_MIN);
+
+	// Values that overflowed in atoi() or were cut by the length limit
+	const char *const OUT_OF_RANGE[] = {
+		"2147483648", "~2147483649", "4294967296", "4294967297", "9999999999",
+		"21474836470", "100000000000000000000000000000"
+	};
+	for (const char *text : OUT_OF_RANGE)
+	{
+		Check(IsOutOfRange(text), string("'") + text + "' isn't out of range");
+	}
+
+	// Fast path of up to 15 digits and the path through strtod()
+	const char *const FLOATS[] = {
+		"0.0", "~0.0", "0.1", "~0.5", "1.5", "0.30000000000000004", "123456789012345.6",
+		"999999999999999.9", "1.7976931348623157", "179769313486231570000000000000.0",
+		"0.0000000000000000000001", "0.00000000000000000000001", "4.35", "9007199254740993.0",
+		"9007199254740992.5", "1234567890123456789012345678901234567890.0987654321"
+	};
+	for (const char *text : FLOATS)
+	{
+		CheckFloat(text);
+	}
+
+	// Long mantissas: 2^53 + 1 is halfway between two doubles and
+	// rounds to even, unless a non-zero digit past the limit of
+	// significant digits breaks the tie
+	string halfway = "9007199254740993." + string(1000, '0');
+	CheckFloat(halfway);
+	CheckFloat(halfway + "1");
+	Check(Lex(halfway + "1")[0].GetValueF() == 9007199254740994.0, "dropped digits don't round up");
+	CheckFloat("0." + string(320, '0') + "123");
+	CheckFloat("0." + string(400, '0') + "1");
+	CheckFloat(string(400, '9') + ".0");
+	CheckFloat("1." + string(2000, '3'));
+
+	// Random literals of all lengths
+	unsigned random = 12345;
+	for (int i = 0; i < 2000; i++)
+	{
+		string text;
+		int intDigits = 1 + i % 30;
+		int fractionDigits = 1 + i / 30 % 40;
+		for (int digit = 0; digit < intDigits + fractionDigits; digit++)
+		{
+			random = random * 1103515245 + 12345;
+			text += static_cast<char>('0' + (random >> 16) % 10);
+			if (digit + 1 == intDigits)
+			{
+				text += '.';
+			}
+		}
+		CheckFloat(text);
+	}
+}
+
+void TestLineTable()
+{
+	GeneratorOptions options;
+	options.seed = 9;
+	options.functionCount = 200;
+	string text = ProgramGenerator(options).Generate();
+	const char *begin = text.data();
+	const char *end = text.data() + text.size();
+
+	// Tokenizing the buffer doesn't copy it, in one pass and in chunks
+	ThreadPool pool(4);
+	Lexer lex;
+	vector<Token> tokens = lex.ParseBuffer(text.data(), text.size());
+	vector<Token> parallelTokens = lex.ParseBufferParallel(text.data(), text.size(), pool);
+	const LineTable &lines = lex.GetLines();
+	Check(lines.Count() > 0, "no lines");
+	for (unsigned i = 0; i < lines.Count(); i++)
+	{
+		const char *line = lines.GetText(i);
+		Check(line >= begin && line + lines.GetLength(i) <= end, "line " + to_string(i) + " is copied");
+	}
+	Check(parallelTokens.back().GetLine() == tokens.back().GetLine(), "last lines differ");
+
+	// A line of a string is copied, it outlives the string
+	string line = "a% = 1 + b%";
+	tokens = lex.ParseLine(line, 7);
+	line.assign(line.size(), '?');
+	Check(tokens.back().GetLine() == "a% = 1 + b%" && tokens.back().GetLineNumber() == 7,
+		"line of a string isn't kept: " + tokens.back().GetLine());
+}
+
+void TestStreamLexer()
+{
+	GeneratorOptions options;
+	options.seed = 10;
+	options.functionCount = 100;
+	string text = ProgramGenerator(options).Generate();
+
+	Lexer lex;
+	TokenStream stream = lex.ParseStream(text.data(), text.size());
+	Check(DumpAst(*Parse(stream)) == DumpAst(*ParseText(text)), "streamed program differs");
+
+	// Vector of tokens moved into a stream is freed
+	vector<Token> tokens = lex.ParseBuffer(text.data(), text.size());
+	TokenStream moved(move(tokens));
+	Check(tokens.empty() && tokens.capacity() == 0, "moved tokens aren't freed");
+	Check(DumpAst(*Parse(moved)) == DumpAst(*ParseText(text)), "program of moved tokens differs");
+
+	// Errors near the end refer to lines that are still kept
+	string invalid = text + "\ndef last()\n{\n  a% = (1\n}\n";
+	string error = GetParseError(invalid);
+	Check(!error.empty(), "error at the end isn't found");
+	Check(GetStreamError(lex.ParseStream(invalid.data(), invalid.size())) == error,
+		"streamed error differs from " + error);
+
+	// Lines of the dropped tokens are released, indexes of the others stay
+	LineTable lines;
+	const char LINES[] = "first\nsecond\nthird";
+	lines.AddExternalLine(LINES, 5, 1);
+	lines.AddExternalLine(LINES + 6, 6, 2);
+	lines.AddLine("copy", 4, 3);
+	lines.Release(2);
+	Check(lines.Count() == 3 && lines.GetLine(2) == "copy" && lines.GetLineNumber(2) == 3,
+		"lines after the released ones are lost");
+	Check(lines.AddExternalLine(LINES + 13, 5, 4) == 3 && lines.GetLine(3) == "third",
+		"line added after the release has another index");
+
+	// The stream drops the tokens of the parsed definitions
+	auto source = make_shared<LineSource>(text);
+	TokenStream window(source);
+	Parse(window);
+	Check(source->GetReleased() > static_cast<int>(source->GetLineCount() * 3 / 4),
+		"tokens before line " + to_string(source->GetReleased()) + " of " +
+		to_string(source->GetLineCount()) + " are kept");
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+// Recognition of keywords, delimiters and identifiers by the scanner DFA
+void TestScanner();
+
+// Interner::Find() finds interned strings and doesn't add the others,
+// neither do SymbolTable lookups by name
+void TestInterner();
+
+// ParseBufferParallel() makes the same tokens and errors as ParseBuffer()
+void TestParallelLexer();
+
+// Values and range errors of int and float literals
+void TestNumbers();
+
+// Lines of a buffer stay in it, lines of a temporary text are copied
+void TestLineTable();
+
+// ParseStream() makes the same program as ParseBuffer() and lets
+// the lines of the dropped tokens go
+void TestStreamLexer();
@@ -0,0 +1,97 @@
+#include "LineTable.h"
+
+using namespace std;
+
+LineTable::LineTable()
+	: m_firstIndex(0)
+{
+}
+
+unsigned LineTable::AddLine(const char *text, size_t length, int lineNumber)
+{
+	Line line;
+	line.external = nullptr;
+	line.offset = m_text.size();
+	line.length = length;
+	line.number = lineNumber;
+
+	m_text.append(text, length);
+	m_lines.push_back(line);
+
+	return Count() - 1;
+}
+
+unsigned LineTable::AddExternalLine(const char *text, size_t length, int lineNumber)
+{
+	Line line;
+	line.external = text;
+	line.offset = 0;
+	line.length = length;
+	line.number = lineNumber;
+
+	m_lines.push_back(line);
+
+	return Count() - 1;
+}
+
+void LineTable::Truncate(unsigned index, size_t length)
+{
+	Line &line = m_lines[index - m_firstIndex];
+	if (length < line.length)
+	{
+		line.length = length;
+	}
+}
+
+string LineTable::GetLine(unsigned index) const
+{
+	return string(GetText(index), GetLength(index));
+}
+
+const char *LineTable::GetText(unsigned index) const
+{
+	const Line &line = m_lines[index - m_firstIndex];
+	return line.external ? line.external : m_text.data() + line.offset;
+}
+
+size_t LineTable::GetLength(unsigned index) const
+{
+	return m_lines[index - m_firstIndex].length;
+}
+
+int LineTable::GetLineNumber(unsigned index) const
+{
+	return m_lines[index - m_firstIndex].number;
+}
+
+unsigned LineTable::Count() const
+{
+	return m_firstIndex + static_cast<unsigned>(m_lines.size());
+}
+
+void LineTable::Release(unsigned index)
+{
+	while (m_firstIndex < index && !m_lines.empty())
+	{
+		m_lines.pop_front();
+		m_firstIndex++;
+	}
+}
+
+unsigned LineTable::Append(const LineTable &other)
+{
+	unsigned firstIndex = Count();
+	size_t textOffset = m_text.size();
+
+	m_text.append(other.m_text);
+	for (Line line : other.m_lines)
+	{
+		if (!line.external)
+		{
+			line.offset += textOffset;
+		}
+		m_lines.push_back(line);
+	}
+
+	return firstIndex;
+}
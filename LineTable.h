@@ -0,0 +1,61 @@
+#pragma once
+#include <string>
+#include <deque>
+
+// Source lines shared by the tokens of one lexer
+// - Tokens refer to their line by index instead of keeping a copy of it
+// - Lines of a source buffer (e.g. a mapped file) stay in that buffer,
+// the table keeps only where they are; lines of a temporary text
+// are copied into one buffer of the table
+// - Lines that no token needs any more can be released, the indexes
+// of the other lines stay the same
+class LineTable
+{
+public:
+	LineTable();
+
+	// Adds a copy of the line, returns its index
+	unsigned AddLine(const char *text, size_t length, int lineNumber);
+	// Adds the line without copying it, returns its index
+	// - The text must outlive the table
+	unsigned AddExternalLine(const char *text, size_t length, int lineNumber);
+
+	// Makes line shorter (comments are cut off after the line was added)
+	void Truncate(unsigned index, size_t length);
+
+	// Returns text of the line
+	std::string GetLine(unsigned index) const;
+	// Returns pointer to the text of the line (not null-terminated)
+	const char *GetText(unsigned index) const;
+	size_t GetLength(unsigned index) const;
+	// Returns number of the line in source file
+	int GetLineNumber(unsigned index) const;
+
+	// Number of lines added, including the released ones
+	unsigned Count() const;
+
+	// Forgets the lines before index (e.g. of the tokens that a stream
+	// has dropped), their tokens can't get their text any more
+	// - Text of copied lines is freed only with the table
+	void Release(unsigned index);
+
+	// Appends all lines of other table, returns index of the first of them
+	// - Lines of other table mustn't be released
+	unsigned Append(const LineTable &other);
+
+private:
+	struct Line
+	{
+		// Null if the line is copied to m_text
+		const char *external;
+		size_t offset;
+		size_t length;
+		int number;
+	};
+
+	// Copied lines
+	std::string m_text;
+	// Lines from m_firstIndex on
+	std::deque<Line> m_lines;
+	unsigned m_firstIndex;
+};
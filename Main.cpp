@@ -1,47 +1,50 @@
 #include <iostream>
-#include <fstream>
 #include "Lexer.h"
+#include "MappedFile.h"
 #include "Token.h"
 #include "Exception.h"
 #include "Parser.h"
 #include "AssemblerTest.h"
+#include "AstCache.h"
 
 using namespace std;
 
+// Trees of unchanged sources are kept here between the runs
+const char AST_CACHE_DIRECTORY[] = "AstCache";
+
 void Compile(const string &filePath)
 {
-	ifstream is(filePath);
+	MappedFile source(filePath);
 
-	if (!is.is_open())
+	if (!source.IsOpen())
 	{
 		cout << "Cannot open file '" << filePath << "'\n";
 		return;
 	}
 
+	// A cached tree has no errors, the source is neither lexed nor parsed
+	AstCache cache(AST_CACHE_DIRECTORY);
+	shared_ptr<IAst> ast = cache.Load(source.GetData(), source.GetSize());
+	if (ast)
+	{
+		return;
+	}
+
 	Lexer lex;
-	vector<Token> tokens;
-	int lineNumber = 1;
+	TokenStream tokens(lex.ParseBuffer(source.GetData(), source.GetSize()));
 
-	while (!is.eof())
+	// All the errors of the program are reported at once
+	vector<CompileError> errors;
+	ast = ParseWithRecovery(tokens, errors);
+	for (const CompileError &error : errors)
 	{
-		string expr;
-
-		getline(is, expr);
-		if (expr.length() == 0)
-		{
-			continue;
-		}
-		
-		vector<Token> line = lex.ParseLine(expr, lineNumber++);
-		for (const Token &token : line)
-		{
-			tokens.push_back(token);
-			token.Print();
-			cout << endl;
+		cout << error.what() << endl;
+	}
 
-		}
+	if (errors.empty())
+	{
+		cache.Save(source.GetData(), source.GetSize(), *ast);
 	}
-	shared_ptr<IAst> ast = Parse(tokens);
 }
 
 int main(int argc, char *argv[])
@@ -0,0 +1,136 @@
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include "MappedFile.h"
+
+using namespace std;
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const string &fileName)
+	: m_isOpen(false)
+	, m_data(nullptr)
+	, m_size(0)
+	, m_file(INVALID_HANDLE_VALUE)
+	, m_mapping(NULL)
+{
+	m_file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+		OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (m_file == INVALID_HANDLE_VALUE)
+	{
+		return;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(m_file, &fileSize))
+	{
+		return;
+	}
+
+	m_size = static_cast<size_t>(fileSize.QuadPart);
+	if (m_size == 0)
+	{
+		// Empty files can't be mapped
+		m_isOpen = true;
+		return;
+	}
+
+	m_mapping = CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (m_mapping == NULL)
+	{
+		return;
+	}
+
+	m_data = static_cast<const char *>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+	m_isOpen = m_data != nullptr;
+}
+
+MappedFile::~MappedFile()
+{
+	if (m_data)
+	{
+		UnmapViewOfFile(m_data);
+	}
+	if (m_mapping != NULL)
+	{
+		CloseHandle(m_mapping);
+	}
+	if (m_file != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(m_file);
+	}
+}
+
+#else
+
+MappedFile::MappedFile(const string &fileName)
+	: m_isOpen(false)
+	, m_data(nullptr)
+	, m_size(0)
+	, m_file(-1)
+{
+	m_file = open(fileName.c_str(), O_RDONLY);
+	if (m_file == -1)
+	{
+		return;
+	}
+
+	struct stat fileInfo;
+	if (fstat(m_file, &fileInfo) != 0)
+	{
+		return;
+	}
+
+	m_size = static_cast<size_t>(fileInfo.st_size);
+	if (m_size == 0)
+	{
+		// Empty files can't be mapped
+		m_isOpen = true;
+		return;
+	}
+
+	void *data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_file, 0);
+	if (data == MAP_FAILED)
+	{
+		return;
+	}
+
+	madvise(data, m_size, MADV_SEQUENTIAL);
+	m_data = static_cast<const char *>(data);
+	m_isOpen = true;
+}
+
+MappedFile::~MappedFile()
+{
+	if (m_data)
+	{
+		munmap(const_cast<char *>(m_data), m_size);
+	}
+	if (m_file != -1)
+	{
+		close(m_file);
+	}
+}
+
+#endif
+
+bool MappedFile::IsOpen() const
+{
+	return m_isOpen;
+}
+
+const char *MappedFile::GetData() const
+{
+	return m_data;
+}
+
+size_t MappedFile::GetSize() const
+{
+	return m_size;
+}
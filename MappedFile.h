@@ -0,0 +1,33 @@
+#pragma once
+#include <string>
+
+// Read-only view of a whole file mapped into memory
+// - The contents are valid until the object is destroyed
+// - Empty file is opened successfully, GetData() returns nullptr for it
+class MappedFile
+{
+public:
+	MappedFile(const std::string &fileName);
+	~MappedFile();
+
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	// Returns false if the file couldn't be opened or mapped
+	bool IsOpen() const;
+
+	const char *GetData() const;
+	size_t GetSize() const;
+
+private:
+	bool m_isOpen;
+	const char *m_data;
+	size_t m_size;
+
+#ifdef _WIN32
+	void *m_file;
+	void *m_mapping;
+#else
+	int m_file;
+#endif
+};
@@ -1,6 +1,9 @@
 ﻿#include <memory>
-#include <set>
+#include <algorithm>
+#include <initializer_list>
 #include <iostream>
+#include <cstring>
+#include <climits>
 #include <assert.h>
 #include "TokenStream.h"
 #include "Exception.h"
@@ -9,9 +12,12 @@
 #include "Function.h"
 #include "Ast.h"
 #include "Constant.h"
+#include "AstContext.h"
+#include "Parser.h"
 
 #include "LL.h"
 #include "LR.h"
+#include "ThreadPool.h"
 
 /*
 -=-=-=- Backslash operator precedence -=-=-=-
@@ -38,43 +44,133 @@
 
 using namespace std;
 
+ParseResult::ParseResult(IAst *node)
+	: m_node(node)
+	, m_error(PARSE_ERROR::NONE)
+	, m_position(0)
+{
+	assert(!node->IsError());
+}
+
+ParseResult::ParseResult(PARSE_ERROR error, size_t position)
+	: m_node(AstError::INSTANCE)
+	, m_error(error)
+	, m_position(position)
+{
+	assert(error != PARSE_ERROR::NONE);
+}
+
+bool ParseResult::IsError() const
+{
+	return m_error != PARSE_ERROR::NONE;
+}
+
+IAst *ParseResult::Get() const
+{
+	return m_node;
+}
+
+IAst *ParseResult::operator->() const
+{
+	return m_node;
+}
+
+PARSE_ERROR ParseResult::GetError() const
+{
+	return m_error;
+}
+
+size_t ParseResult::GetPosition() const
+{
+	return m_position;
+}
+
+const char *ParseResult::GetMessage() const
+{
+	switch (m_error)
+	{
+	case PARSE_ERROR::NONE:
+		return "";
+	case PARSE_ERROR::EXPECTED_CONSTANT:
+		return "Expected constant";
+	case PARSE_ERROR::EXPECTED_VARIABLE:
+		return "Expected variable";
+	case PARSE_ERROR::EXPECTED_TYPE:
+		return "Expected type";
+	case PARSE_ERROR::EXPECTED_INDEX_R:
+		return "Expected ']'";
+	case PARSE_ERROR::EXPECTED_BRACE_L:
+		return "Expected '('";
+	case PARSE_ERROR::EXPECTED_BRACE_R:
+		return "Expected ')'";
+	case PARSE_ERROR::EXPECTED_EXPRESSION:
+		return "Expected expression";
+	case PARSE_ERROR::EXPECTED_ASSIGN:
+		return "Expected '='";
+	case PARSE_ERROR::EXPECTED_FUNCTION_NAME:
+		return "Expected function name";
+	case PARSE_ERROR::EXPECTED_STATEMENT:
+		return "Expected statement";
+	case PARSE_ERROR::EXPECTED_DEFINITION:
+		// Anything that isn't a definition at the top level
+		return "Syntax error";
+	default:
+		throw InternalError("Invalid PARSE_ERROR");
+	}
+}
+
+// Rule doesn't match at the current token
+ParseResult Fail(const TokenStream &tk, PARSE_ERROR error)
+{
+	return ParseResult(error, tk.GetPosition());
+}
+
+// Rule doesn't match at the current token, the stream goes back
+// to the position saved at the start of the rule
+ParseResult Backtrack(TokenStream &tk, PARSE_ERROR error)
+{
+	ParseResult result(error, tk.GetPosition());
+	tk.RestorePosition();
+	return result;
+}
+
 // simple_const: IntNumber | FpNumber | String
-shared_ptr<IAst> ParseConst(TokenStream &tk)
+ParseResult ParseConst(TokenStream &tk)
 {
-	TOKEN_TYPE tokenType = tk.Current().GetType();
+	TOKEN_TYPE tokenType = tk.CurrentType();
 	switch (tokenType)
 	{
 	case TOKEN_TYPE::TOKEN_FLOAT:
 		{
-			auto result = make_shared<AstFloatConst>(tk.Current().GetValueF());
+			auto result = tk.GetAstContext().MakeExpression<AstFloatConst>(tk.Current().GetValueF());
 			tk.Forward();
 			return result;
 		}
 	case TOKEN_TYPE::TOKEN_STRING:
 		{
-			auto result = make_shared<AstStringConst>(tk.Current().GetValueS());
+			auto result = tk.GetAstContext().MakeExpression<AstStringConst>(tk.Current().GetValueS());
 			tk.Forward();
 			return result;
 		}
 	case TOKEN_TYPE::TOKEN_INT:
 		{
-			auto result = make_shared<AstIntConst>(tk.Current().GetValueI());
+			auto result = tk.GetAstContext().MakeExpression<AstIntConst>(tk.Current().GetValueI());
 			tk.Forward();
 			return result;
 		}
 	default:
-		return make_shared<AstError>();
+		return Fail(tk, PARSE_ERROR::EXPECTED_CONSTANT);
 	}
 }
 
 bool ParseSimpleType(TokenStream &tk, ATOMIC_TYPE &varType)
 {
-	if (tk.Current().GetType() != TOKEN_DELIMETER)
+	if (tk.CurrentType() != TOKEN_DELIMETER)
 	{
 		return false;
 	}
 
-	KEYWORD typeKeyword = tk.Current().GetValueK();
+	KEYWORD typeKeyword = tk.CurrentKeyword();
 	switch (typeKeyword)
 	{
 	case KW_STRING:
@@ -97,60 +193,87 @@ bool ParseSimpleType(TokenStream &tk, ATOMIC_TYPE &varType)
 	return true;
 }
 
+// Checks if the token ahead positions after the current one is a simple_type
+bool IsSimpleTypeAhead(const TokenStream &tk, size_t ahead)
+{
+	return tk.PeekType(ahead) == TOKEN_DELIMETER &&
+		(tk.PeekKeyword(ahead, KW_STRING) || tk.PeekKeyword(ahead, KW_INT) ||
+		tk.PeekKeyword(ahead, KW_FLOAT) || tk.PeekKeyword(ahead, KW_BOOL));
+}
+
+// Checks if the tokens starting with the current id are a call
+// - The name of the function is skipped the way ParseFunctionName()
+// reads it: id <type <('[' ']')+ | type '(' ')'>>, call has '(' after it
+bool IsCall(const TokenStream &tk)
+{
+	size_t ahead = 1;
+	if (IsSimpleTypeAhead(tk, ahead))
+	{
+		ahead++;
+		if (IsSimpleTypeAhead(tk, ahead) && tk.PeekKeyword(ahead + 1, KW_BRACE_L) &&
+			tk.PeekKeyword(ahead + 2, KW_BRACE_R))
+		{
+			ahead += 3;
+		}
+		while (tk.PeekKeyword(ahead, KW_INDEX_L) && tk.PeekKeyword(ahead + 1, KW_INDEX_R))
+		{
+			ahead += 2;
+		}
+	}
+	return tk.PeekKeyword(ahead, KW_BRACE_L);
+}
+
 // simple_variable: id simple_type
-shared_ptr<IAst> ParseSimpleVariable(TokenStream &tk)
+ParseResult ParseSimpleVariable(TokenStream &tk)
 {
-	if (tk.Current().GetType() != TOKEN_ID)
+	if (tk.CurrentType() != TOKEN_ID)
 	{
-		return make_shared<AstError>();
+		return Fail(tk, PARSE_ERROR::EXPECTED_VARIABLE);
 	}
 
 	tk.PushPosition();
 
-	const string &varName = tk.Current().GetValueS();
+	Atom varName = tk.Current().GetValueA();
 	tk.Forward();
 
 	ATOMIC_TYPE varType;
 	if (!ParseSimpleType(tk, varType))
 	{
-		tk.RestorePosition();
-		return make_shared<AstError>();
+		return Backtrack(tk, PARSE_ERROR::EXPECTED_TYPE);
 	}
 
 	tk.PopPosition();
 
 	// TODO: check if varName is a const
-	return make_shared<AstVariable>(varName, DataType(varType));
+	return tk.GetAstContext().MakeExpression<AstVariable>(varName, DataType(varType));
 }
 
 // array_decl: id simple_type ('[' ']')+
-shared_ptr<IAst> ParseArrayDecl(TokenStream &tk)
+ParseResult ParseArrayDecl(TokenStream &tk)
 {
-	if (tk.Current().GetType() != TOKEN_ID)
+	if (tk.CurrentType() != TOKEN_ID)
 	{
-		return make_shared<AstError>();
+		return Fail(tk, PARSE_ERROR::EXPECTED_VARIABLE);
 	}
 
 	tk.PushPosition();
 
-	const string &varName = tk.Current().GetValueS();
+	Atom varName = tk.Current().GetValueA();
 	tk.Forward();
 
 	ATOMIC_TYPE varType;
 	if (!ParseSimpleType(tk, varType))
 	{
-		tk.RestorePosition();
-		return make_shared<AstError>();
+		return Backtrack(tk, PARSE_ERROR::EXPECTED_TYPE);
 	}
 
 	unsigned dimension = 0;
-	while (tk.Current().IsKeyword(KW_INDEX_L))
+	while (tk.IsKeyword(KW_INDEX_L))
 	{
 		tk.Forward();
-		if (!tk.Current().IsKeyword(KW_INDEX_R))
+		if (!tk.IsKeyword(KW_INDEX_R))
 		{
-			tk.RestorePosition();
-			return make_shared<AstError>();
+			return Backtrack(tk, PARSE_ERROR::EXPECTED_INDEX_R);
 		}
 		tk.Forward();
 		dimension++;
@@ -158,104 +281,100 @@ shared_ptr<IAst> ParseArrayDecl(TokenStream &tk)
 
 	if (dimension == 0)
 	{
-		tk.RestorePosition();
-		return make_shared<AstError>();
+		return Backtrack(tk, PARSE_ERROR::EXPECTED_VARIABLE);
 	}
 
 	tk.PopPosition();
 
-	return make_shared<AstVariable>(varName, DataType(dimension, varType));
+	return tk.GetAstContext().MakeExpression<AstVariable>(varName, DataType(dimension, varType));
 }
 
-shared_ptr<IAst> ParseExpression(TokenStream &tk);
+ParseResult ParseExpression(TokenStream &tk);
 
 // DictDecl: id SimpleType SimpleType '(' ')'
 // DictValue: id SimpleType SimpleType '(' Expression ')'
-shared_ptr<IAst> ParseDict(TokenStream &tk, bool parseKey = false)
+ParseResult ParseDict(TokenStream &tk, bool parseKey = false)
 {
-	if (tk.Current().GetType() != TOKEN_ID)
+	if (tk.CurrentType() != TOKEN_ID)
 	{
-		return make_shared<AstError>();
+		return Fail(tk, PARSE_ERROR::EXPECTED_VARIABLE);
 	}
 
 	tk.PushPosition();
 
-	const string &varName = tk.Current().GetValueS();
+	Atom varName = tk.Current().GetValueA();
 	tk.Forward();
 
 	ATOMIC_TYPE keyType, valueType;
 	if (!ParseSimpleType(tk, keyType) || !ParseSimpleType(tk, valueType))
 	{
-		tk.RestorePosition();
-		return make_shared<AstError>();
+		return Backtrack(tk, PARSE_ERROR::EXPECTED_TYPE);
 	}
 
-	if (!tk.Current().IsKeyword(KW_BRACE_L))
+	if (!tk.IsKeyword(KW_BRACE_L))
 	{
-		tk.RestorePosition();
-		return make_shared<AstError>();
+		return Backtrack(tk, PARSE_ERROR::EXPECTED_BRACE_L);
 	}
 	tk.Forward();
 
-	shared_ptr<IAst> key;
+	IAst *key;
 	if (parseKey)
 	{
-		key = ParseExpression(tk);
-		if (key->IsError())
+		ParseResult keyResult = ParseExpression(tk);
+		if (keyResult.IsError())
 		{
 			tk.RestorePosition();
-			return make_shared<AstError>();
+			return keyResult;
 		}
+		key = keyResult.Get();
 	}
 
-	if (!tk.Current().IsKeyword(KW_BRACE_R))
+	if (!tk.IsKeyword(KW_BRACE_R))
 	{
-		tk.RestorePosition();
-		return make_shared<AstError>();
+		return Backtrack(tk, PARSE_ERROR::EXPECTED_BRACE_R);
 	}
 	tk.Forward();
 
 	tk.PopPosition();
 	if (parseKey)
 	{
-		return make_shared<AstDictValue>(varName, keyType, valueType, key);
+		return tk.GetAstContext().Make<AstDictValue>(varName, keyType, valueType, key);
 	}
 	else
 	{
-		return make_shared<AstVariable>(varName, DataType(keyType, valueType));
+		return tk.GetAstContext().MakeExpression<AstVariable>(varName, DataType(keyType, valueType));
 	}
 }
 
 // variable: dict_decl | array_decl | simple_variable
-shared_ptr<IAst> ParseVariableRDP(TokenStream &tk)
+IAst *ParseVariableRDP(TokenStream &tk)
 {
-	shared_ptr<IAst> result = ParseDict(tk);
-	if (!result->IsError())
+	ParseResult result = ParseDict(tk);
+	if (!result.IsError())
 	{
-		return result;
+		return result.Get();
 	}
 
 	result = ParseArrayDecl(tk);
-	if (!result->IsError())
+	if (!result.IsError())
 	{
-		return result;
+		return result.Get();
 	}
 
-	return ParseSimpleVariable(tk);
+	return ParseSimpleVariable(tk).Get();
 }
 
-shared_ptr<IAst> ParseVariable(TokenStream &tk)
+ParseResult ParseVariable(TokenStream &tk)
 {
-	return ParseVariableLR(tk);
-
+	IAst *result = ParseVariableLR(tk);
+	if (result->IsError())
+	{
+		return Fail(tk, PARSE_ERROR::EXPECTED_VARIABLE);
+	}
+	return result;
 }
 
-shared_ptr<IAst> ParseAndExpression(TokenStream &tk);
-shared_ptr<IAst> ParseEqualityExpression(TokenStream &tk);
-shared_ptr<IAst> ParseComparisonExpression(TokenStream &tk);
-shared_ptr<IAst> ParseAdditiveExpression(TokenStream &tk);
-shared_ptr<IAst> ParseMultiplicativeExpression(TokenStream &tk);
-shared_ptr<IAst> ParsePrimary(TokenStream &tk);
+ParseResult ParsePrimary(TokenStream &tk);
 
 /*
   applied to int, 'or' and 'and' are bitwise
@@ -274,16 +393,16 @@ shared_ptr<IAst> ParsePrimary(TokenStream &tk);
   dict       - |  -  |  - |  - | - | -  | - | -  | - | - | - | - |  -  | - |  -
 */
 
-typedef shared_ptr<IAst> (*OPTIMIZE_FUNCT)(AstExpression *left, AstExpression *right);
+typedef IAst *(*OPTIMIZE_FUNCT)(AstContext &context, AstExpression *left, AstExpression *right);
 typedef pair<DATA_TYPE, KEYWORD> TypeOpPair;
 map<TypeOpPair, OPTIMIZE_FUNCT> OperatorMap;
 
 #define DEFINE_CALC_FUNCT(FUNCT_NAME, CALC_OPERATOR, RETURN_TYPE) \
-	template<class CONST_TYPE> shared_ptr<IAst> FUNCT_NAME(AstExpression *left, AstExpression *right) \
+	template<class CONST_TYPE> IAst *FUNCT_NAME(AstContext &context, AstExpression *left, AstExpression *right) \
 	{ \
-		auto LeftConst = dynamic_cast<CONST_TYPE*>(left); \
-		auto RightConst = dynamic_cast<CONST_TYPE*>(right); \
-		return make_shared<RETURN_TYPE>(LeftConst->GetValue() CALC_OPERATOR RightConst->GetValue()); \
+		auto LeftConst = Cast<CONST_TYPE>(left); \
+		auto RightConst = Cast<CONST_TYPE>(right); \
+		return context.MakeExpression<RETURN_TYPE>(LeftConst->GetValue() CALC_OPERATOR RightConst->GetValue()); \
 	}
 
 DEFINE_CALC_FUNCT(CalcBitwiseOr, |, AstIntConst)
@@ -301,20 +420,54 @@ DEFINE_CALC_FUNCT(CalcGreaterEq, >=, AstBoolConst)
 DEFINE_CALC_FUNCT(CalcPlus, +, CONST_TYPE)
 DEFINE_CALC_FUNCT(CalcMinus, -, CONST_TYPE)
 DEFINE_CALC_FUNCT(CalcMul, *, CONST_TYPE)
-DEFINE_CALC_FUNCT(CalcMod, %, CONST_TYPE)
+
+// INT_MIN / -1 overflows, the machine division traps on it
+inline bool IsMinIntByMinusOne(int left, int right)
+{
+	return left == INT_MIN && right == -1;
+}
+
+inline bool IsMinIntByMinusOne(double left, double right)
+{
+	return false;
+}
 
 //DEFINE_CALC_FUNCT(CalcDiv, /, CONST_TYPE)
-template<class CONST_TYPE> shared_ptr<IAst> CalcDiv(AstExpression *left, AstExpression *right)
+template<class CONST_TYPE> IAst *CalcDiv(AstContext &context, AstExpression *left, AstExpression *right)
 {
-	auto LeftConst = dynamic_cast<CONST_TYPE*>(left);
-	auto RightConst = dynamic_cast<CONST_TYPE*>(right);
+	auto LeftConst = Cast<CONST_TYPE>(left);
+	auto RightConst = Cast<CONST_TYPE>(right);
 
 	if (RightConst->GetValue() == 0)
 	{
 		throw IntermediateError("Division by zero");
 	}
+	if (IsMinIntByMinusOne(LeftConst->GetValue(), RightConst->GetValue()))
+	{
+		// ~2147483648 / ~1 doesn't fit into int
+		throw IntermediateError("Integer overflow");
+	}
 
-	return make_shared<CONST_TYPE>(LeftConst->GetValue() / RightConst->GetValue());
+	return context.MakeExpression<CONST_TYPE>(LeftConst->GetValue() / RightConst->GetValue());
+}
+
+//DEFINE_CALC_FUNCT(CalcMod, %, CONST_TYPE)
+template<class CONST_TYPE> IAst *CalcMod(AstContext &context, AstExpression *left, AstExpression *right)
+{
+	auto LeftConst = Cast<CONST_TYPE>(left);
+	auto RightConst = Cast<CONST_TYPE>(right);
+
+	if (RightConst->GetValue() == 0)
+	{
+		throw IntermediateError("Division by zero");
+	}
+	if (IsMinIntByMinusOne(LeftConst->GetValue(), RightConst->GetValue()))
+	{
+		// The remainder is 0, but the machine division traps
+		return context.MakeExpression<CONST_TYPE>(0);
+	}
+
+	return context.MakeExpression<CONST_TYPE>(LeftConst->GetValue() % RightConst->GetValue());
 }
 
 void InitOperatorMap()
@@ -432,15 +585,15 @@ string FormatInvalidOpError(KEYWORD op, const DataType &dataType)
 
 // Performs various checks to make sure binary expression is valid
 // Optimizes it if possible
-shared_ptr<IAst> CreateBinaryExpression(shared_ptr<IAst> left, KEYWORD op, shared_ptr<IAst> right)
+IAst *CreateBinaryExpression(AstContext &context, IAst *left, KEYWORD op, IAst *right)
 {
 	if (!left->IsExpression() || !right->IsExpression())
 	{
 		throw InternalError("Attempt to create AstBinaryExpression from non AstExpression based node");
 	}
 
-	AstExpression *leftEx = dynamic_cast<AstExpression*>(left.get());
-	AstExpression *rightEx = dynamic_cast<AstExpression*>(right.get());
+	AstExpression *leftEx = Cast<AstExpression>(left);
+	AstExpression *rightEx = Cast<AstExpression>(right);
 
 	if (leftEx->GetType() != rightEx->GetType())
 	{
@@ -458,22 +611,22 @@ shared_ptr<IAst> CreateBinaryExpression(shared_ptr<IAst> left, KEYWORD op, share
 	// by calculating the result at compile time
 	if (left->IsConstant() && right->IsConstant())
 	{
-		return OperatorMap.at(exprQualifier)(leftEx, rightEx);
+		return OperatorMap.at(exprQualifier)(context, leftEx, rightEx);
 	}
 	// Boolean operators can be optimized if at least one operand is constant
 	else if (exprType == DATA_TYPE::TYPE_BOOL && (left->IsConstant() || right->IsConstant()))
 	{
-		shared_ptr<IAst> dynamicPart;
+		IAst *dynamicPart;
 		AstBoolConst *constPart;
 
 		if (left->IsConstant())
 		{
-			constPart = dynamic_cast<AstBoolConst*>(leftEx);
+			constPart = Cast<AstBoolConst>(leftEx);
 			dynamicPart = right;
 		}
 		else
 		{
-			constPart = dynamic_cast<AstBoolConst*>(rightEx);
+			constPart = Cast<AstBoolConst>(rightEx);
 			dynamicPart = left;
 		}
 
@@ -487,7 +640,7 @@ shared_ptr<IAst> CreateBinaryExpression(shared_ptr<IAst> left, KEYWORD op, share
 			else
 			{
 				// FALSE AND A == FALSE
-				return make_shared<AstBoolConst>(false);
+				return context.MakeExpression<AstBoolConst>(false);
 			}
 		}
 		else if (op == KW_OR)
@@ -495,7 +648,7 @@ shared_ptr<IAst> CreateBinaryExpression(shared_ptr<IAst> left, KEYWORD op, share
 			if (constPart->GetValue() == true)
 			{
 				// TRUE OR A == TRUE
-				return make_shared<AstBoolConst>(true);
+				return context.MakeExpression<AstBoolConst>(true);
 			}
 			else
 			{
@@ -506,12 +659,12 @@ shared_ptr<IAst> CreateBinaryExpression(shared_ptr<IAst> left, KEYWORD op, share
 	}
 
 	// Otherwise we return binary expression as it is
-	return make_shared<AstBinaryExpression>(left, op, right);
+	return context.MakeExpression<AstBinaryExpression>(left, op, right);
 }
 
-shared_ptr<IAst> CreateUnaryExpression(KEYWORD op, shared_ptr<IAst> ast_expr)
+IAst *CreateUnaryExpression(AstContext &context, KEYWORD op, IAst *ast_expr)
 {
-	AstExpression *expr = dynamic_cast<AstExpression*>(ast_expr.get());
+	AstExpression *expr = Cast<AstExpression>(ast_expr);
 
 	switch (op)
 	{
@@ -521,15 +674,15 @@ shared_ptr<IAst> CreateUnaryExpression(KEYWORD op, shared_ptr<IAst> ast_expr)
 		case DATA_TYPE::TYPE_INT:
 			if (expr->IsConstant())
 			{
-				AstIntConst *intConst = dynamic_cast<AstIntConst*>(expr);
-				return make_shared<AstIntConst>(-intConst->GetValue());
+				AstIntConst *intConst = Cast<AstIntConst>(expr);
+				return context.MakeExpression<AstIntConst>(-intConst->GetValue());
 			}
 			break;
 		case DATA_TYPE::TYPE_FLOAT:
 			if (expr->IsConstant())
 			{
-				AstFloatConst *floatConst = dynamic_cast<AstFloatConst*>(expr);
-				return make_shared<AstFloatConst>(-floatConst->GetValue());
+				AstFloatConst *floatConst = Cast<AstFloatConst>(expr);
+				return context.MakeExpression<AstFloatConst>(-floatConst->GetValue());
 			}
 			break;
 		default:
@@ -543,125 +696,110 @@ shared_ptr<IAst> CreateUnaryExpression(KEYWORD op, shared_ptr<IAst> ast_expr)
 		}
 		if (expr->IsConstant())
 		{
-			AstBoolConst *boolConst = dynamic_cast<AstBoolConst*>(expr);
-			return make_shared<AstBoolConst>(!boolConst->GetValue());
+			AstBoolConst *boolConst = Cast<AstBoolConst>(expr);
+			return context.MakeExpression<AstBoolConst>(!boolConst->GetValue());
 		}
 		break;
 	default:
 		throw InternalError("Invalid operator for AstUnaryExpression");
 	}
 
-	return make_shared<AstUnaryExpression>(op, ast_expr);
+	return context.MakeExpression<AstUnaryExpression>(op, ast_expr);
 }
 
-typedef shared_ptr<IAst> (*PARSE_FUNCT)(TokenStream &tk);
-// BinaryExpression: parseNext ( {acceptableTokens} parseNext )+
-shared_ptr<IAst> ParseBinaryExpression(TokenStream &tk, const set<KEYWORD> &acceptableTokens, PARSE_FUNCT parseNext)
+typedef ParseResult (*PARSE_FUNCT)(TokenStream &tk);
+
+// Binding powers of the binary operators, 0 for the other keywords
+// - Operator with higher power binds tighter: or < and < equality <
+// comparison < additive < multiplicative, all of them are left associative
+class BindingPowerTable
 {
-	tk.PushPosition();
+public:
+	BindingPowerTable()
+	{
+		fill(m_power, m_power + KEYWORD_COUNT, 0);
 
-	shared_ptr<IAst> left = parseNext(tk);
-	if (left->IsError())
+		m_power[KW_OR] = 1;
+		m_power[KW_AND] = 2;
+		m_power[KW_EQUAL] = m_power[KW_NOT_EQ] = 3;
+		m_power[KW_LESS] = m_power[KW_LE_EQ] = m_power[KW_GREATER] = m_power[KW_GR_EQ] = 4;
+		m_power[KW_PLUS] = m_power[KW_MINUS] = 5;
+		m_power[KW_MUL] = m_power[KW_DIV] = m_power[KW_MOD] = 6;
+	}
+
+	// Binding power of the current token
+	int Get(const TokenStream &tk) const
+	{
+		TOKEN_TYPE type = tk.CurrentType();
+		if (type != TOKEN_DELIMETER && type != TOKEN_KEYWORD)
+		{
+			return 0;
+		}
+		return m_power[tk.CurrentKeyword()];
+	}
+
+private:
+	int m_power[KEYWORD_COUNT];
+};
+
+const BindingPowerTable BINDING_POWERS;
+
+// BinaryExpression: Primary ( operator Primary )*
+// - Operators with binding power less than minPower are left to the caller
+// - If there is no operand after an operator, the expression ends before
+// the operator and stop is set, so the callers don't try it again
+ParseResult ParseBinaryExpression(TokenStream &tk, int minPower, bool &stop)
+{
+	ParseResult left = ParsePrimary(tk);
+	if (left.IsError())
 	{
-		tk.RestorePosition();
 		return left;
 	}
 
-	while ((tk.Current().GetType() == TOKEN_DELIMETER ||
-		tk.Current().GetType() == TOKEN_KEYWORD) && 
-		(acceptableTokens.find(tk.Current().GetValueK()) != acceptableTokens.end()))
+	int power;
+	while (!stop && (power = BINDING_POWERS.Get(tk)) >= minPower)
 	{
-		tk.PopPosition();
 		tk.PushPosition();
 
-		KEYWORD op = tk.Current().GetValueK();
+		KEYWORD op = tk.CurrentKeyword();
 		tk.Forward();
 
-		shared_ptr<IAst> right = parseNext(tk);
-		if (right->IsError())
+		ParseResult right = ParseBinaryExpression(tk, power + 1, stop);
+		if (right.IsError())
 		{
 			tk.RestorePosition();
-			return left;
-		}
-		else
-		{
-			left = CreateBinaryExpression(left, op, right);
+			stop = true;
+			break;
 		}
+
+		tk.PopPosition();
+		left = CreateBinaryExpression(tk.GetAstContext(), left.Get(), op, right.Get());
 	}
 
-	tk.PopPosition();
 	return left;
 }
 
-// Expression: OrExpression | OpNew
-// Expression: AndExpression < 'or' Expression >
-shared_ptr<IAst> ParseExpression(TokenStream &tk)
+// Expression: Primary ( ( 'or' | 'and' | '==' | '<>' | '<' | '<=' | '>' | '>=' |
+//		'+' | '-' | '*' | '/' | 'mod' ) Primary )*
+ParseResult ParseExpression(TokenStream &tk)
 {
-	set<KEYWORD> tokens;
-	tokens.insert(KW_OR);
-	return ParseBinaryExpression(tk, tokens, &ParseAndExpression);
+	bool stop = false;
+	return ParseBinaryExpression(tk, 1, stop);
 }
 
-// AndExpression: EqualityExpression < 'and' Expression >
-shared_ptr<IAst> ParseAndExpression(TokenStream &tk)
-{
-	set<KEYWORD> tokens;
-	tokens.insert(KW_AND);
-	return ParseBinaryExpression(tk, tokens, &ParseEqualityExpression);
-}
-
-// EqualityExpression: ComparisonExpression < ( '==' | '<>' ) Expression >
-shared_ptr<IAst> ParseEqualityExpression(TokenStream &tk)
-{
-	set<KEYWORD> tokens;
-	tokens.insert(KW_EQUAL);
-	tokens.insert(KW_NOT_EQ);
-	return ParseBinaryExpression(tk, tokens, &ParseComparisonExpression);
-}
-
-// ComparisonExpression: AdditiveExpression < ( '<' | '<=' |  '>' | '>=' ) Expression >
-shared_ptr<IAst> ParseComparisonExpression(TokenStream &tk)
-{
-	set<KEYWORD> tokens;
-	tokens.insert(KW_LESS);
-	tokens.insert(KW_GREATER);
-	tokens.insert(KW_GR_EQ);
-	tokens.insert(KW_LE_EQ);
-	return ParseBinaryExpression(tk, tokens, &ParseAdditiveExpression);
-}
-
-// AdditiveExpression: MultiplicativeExpression < ( '+' | '-' ) Expression >
-shared_ptr<IAst> ParseAdditiveExpression(TokenStream &tk)
-{
-	set<KEYWORD> tokens;
-	tokens.insert(KW_PLUS);
-	tokens.insert(KW_MINUS);
-	return ParseBinaryExpression(tk, tokens, &ParseMultiplicativeExpression);
-}
-
-// MultiplicativeExpression: Primary < ( '*' | '/' | 'mod' ) Expression >
-shared_ptr<IAst> ParseMultiplicativeExpression(TokenStream &tk)
-{
-	set<KEYWORD> tokens;
-	tokens.insert(KW_MUL);
-	tokens.insert(KW_DIV);
-	tokens.insert(KW_MOD);
-	return ParseBinaryExpression(tk, tokens, &ParsePrimary);
-}
-
-shared_ptr<AstList> ParseCommaSeparatedList(TokenStream &tk, PARSE_FUNCT parseElement);
+AstList *ParseCommaSeparatedList(TokenStream &tk, PARSE_FUNCT parseElement);
 
 // new array%(10, 10, 20)
 // new dict$%()
-shared_ptr<IAst> ParseNewRDP(TokenStream &tk)
+IAst *ParseNewRDP(TokenStream &tk)
 {
-	if (!tk.Current().IsKeyword(KW_NEW))
+	if (!tk.IsKeyword(KW_NEW))
 	{
-		return make_shared<AstError>();
+		return AstError::INSTANCE;
 	}
 	tk.Forward();
 
-	if (tk.Current().IsKeyword(KW_ARRAY))
+	if (tk.IsKeyword(KW_ARRAY))
 	{
 		tk.Forward();
 		
@@ -671,7 +809,7 @@ shared_ptr<IAst> ParseNewRDP(TokenStream &tk)
 			throw IntermediateError("Expected array type");
 		}
 
-		if (!tk.Current().IsKeyword(KW_BRACE_L))
+		if (!tk.IsKeyword(KW_BRACE_L))
 		{
 			throw IntermediateError("Expected '('");
 		}
@@ -684,15 +822,15 @@ shared_ptr<IAst> ParseNewRDP(TokenStream &tk)
 			throw IntermediateError("Only 1,2,3 and 4-dimension arrays are supported");
 		}
 
-		if (!tk.Current().IsKeyword(KW_BRACE_R))
+		if (!tk.IsKeyword(KW_BRACE_R))
 		{
 			throw IntermediateError("Expected ')'");
 		}
 		tk.Forward();
 
-		return make_shared<AstNewArray>(dataType, dimensions);
+		return tk.GetAstContext().Make<AstNewArray>(dataType, dimensions);
 	}
-	else if (tk.Current().IsKeyword(KW_DICT))
+	else if (tk.IsKeyword(KW_DICT))
 	{
 		tk.Forward();
 
@@ -702,19 +840,19 @@ shared_ptr<IAst> ParseNewRDP(TokenStream &tk)
 			throw IntermediateError("Expected key type and value type");
 		}
 
-		if (!tk.Current().IsKeyword(KW_BRACE_L))
+		if (!tk.IsKeyword(KW_BRACE_L))
 		{
 			throw IntermediateError("Expected '('");
 		}
 		tk.Forward();
 
-		if (!tk.Current().IsKeyword(KW_BRACE_R))
+		if (!tk.IsKeyword(KW_BRACE_R))
 		{
 			throw IntermediateError("Expected ')'");
 		}
 		tk.Forward();
 
-		return make_shared<AstNewDict>(keyType, valueType);
+		return tk.GetAstContext().Make<AstNewDict>(keyType, valueType);
 	}
 	else
 	{
@@ -722,44 +860,43 @@ shared_ptr<IAst> ParseNewRDP(TokenStream &tk)
 	}
 }
 
-shared_ptr<IAst> ParseCall(TokenStream &tk, bool discardResult);
+ParseResult ParseCall(TokenStream &tk, bool discardResult);
 
 // arr%[0][1]
 // id SimpleType ('[' Expression ']')+
-shared_ptr<IAst> ParseArrayValue(TokenStream &tk)
+ParseResult ParseArrayValue(TokenStream &tk)
 {
-	if (tk.Current().GetType() != TOKEN_ID)
+	if (tk.CurrentType() != TOKEN_ID)
 	{
-		return make_shared<AstError>();
+		return Fail(tk, PARSE_ERROR::EXPECTED_VARIABLE);
 	}
 
 	tk.PushPosition();
 
-	const string &arrayName = tk.Current().GetValueS();
+	Atom arrayName = tk.Current().GetValueA();
 	tk.Forward();
 
 	ATOMIC_TYPE arrayType;
 	if (!ParseSimpleType(tk, arrayType))
 	{
-		tk.RestorePosition();
-		return make_shared<AstError>();
+		return Backtrack(tk, PARSE_ERROR::EXPECTED_TYPE);
 	}
 
-	auto indexes = make_shared<AstList>();
+	auto indexes = tk.GetAstContext().Make<AstList>();
 
-	while (tk.Current().IsKeyword(KW_INDEX_L))
+	while (tk.IsKeyword(KW_INDEX_L))
 	{
 		tk.Forward();
 
-		auto expr = ParseExpression(tk);
-		if (expr->IsError())
+		ParseResult expr = ParseExpression(tk);
+		if (expr.IsError())
 		{
 			tk.RestorePosition();
-			return make_shared<AstError>();
+			return expr;
 		}
-		indexes->AddElement(expr);
+		indexes->AddElement(expr.Get());
 
-		if (!tk.Current().IsKeyword(KW_INDEX_R))
+		if (!tk.IsKeyword(KW_INDEX_R))
 		{
 			throw IntermediateError("Expected ']'");
 		}
@@ -768,22 +905,21 @@ shared_ptr<IAst> ParseArrayValue(TokenStream &tk)
 	
 	if (indexes->GetElements().size() == 0)
 	{
-		tk.RestorePosition();
-		return make_shared<AstError>();
+		return Backtrack(tk, PARSE_ERROR::EXPECTED_VARIABLE);
 	}
 
 	tk.PopPosition();
-	return make_shared<AstArrayValue>(arrayName, arrayType, indexes);
+	return tk.GetAstContext().Make<AstArrayValue>(arrayName, arrayType, indexes);
 }
 
 // Primary: '(' Expression ')' | '~' Primary | 'not' Expression | Const | Variable | Call | New
 // ArrayValue | DictValue
-shared_ptr<IAst> ParsePrimary(TokenStream &tk)
+ParseResult ParsePrimary(TokenStream &tk)
 {
-	if (tk.Current().GetType() == TOKEN_DELIMETER || 
-		tk.Current().GetType() == TOKEN_KEYWORD)
+	if (tk.CurrentType() == TOKEN_DELIMETER || 
+		tk.CurrentType() == TOKEN_KEYWORD)
 	{
-		KEYWORD currentKw = tk.Current().GetValueK();
+		KEYWORD currentKw = tk.CurrentKeyword();
 		switch (currentKw)
 		{
 		case KW_UNARY_MINUS:
@@ -791,25 +927,25 @@ shared_ptr<IAst> ParsePrimary(TokenStream &tk)
 			{
 				tk.Forward();
 
-				shared_ptr<IAst> expr = currentKw == KW_UNARY_MINUS ? ParsePrimary(tk) : ParseExpression(tk);
-				if (expr->IsError())
+				ParseResult expr = currentKw == KW_UNARY_MINUS ? ParsePrimary(tk) : ParseExpression(tk);
+				if (expr.IsError())
 				{
 					throw IntermediateError("Expected expression");
 				}
 
-				return CreateUnaryExpression(currentKw, expr);
+				return CreateUnaryExpression(tk.GetAstContext(), currentKw, expr.Get());
 			}
 		case KW_BRACE_L:
 			{
 				tk.Forward();
 
-				shared_ptr<IAst> expr = ParseExpression(tk);
-				if (expr->IsError())
+				ParseResult expr = ParseExpression(tk);
+				if (expr.IsError())
 				{
 					throw IntermediateError("Expected expression");
 				}
 
-				if (!tk.Current().IsKeyword(KW_BRACE_R))
+				if (!tk.IsKeyword(KW_BRACE_R))
 				{
 					throw IntermediateError("Expected closing brace ')'");
 				}
@@ -821,197 +957,215 @@ shared_ptr<IAst> ParsePrimary(TokenStream &tk)
 		}
 	}
 
-	shared_ptr<IAst> result = ParseCall(tk, false);
-	if (!result->IsError())
+	switch (tk.CurrentType())
 	{
-		return result;
-	}
-
-	result = ParseDict(tk, true);
-	if (!result->IsError())
-	{
-		return result;
+	case TOKEN_INT:
+	case TOKEN_FLOAT:
+	case TOKEN_STRING:
+		return ParseConst(tk);
+	case TOKEN_KEYWORD:
+		{
+			IAst *result = LLParseNew(tk);
+			if (result->IsError())
+			{
+				return Fail(tk, PARSE_ERROR::EXPECTED_EXPRESSION);
+			}
+			return result;
+		}
+	case TOKEN_ID:
+		break;
+	default:
+		return Fail(tk, PARSE_ERROR::EXPECTED_EXPRESSION);
 	}
 
-	result = ParseArrayValue(tk);
-	if (!result->IsError())
+	// Only the rules that may start with the tokens ahead are tried
+	if (IsCall(tk))
 	{
-		return result;
+		ParseResult result = ParseCall(tk, false);
+		if (!result.IsError())
+		{
+			return result;
+		}
 	}
 
-	result = LLParseNew(tk);
-	if (!result->IsError())
+	if (IsSimpleTypeAhead(tk, 1) && IsSimpleTypeAhead(tk, 2) && tk.PeekKeyword(3, KW_BRACE_L))
 	{
-		return result;
+		ParseResult result = ParseDict(tk, true);
+		if (!result.IsError())
+		{
+			return result;
+		}
 	}
 
-	result = ParseVariable(tk);
-	if (!result->IsError())
+	if (IsSimpleTypeAhead(tk, 1) && tk.PeekKeyword(2, KW_INDEX_L))
 	{
-		return result;
+		ParseResult result = ParseArrayValue(tk);
+		if (!result.IsError())
+		{
+			return result;
+		}
 	}
 
-	return ParseConst(tk);
+	return ParseVariable(tk);
 }
 
 // ArrayAssign: ArrayValue = Expression
-shared_ptr<IAst> ParseArrayAssignment(TokenStream &tk)
+ParseResult ParseArrayAssignment(TokenStream &tk)
 {
 	tk.PushPosition();
 
-	auto elem = ParseArrayValue(tk);
-	if (elem->IsError())
+	ParseResult elem = ParseArrayValue(tk);
+	if (elem.IsError())
 	{
 		tk.RestorePosition();
-		return make_shared<AstError>();
+		return elem;
 	}
 
-	if (!tk.Current().IsKeyword(KW_ASSIGN))
+	if (!tk.IsKeyword(KW_ASSIGN))
 	{
-		tk.RestorePosition();
-		return make_shared<AstError>();
+		return Backtrack(tk, PARSE_ERROR::EXPECTED_ASSIGN);
 	}
 	tk.Forward();
 
-	auto expr = ParseExpression(tk);
-	if (expr->IsError())
+	ParseResult expr = ParseExpression(tk);
+	if (expr.IsError())
 	{
 		tk.RestorePosition();
-		return make_shared<AstError>();
+		return expr;
 	}
 
 	tk.PopPosition();
-	return make_shared<AstArrayAssign>(elem, expr);
+	return tk.GetAstContext().Make<AstArrayAssign>(elem.Get(), expr.Get());
 }
 
 // Assignment: Variable '=' Expression
-shared_ptr<IAst> ParseAssignment(TokenStream &tk)
+// - Kind of the left side is chosen by the tokens after the id:
+// id type '[' Expression   - element of an array (ArrayAssign)
+// id type type '(' ')'     - declaration of a dict
+// id type type '('         - element of a dict
+// otherwise                - variable
+ParseResult ParseAssignment(TokenStream &tk)
 {
-	auto arrayAssignment = ParseArrayAssignment(tk);
-	if (!arrayAssignment->IsError())
+	if (IsSimpleTypeAhead(tk, 1) && tk.PeekKeyword(2, KW_INDEX_L) && !tk.PeekKeyword(3, KW_INDEX_R))
 	{
-		return arrayAssignment;
+		return ParseArrayAssignment(tk);
 	}
 
 	tk.PushPosition();
 
-	shared_ptr<IAst> var = ParseDict(tk, true);
-	bool dictAssign = true;
-	if (var->IsError())
+	bool dictAssign = IsSimpleTypeAhead(tk, 1) && IsSimpleTypeAhead(tk, 2) &&
+		tk.PeekKeyword(3, KW_BRACE_L) && !tk.PeekKeyword(4, KW_BRACE_R);
+	ParseResult var = dictAssign ? ParseDict(tk, true) : ParseVariable(tk);
+	if (var.IsError())
 	{
-		var = ParseVariable(tk);
-		if (var->IsError())
-		{
-			tk.RestorePosition();
-			return make_shared<AstError>();
-		}
-		else
-		{
-			dictAssign = false;
-		}
+		tk.RestorePosition();
+		return var;
 	}
 
-	if (!tk.Current().IsKeyword(KW_ASSIGN))
+	if (!tk.IsKeyword(KW_ASSIGN))
 	{
-		tk.RestorePosition();
-		return make_shared<AstError>();
+		return Backtrack(tk, PARSE_ERROR::EXPECTED_ASSIGN);
 	}
 	tk.Forward();
 
-	auto expr = ParseExpression(tk);
-	if (expr->IsError())
+	ParseResult expr = ParseExpression(tk);
+	if (expr.IsError())
 	{
 		tk.RestorePosition();
-		return make_shared<AstError>();
+		return expr;
 	}
 
 	tk.PopPosition();
 
 	if (dictAssign)
 	{
-		return make_shared<AstDictAssign>(dynamic_pointer_cast<AstDictValue>(var),
-			dynamic_pointer_cast<AstExpression>(expr));
+		return tk.GetAstContext().Make<AstDictAssign>(Cast<AstDictValue>(var.Get()),
+			Cast<AstExpression>(expr.Get()));
 	}
 	else
 	{
-		return make_shared<AstAssignmentExpression>(dynamic_pointer_cast<AstVariable>(var),
-			dynamic_pointer_cast<AstExpression>(expr));
+		return tk.GetAstContext().Make<AstAssignmentExpression>(Cast<AstVariable>(var.Get()),
+			Cast<AstExpression>(expr.Get()));
 	}
 }
 
-shared_ptr<IAst> ParseReturn(TokenStream &tk)
+ParseResult ParseReturn(TokenStream &tk)
 {
-	if (!tk.Current().IsKeyword(KW_RETURN))
+	if (!tk.IsKeyword(KW_RETURN))
 	{
-		return make_shared<AstError>();
+		return Fail(tk, PARSE_ERROR::EXPECTED_STATEMENT);
 	}
 	tk.Forward();
 
-	auto expr = ParseExpression(tk);
-	if (expr->IsError())
+	ParseResult expr = ParseExpression(tk);
+	if (expr.IsError())
 	{
-		return make_shared<AstReturn>();
+		return tk.GetAstContext().Make<AstReturn>();
 	}
 	else
 	{
-		return make_shared<AstReturn>(dynamic_pointer_cast<AstExpression>(expr));
+		return tk.GetAstContext().Make<AstReturn>(Cast<AstExpression>(expr.Get()));
 	}
 }
 
 // FunctionName: id <TypeSpecifier>
-bool ParseFunctionName(TokenStream &tk, string &functionName, DataType &dataType)
+bool ParseFunctionName(TokenStream &tk, Atom &functionName, DataType &dataType)
 {
-	shared_ptr<IAst> nameType = ParseVariable(tk);
-	if (!nameType->IsError())
+	if (tk.CurrentType() != TOKEN_ID)
 	{
-		AstVariable *var = dynamic_cast<AstVariable*>(nameType.get());
-		functionName = var->GetName();
-		dataType = var->GetType();
-	}
-	else if (tk.Current().GetType() == TOKEN_ID)
-	{
-		functionName = tk.Current().GetValueS();
-		dataType = DataType(ATOMIC_TYPE::TYPE_VOID);
-		tk.Forward();
+		return false;
 	}
-	else
+
+	// Name of a void function is followed by the argument list
+	if (!tk.PeekKeyword(1, KW_BRACE_L))
 	{
-		return false;
+		ParseResult nameType = ParseVariable(tk);
+		if (!nameType.IsError())
+		{
+			AstVariable *var = Cast<AstVariable>(nameType.Get());
+			functionName = var->GetAtom();
+			dataType = var->GetType();
+			return true;
+		}
 	}
 
+	functionName = tk.Current().GetValueA();
+	dataType = DataType(ATOMIC_TYPE::TYPE_VOID);
+	tk.Forward();
+
 	return true;
 }
 
 // SequentialList: [parseElement]
-shared_ptr<AstList> ParseSequentialList(TokenStream &tk, PARSE_FUNCT parseElement)
+AstList *ParseSequentialList(TokenStream &tk, PARSE_FUNCT parseElement)
 {
-	shared_ptr<AstList> list = make_shared<AstList>();
+	AstList *list = tk.GetAstContext().Make<AstList>();
 
 	while (true)
 	{
-		shared_ptr<IAst> statement = parseElement(tk);
+		ParseResult statement = parseElement(tk);
 
-		if (statement->IsError())
+		if (statement.IsError())
 		{
 			break;
 		}
 
-		list->AddElement(statement);
+		list->AddElement(statement.Get());
 	}
 
 	return list;
 }
 
 // CommaSeparatedList: <parseElement [',' parseElement]>
-shared_ptr<AstList> ParseCommaSeparatedList(TokenStream &tk, PARSE_FUNCT parseElement)
+AstList *ParseCommaSeparatedList(TokenStream &tk, PARSE_FUNCT parseElement)
 {
-	shared_ptr<AstList> list = make_shared<AstList>();
+	AstList *list = tk.GetAstContext().Make<AstList>();
 
 	bool firstElement = true;
 	while (true)
 	{
-		shared_ptr<IAst> astVar = parseElement(tk);
-		if (astVar->IsError())
+		ParseResult astVar = parseElement(tk);
+		if (astVar.IsError())
 		{
 			if (firstElement)
 			{
@@ -1022,10 +1176,10 @@ shared_ptr<AstList> ParseCommaSeparatedList(TokenStream &tk, PARSE_FUNCT parseEl
 				throw IntermediateError("Expected element");
 			}
 		}
-		list->AddElement(astVar);
+		list->AddElement(astVar.Get());
 		firstElement = false;
 
-		if (!tk.Current().IsKeyword(KW_COMMA))
+		if (!tk.IsKeyword(KW_COMMA))
 		{
 			break;
 		}
@@ -1036,31 +1190,28 @@ shared_ptr<AstList> ParseCommaSeparatedList(TokenStream &tk, PARSE_FUNCT parseEl
 }
 
 // Call: FunctionName '(' <Expression [',' Expression]> ')'
-shared_ptr<IAst> ParseCall(TokenStream &tk, bool discardResult)
+ParseResult ParseCall(TokenStream &tk, bool discardResult)
 {
 	tk.PushPosition();
 
-	string functName;
+	Atom functName;
 	DataType returnType(ATOMIC_TYPE::TYPE_VOID);
 	if (!ParseFunctionName(tk, functName, returnType))
 	{
-		tk.RestorePosition();
-		return make_shared<AstError>();
+		return Backtrack(tk, PARSE_ERROR::EXPECTED_FUNCTION_NAME);
 	}
 	
-	if (!tk.Current().IsKeyword(KW_BRACE_L))
+	if (!tk.IsKeyword(KW_BRACE_L))
 	{
-		tk.RestorePosition();
-		return make_shared<AstError>();
+		return Backtrack(tk, PARSE_ERROR::EXPECTED_BRACE_L);
 	}
 	tk.Forward();
 
 	auto args = ParseCommaSeparatedList(tk, &ParseExpression);
 
-	if (!tk.Current().IsKeyword(KW_BRACE_R))
+	if (!tk.IsKeyword(KW_BRACE_R))
 	{
-		tk.RestorePosition();
-		return make_shared<AstError>();
+		return Backtrack(tk, PARSE_ERROR::EXPECTED_BRACE_R);
 	}
 	tk.Forward();
 
@@ -1070,94 +1221,95 @@ shared_ptr<IAst> ParseCall(TokenStream &tk, bool discardResult)
 	}
 
 	tk.PopPosition();
-	return make_shared<AstFunctionCall>(functName, returnType, args);
+	return tk.GetAstContext().Make<AstFunctionCall>(functName, returnType, args);
 }
 
-shared_ptr<AstList> ParseCode(TokenStream &tk);
+AstList *ParseCode(TokenStream &tk);
 
 // If: 'if' Expression Code <'else' Code>
-shared_ptr<IAst> ParseIf(TokenStream &tk)
+ParseResult ParseIf(TokenStream &tk)
 {
-	if (!tk.Current().IsKeyword(KW_IF))
+	if (!tk.IsKeyword(KW_IF))
 	{
-		return make_shared<AstError>();
+		return Fail(tk, PARSE_ERROR::EXPECTED_STATEMENT);
 	}
 	tk.Forward();
 
-	auto condition = ParseExpression(tk);
-	if (condition->IsError())
+	ParseResult condition = ParseExpression(tk);
+	if (condition.IsError())
 	{
 		throw IntermediateError("Expected expression");
 	}
 
-	shared_ptr<IAst> consequent = ParseCode(tk);
-	shared_ptr<IAst> alternative(nullptr);
+	IAst *consequent = ParseCode(tk);
+	IAst *alternative(nullptr);
 
-	if (tk.Current().IsKeyword(KW_ELSE))
+	if (tk.IsKeyword(KW_ELSE))
 	{
 		tk.Forward();
 
 		alternative = ParseCode(tk);
 	}
 
-	return make_shared<AstIf>(condition, consequent, alternative);
+	return tk.GetAstContext().Make<AstIf>(condition.Get(), consequent, alternative);
 }
 
 // For: 'for' Assignment 'to' Expression <'step' Expression> Code
-shared_ptr<IAst> ParseFor(TokenStream &tk)
+ParseResult ParseFor(TokenStream &tk)
 {
-	if (!tk.Current().IsKeyword(KW_FOR))
+	if (!tk.IsKeyword(KW_FOR))
 	{
-		return make_shared<AstError>();
+		return Fail(tk, PARSE_ERROR::EXPECTED_STATEMENT);
 	}
 	tk.Forward();
 
-	auto from = ParseAssignment(tk);
-	if (from->IsError())
+	ParseResult from = ParseAssignment(tk);
+	if (from.IsError())
 	{
 		throw IntermediateError("Expected assignment"); 
 	}
 
-	if (!tk.Current().IsKeyword(KW_TO))
+	if (!tk.IsKeyword(KW_TO))
 	{
 		throw IntermediateError("Expected 'to'");
 	}
 	tk.Forward();
 
-	auto to = ParseExpression(tk);
-	if (to->IsError())
+	ParseResult to = ParseExpression(tk);
+	if (to.IsError())
 	{
 		throw IntermediateError("Expected expression"); 
 	}
 
-	shared_ptr<IAst> step;
-	if (tk.Current().IsKeyword(KW_STEP))
+	IAst *step = nullptr;
+	if (tk.IsKeyword(KW_STEP))
 	{
 		tk.Forward();
 
-		step = ParseExpression(tk);
-		if (step->IsError())
+		ParseResult stepResult = ParseExpression(tk);
+		if (stepResult.IsError())
 		{
 			throw IntermediateError("Expected expression"); 
 		}
+		step = stepResult.Get();
 	}
 
 	auto code = ParseCode(tk);
 
-	return make_shared<AstFor>(from, to, step, code);
+	return tk.GetAstContext().Make<AstFor>(from.Get(), to.Get(), step, code);
 }
 
 // While: 'while' Expression Code
-shared_ptr<IAst> ParseWhile(TokenStream &tk)
+ParseResult ParseWhile(TokenStream &tk)
 {
-	if (!tk.Current().IsKeyword(KW_WHILE))
+	if (!tk.IsKeyword(KW_WHILE))
 	{
-		return make_shared<AstError>();
+		return Fail(tk, PARSE_ERROR::EXPECTED_STATEMENT);
 	}
 	tk.Forward();
 
-	auto condition = ParseExpression(tk);
-	if (condition->IsError())
+	ParseResult condition = ParseExpression(tk);
+	if (condition.IsError())
 	{
 		throw IntermediateError("Expected expression"); 
 	}
@@ -1168,15 +1320,15 @@ shared_ptr<IAst> ParseWhile(TokenStream &tk)
 		throw IntermediateError("Expected code"); 
 	}
 
-	return make_shared<AstWhile>(condition, code, false);
+	return tk.GetAstContext().Make<AstWhile>(condition.Get(), code, false);
 }
 
 // DoWhile: 'do' Code 'while' Expression
-shared_ptr<IAst> ParseDoWhile(TokenStream &tk)
+ParseResult ParseDoWhile(TokenStream &tk)
 {
-	if (!tk.Current().IsKeyword(KW_DO))
+	if (!tk.IsKeyword(KW_DO))
 	{
-		return make_shared<AstError>();
+		return Fail(tk, PARSE_ERROR::EXPECTED_STATEMENT);
 	}
 	tk.Forward();
 
@@ -1186,75 +1338,194 @@ shared_ptr<IAst> ParseDoWhile(TokenStream &tk)
 		throw IntermediateError("Expected code"); 
 	}
 
-	if (!tk.Current().IsKeyword(KW_WHILE))
+	if (!tk.IsKeyword(KW_WHILE))
 	{
 		throw IntermediateError("Expected 'while'");
 	}
 	tk.Forward();
 
-	auto condition = ParseExpression(tk);
-	if (condition->IsError())
+	ParseResult condition = ParseExpression(tk);
+	if (condition.IsError())
 	{
 		throw IntermediateError("Expected expression"); 
 	}
 
-	return make_shared<AstWhile>(condition, code, true);
+	return tk.GetAstContext().Make<AstWhile>(condition.Get(), code, true);
 }
 
-// Statement: Assignment | Return | If | For | While | DoWhile | Call
-shared_ptr<IAst> ParseStatement(TokenStream &tk)
+// Rules that start with a keyword, indexed by that keyword
+// (FIRST sets of the rules), so the rule to parse is chosen
+// by the current token instead of trying the rules one by one
+class KeywordDispatch
 {
-	auto result = ParseAssignment(tk);
-	if (!result->IsError())
+public:
+	KeywordDispatch(initializer_list<pair<KEYWORD, PARSE_FUNCT>> rules)
 	{
-		return result;
+		fill(m_rules, m_rules + KEYWORD_COUNT, nullptr);
+		for (auto &rule : rules)
+		{
+			m_rules[rule.first] = rule.second;
+		}
 	}
 
-	result = ParseReturn(tk);
-	if (!result->IsError())
+	// Returns the rule that starts with the current token or null
+	PARSE_FUNCT Find(const TokenStream &tk) const
 	{
-		return result;
+		TOKEN_TYPE type = tk.CurrentType();
+		if (type != TOKEN_KEYWORD && type != TOKEN_DELIMETER)
+		{
+			return nullptr;
+		}
+		return m_rules[tk.CurrentKeyword()];
 	}
 
-	result = ParseIf(tk);
-	if (!result->IsError())
+private:
+	PARSE_FUNCT m_rules[KEYWORD_COUNT];
+};
+
+const KeywordDispatch STATEMENT_RULES({
+	make_pair(KW_RETURN, &ParseReturn),
+	make_pair(KW_IF, &ParseIf),
+	make_pair(KW_FOR, &ParseFor),
+	make_pair(KW_WHILE, &ParseWhile),
+	make_pair(KW_DO, &ParseDoWhile)
+});
+
+// Statement: Assignment | Return | If | For | While | DoWhile | Call
+ParseResult ParseStatement(TokenStream &tk)
+{
+	PARSE_FUNCT rule = STATEMENT_RULES.Find(tk);
+	if (rule)
 	{
-		return result;
+		return rule(tk);
 	}
 
-	result = ParseFor(tk);
-	if (!result->IsError())
+	if (tk.CurrentType() != TOKEN_ID)
 	{
-		return result;
+		return Fail(tk, PARSE_ERROR::EXPECTED_STATEMENT);
 	}
 
-	result = ParseWhile(tk);
-	if (!result->IsError())
+	if (IsCall(tk))
 	{
-		return result;
+		return ParseCall(tk, true);
 	}
+	return ParseAssignment(tk);
+}
 
-	result = ParseDoWhile(tk);
-	if (!result->IsError())
+bool IsDefinitionStart(const TokenStream &tk)
+{
+	return tk.IsKeyword(KW_DEF) || tk.IsKeyword(KW_CONST) || tk.IsKeyword(KW_GLOBAL);
+}
+
+bool IsStatementStart(const TokenStream &tk)
+{
+	return tk.CurrentType() == TOKEN_ID || STATEMENT_RULES.Find(tk) != nullptr;
+}
+
+// The same error at the same token is recorded once
+// (e.g. a missing '}' of nested blocks)
+void RecordError(TokenStream &tk, const CompileError &error)
+{
+	vector<CompileError> &errors = *tk.GetErrorLog();
+	if (errors.empty() || strcmp(errors.back().what(), error.what()) != 0)
 	{
-		return result;
+		errors.push_back(error);
 	}
+}
 
-	return ParseCall(tk, true);
+// Skips the rest of a statement with an error: stops at a statement that
+// starts after the line, at '}' of the block, at a definition or at the end
+// - Blocks of the statement are still checked
+// - Returns false if the block has no '}'
+bool SkipToStatement(TokenStream &tk, int line)
+{
+	while (!tk.IsEOS() && !IsDefinitionStart(tk))
+	{
+		if (tk.IsKeyword(KW_BLOCK_R) ||
+			(IsStatementStart(tk) && tk.Current().GetLineNumber() > line))
+		{
+			return true;
+		}
+
+		if (tk.IsKeyword(KW_BLOCK_L))
+		{
+			ParseCode(tk);
+		}
+		else
+		{
+			tk.Forward();
+		}
+	}
+	return false;
+}
+
+// Statements of a block for ParseWithRecovery(): a statement with an error
+// is recorded and skipped
+// - Stops at '}' or, if the block has no '}', after recording that
+AstList *ParseStatementsWithRecovery(TokenStream &tk)
+{
+	AstList *list = tk.GetAstContext().Make<AstList>();
+
+	while (true)
+	{
+		size_t savedPositions = tk.GetSavedPositionCount();
+		int line = tk.Current().GetLineNumber();
+		try
+		{
+			ParseResult statement = ParseStatement(tk);
+			if (!statement.IsError())
+			{
+				list->AddElement(statement.Get());
+				continue;
+			}
+			if (tk.IsKeyword(KW_BLOCK_R))
+			{
+				return list;
+			}
+			throw IntermediateError("Expected '}'");
+		}
+		catch (const IntermediateError &ex)
+		{
+			RecordError(tk, CompileError(ex.what(), tk.Previous()));
+		}
+		catch (const CompileError &ex)
+		{
+			RecordError(tk, ex);
+		}
+
+		tk.DropSavedPositions(savedPositions);
+		if (!SkipToStatement(tk, line))
+		{
+			return list;
+		}
+	}
 }
 
 // Code: '{' [Statement] '}'
-shared_ptr<AstList> ParseCode(TokenStream &tk)
+AstList *ParseCode(TokenStream &tk)
 {
-	if (!tk.Current().IsKeyword(KW_BLOCK_L))
+	if (!tk.IsKeyword(KW_BLOCK_L))
 	{
 		throw IntermediateError("Expected '{'");
 	}
 	tk.Forward();
 
-	shared_ptr<AstList> result = ParseSequentialList(tk, &ParseStatement);
+	AstList *result;
+	if (tk.GetErrorLog())
+	{
+		result = ParseStatementsWithRecovery(tk);
+		if (!tk.IsKeyword(KW_BLOCK_R))
+		{
+			// Missing '}' is recorded already
+			return result;
+		}
+	}
+	else
+	{
+		result = ParseSequentialList(tk, &ParseStatement);
+	}
 
-	if (!tk.Current().IsKeyword(KW_BLOCK_R))
+	if (!tk.IsKeyword(KW_BLOCK_R))
 	{
 		throw IntermediateError("Expected '}'");
 	}
@@ -1264,45 +1535,48 @@ shared_ptr<AstList> ParseCode(TokenStream &tk)
 }
 
 // Function: 'def' {Variable Id} '(' <Variable [',' Variable]> ')' Code
-shared_ptr<IAst> ParseFunction(TokenStream &tk)
+ParseResult ParseFunction(TokenStream &tk)
 {
-	if (!tk.Current().IsKeyword(KW_DEF))
+	if (!tk.IsKeyword(KW_DEF))
 	{
-		return make_shared<AstError>();
+		return Fail(tk, PARSE_ERROR::EXPECTED_DEFINITION);
 	}
 	tk.Forward();
 
-	string functionName;
+	Atom functionName;
 	DataType returnType(ATOMIC_TYPE::TYPE_VOID);
 	if (!ParseFunctionName(tk, functionName, returnType))
 	{
 		throw IntermediateError("Expected function name");
 	}
 
-	if (!tk.Current().IsKeyword(KW_BRACE_L))
+	if (!tk.IsKeyword(KW_BRACE_L))
 	{
 		throw IntermediateError("Expected '('");
 	}
 	tk.Forward();
 
-	shared_ptr<AstList> arguments = ParseCommaSeparatedList(tk, &ParseVariable);
+	AstList *arguments = ParseCommaSeparatedList(tk, &ParseVariable);
 
-	if (!tk.Current().IsKeyword(KW_BRACE_R))
+	if (!tk.IsKeyword(KW_BRACE_R))
 	{
 		throw IntermediateError("Expected ')'");
 	}
 	tk.Forward();
 
-	shared_ptr<AstList> code = ParseCode(tk);
+	AstList *code = ParseCode(tk);
 
-	return make_shared<AstFunction>(functionName, returnType, arguments, code);
+	// Expressions aren't shared between functions
+	tk.GetAstContext().ClearExpressions();
+
+	return tk.GetAstContext().Make<AstFunction>(functionName, returnType, arguments, code);
 }
 
-shared_ptr<IAst> ParseGlobal(TokenStream &tk)
+ParseResult ParseGlobal(TokenStream &tk)
 {
-	if (!tk.Current().IsKeyword(KW_GLOBAL))
+	if (!tk.IsKeyword(KW_GLOBAL))
 	{
-		return make_shared<AstError>();
+		return Fail(tk, PARSE_ERROR::EXPECTED_DEFINITION);
 	}
 	tk.Forward();
 
@@ -1312,30 +1586,17 @@ shared_ptr<IAst> ParseGlobal(TokenStream &tk)
 		throw IntermediateError("Expected at least one variable declaration");
 	}
 
-	return make_shared<AstGlobal>(list);
+	return tk.GetAstContext().Make<AstGlobal>(list);
 }
 
-// Const: 'const' Assignment [',' Assignment]
-shared_ptr<IAst> ParseConstDecl(TokenStream &tk)
+// Checks that the values are constant and makes a declaration for each of them
+AstList *CreateConstDecl(AstContext &context, AstList *assignments)
 {
-	if (!tk.Current().IsKeyword(KW_CONST))
-	{
-		return make_shared<AstError>();
-	}
-	tk.Forward();
-
-	shared_ptr<AstList> cList = ParseCommaSeparatedList(tk, &ParseAssignment);
-
-	if (cList->IsEmpty())
-	{
-		throw IntermediateError("Expected at least one constant declaration");
-	}
-
-	shared_ptr<AstList> declList(new AstList());
+	AstList *declList = context.Make<AstList>();
 	
-	for (auto decl : cList->GetElements())
+	for (auto decl : assignments->GetElements())
 	{
-		auto assign = dynamic_cast<AstAssignmentExpression*>(decl.get());
+		auto assign = DynCast<AstAssignmentExpression>(decl);
 
 		if (!assign)
 		{
@@ -1353,83 +1614,318 @@ shared_ptr<IAst> ParseConstDecl(TokenStream &tk)
 		{
 		case DATA_TYPE::TYPE_BOOL:
 		{
-			auto val = dynamic_cast<AstBoolConst*>(assign->GetExpression().get());
-			constant = make_shared<BoolConst>(assign->GetVariable()->GetName(), val->GetValue());
+			auto val = Cast<AstBoolConst>(assign->GetExpression());
+			constant = make_shared<BoolConst>(assign->GetVariable()->GetAtom(), val->GetValue());
 			break;
 		}
 		case DATA_TYPE::TYPE_FLOAT:
 		{
-			auto val = dynamic_cast<AstFloatConst*>(assign->GetExpression().get());
-			constant = make_shared<FloatConst>(assign->GetVariable()->GetName(), val->GetValue());
+			auto val = Cast<AstFloatConst>(assign->GetExpression());
+			constant = make_shared<FloatConst>(assign->GetVariable()->GetAtom(), val->GetValue());
 			break;
 		}
 		case DATA_TYPE::TYPE_INT:
 		{
-			auto val = dynamic_cast<AstIntConst*>(assign->GetExpression().get());
-			constant = make_shared<IntConst>(assign->GetVariable()->GetName(), val->GetValue());
+			auto val = Cast<AstIntConst>(assign->GetExpression());
+			constant = make_shared<IntConst>(assign->GetVariable()->GetAtom(), val->GetValue());
 			break;
 		}
 		case DATA_TYPE::TYPE_STRING:
 		{
-			auto val = dynamic_cast<AstStringConst*>(assign->GetExpression().get());
-			constant = make_shared<StringConst>(assign->GetVariable()->GetName(), val->GetValue());
+			auto val = Cast<AstStringConst>(assign->GetExpression());
+			constant = make_shared<StringConst>(assign->GetVariable()->GetAtom(), val->GetValue());
 			break;
 		}
 		default:
 			throw IntermediateError("Constants must have atomic type");
 		}
 
-		declList->AddElement(make_shared<AstConstantDecl>(constant));
+		declList->AddElement(context.Make<AstConstantDecl>(constant));
 	}
 
 	return declList;
 }
 
-// Definition: Const | Global | Function
-shared_ptr<IAst> ParseDefinition(TokenStream &tk)
+// Const: 'const' Assignment [',' Assignment]
+ParseResult ParseConstDecl(TokenStream &tk)
 {
-	auto result = ParseFunction(tk);
-	if (!result->IsError())
+	if (!tk.IsKeyword(KW_CONST))
 	{
-		return result;
+		return Fail(tk, PARSE_ERROR::EXPECTED_DEFINITION);
 	}
+	tk.Forward();
+
+	AstList *cList = ParseCommaSeparatedList(tk, &ParseAssignment);
 
-	result = ParseConstDecl(tk);
-	if (!result->IsError())
+	if (cList->IsEmpty())
 	{
-		return result;
+		throw IntermediateError("Expected at least one constant declaration");
 	}
 
-	return ParseGlobal(tk);
+	return CreateConstDecl(tk.GetAstContext(), cList);
+}
+
+const KeywordDispatch DEFINITION_RULES({
+	make_pair(KW_DEF, &ParseFunction),
+	make_pair(KW_CONST, &ParseConstDecl),
+	make_pair(KW_GLOBAL, &ParseGlobal)
+});
+
+// Definition: Const | Global | Function
+ParseResult ParseDefinition(TokenStream &tk)
+{
+	PARSE_FUNCT rule = DEFINITION_RULES.Find(tk);
+	if (!rule)
+	{
+		return Fail(tk, PARSE_ERROR::EXPECTED_DEFINITION);
+	}
+	return rule(tk);
 }
 
-shared_ptr<IAst> ParseProgram(TokenStream &tk)
+// Program: [Definition]
+// - Throws the failure that stopped the program before the end
+AstList *ParseProgram(TokenStream &tk)
 {
-	return ParseSequentialList(tk, &ParseDefinition);
+	AstList *program = tk.GetAstContext().Make<AstList>();
+
+	while (true)
+	{
+		ParseResult definition = ParseDefinition(tk);
+		if (definition.IsError())
+		{
+			if (!tk.IsEOS())
+			{
+				// Definitions fail before they read anything
+				assert(definition.GetPosition() == tk.GetPosition());
+				throw CompileError(definition.GetMessage(), tk.Current());
+			}
+			return program;
+		}
+
+		program->AddElement(definition.Get());
+	}
 }
 
 // TokenStream &tk - private in class Parser
 // Different data types: DataType and AtomicDataType to prevent all the error checking
 
+shared_ptr<IAst> Parse(TokenStream &ts)
+{
+	try
+	{
+		IAst *result = ParseProgram(ts);
+		ts.AssertStackIsEmpty();
+
+		return ts.GetAstContext().Handle(result);
+	}
+	catch (const IntermediateError &ex)
+	{
+		throw CompileError(ex.what(), ts.Previous());
+	}
+}
+
 shared_ptr<IAst> Parse(const vector<Token> &tokens)
 {
 	TokenStream ts(tokens);
+	return Parse(ts);
+}
+
+shared_ptr<IAst> Parse(vector<Token> &&tokens)
+{
+	TokenStream ts(move(tokens));
+	return Parse(ts);
+}
+
+// Skips the rest of a definition with an error up to the next definition
+// - Statements of a function body are still checked
+void SkipToDefinition(TokenStream &ts)
+{
+	while (!ts.IsEOS() && !IsDefinitionStart(ts))
+	{
+		if (ts.IsKeyword(KW_BLOCK_L))
+		{
+			ParseCode(ts);
+		}
+		else
+		{
+			ts.Forward();
+		}
+	}
+}
+
+shared_ptr<IAst> ParseWithRecovery(TokenStream &ts, vector<CompileError> &errors)
+{
+	AstList *program = ts.GetAstContext().Make<AstList>();
+	ts.SetErrorLog(&errors);
 
 	try
 	{
-		shared_ptr<IAst> result = ParseProgram(ts);
+		while (!ts.IsEOS())
+		{
+			size_t savedPositions = ts.GetSavedPositionCount();
+			try
+			{
+				ParseResult definition = ParseDefinition(ts);
+				if (definition.IsError())
+				{
+					throw CompileError(definition.GetMessage(), ts.Current());
+				}
+				program->AddElement(definition.Get());
+				continue;
+			}
+			catch (const IntermediateError &ex)
+			{
+				RecordError(ts, CompileError(ex.what(), ts.Previous()));
+			}
+			catch (const CompileError &ex)
+			{
+				RecordError(ts, ex);
+			}
+			catch (const InternalError &ex)
+			{
+				RecordError(ts, CompileError(ex.what(), ts.Previous()));
+			}
 
-		if (!ts.IsEOS())
+			ts.DropSavedPositions(savedPositions);
+			SkipToDefinition(ts);
+		}
+	}
+	catch (...)
+	{
+		ts.SetErrorLog(nullptr);
+		throw;
+	}
+
+	ts.SetErrorLog(nullptr);
+	return ts.GetAstContext().Handle(program);
+}
+
+// Having more chunks than threads evens out the load
+static const size_t DEFINITION_CHUNKS_PER_THREAD = 4;
+// Smaller programs are parsed on the calling thread
+static const size_t MIN_PARALLEL_TOKENS = 4096;
+
+// Finds the positions of the top-level definitions: 'def', 'const'
+// and 'global' outside of braces
+// - Returns false if the tokens can't be split (unbalanced braces,
+// tokens before the first definition)
+static bool FindDefinitions(const TokenBuffer &tokens, vector<size_t> &starts)
+{
+	int depth = 0;
+	for (size_t i = 0; i < tokens.Size(); i++)
+	{
+		if (tokens.IsKeyword(i, KW_BLOCK_L))
 		{
-			throw CompileError("Syntax error", ts.Current());
+			depth++;
 		}
-		ts.AssertStackIsEmpty();
+		else if (tokens.IsKeyword(i, KW_BLOCK_R))
+		{
+			if (--depth < 0)
+			{
+				return false;
+			}
+		}
+		else if (depth == 0 && (tokens.IsKeyword(i, KW_DEF) ||
+			tokens.IsKeyword(i, KW_CONST) || tokens.IsKeyword(i, KW_GLOBAL)))
+		{
+			starts.push_back(i);
+		}
+	}
+	return depth == 0 && !starts.empty() && starts.front() == 0;
+}
 
-		return result;
+shared_ptr<IAst> ParseParallel(const TokenBuffer &tokens, ThreadPool &pool)
+{
+	vector<size_t> starts;
+	size_t chunkCount = pool.GetThreadCount() * DEFINITION_CHUNKS_PER_THREAD;
+	if (tokens.Size() < MIN_PARALLEL_TOKENS || !FindDefinitions(tokens, starts) ||
+		(chunkCount = min(chunkCount, starts.size())) < 2)
+	{
+		TokenStream ts(tokens);
+		return Parse(ts);
 	}
-	catch (const IntermediateError &ex)
+
+	struct Chunk
 	{
-		throw CompileError(ex.what(), ts.Previous());
+		size_t begin;
+		size_t end;
+		// Null if the chunk has errors
+		shared_ptr<AstList> definitions;
+	};
+
+	// Chunks of about the same number of tokens, each one starts with a definition
+	vector<Chunk> chunks;
+	for (size_t i = 0; i < chunkCount; i++)
+	{
+		size_t split = tokens.Size() * i / chunkCount;
+		size_t begin = *lower_bound(starts.begin(), starts.end(), split);
+		if (!chunks.empty() && chunks.back().begin == begin)
+		{
+			continue;
+		}
+		if (!chunks.empty())
+		{
+			chunks.back().end = begin;
+		}
+		Chunk chunk = { begin, tokens.Size(), nullptr };
+		chunks.push_back(chunk);
+	}
+
+	vector<future<void>> results;
+	for (size_t i = 0; i < chunks.size(); i++)
+	{
+		results.push_back(pool.Submit([&tokens, &chunks, i]
+		{
+			Chunk &chunk = chunks[i];
+			TokenBuffer chunkTokens;
+			chunkTokens.Append(tokens, chunk.begin, chunk.end);
+			TokenStream ts(move(chunkTokens));
+			try
+			{
+				AstList *definitions = ParseSequentialList(ts, &ParseDefinition);
+				if (ts.IsEOS())
+				{
+					ts.AssertStackIsEmpty();
+					chunk.definitions = ts.GetAstContext().Handle(definitions);
+				}
+			}
+			catch (const CompileError &)
+			{
+			}
+			catch (const IntermediateError &)
+			{
+			}
+		}));
+	}
+
+	// All the tasks must finish before chunks go out of scope,
+	// other errors (e.g. InternalError) are rethrown only then
+	for (auto &result : results)
+	{
+		result.wait();
+	}
+	for (auto &result : results)
+	{
+		result.get();
+	}
+
+	// Definitions stay in the contexts of the chunks, the program retains them
+	auto context = make_shared<AstContext>();
+	AstList *program = context->Make<AstList>();
+	for (auto &chunk : chunks)
+	{
+		if (!chunk.definitions)
+		{
+			// Positions of errors are given by the sequential parser
+			TokenStream ts(tokens);
+			return Parse(ts);
+		}
+		for (auto definition : chunk.definitions->GetElements())
+		{
+			program->AddElement(definition);
+		}
+		context->Retain(chunk.definitions);
 	}
+	return context->Handle(program);
 }
 
@@ -2,14 +2,93 @@
 #include <vector>
 #include <memory>
 #include "Token.h"
+#include "TokenStream.h"
 #include "AstFwd.h"
+#include "ThreadPool.h"
+
+class AstContext;
+
+// Why a parse function didn't match, see ParseResult
+enum class PARSE_ERROR
+{
+	NONE,
+	EXPECTED_CONSTANT,
+	EXPECTED_VARIABLE,
+	EXPECTED_TYPE,
+	EXPECTED_INDEX_R,
+	EXPECTED_BRACE_L,
+	EXPECTED_BRACE_R,
+	EXPECTED_EXPRESSION,
+	EXPECTED_ASSIGN,
+	EXPECTED_FUNCTION_NAME,
+	EXPECTED_STATEMENT,
+	EXPECTED_DEFINITION
+};
+
+// Result of a parse function: the node, or the diagnostic and the position
+// of the token where the rule stopped matching
+// - The caller of a rule that didn't match tries another rule, so a failure
+// is a plain value: nothing is allocated or thrown
+// - Exceptions (IntermediateError) are left for the errors that end the parse
+// - Node of a failure is AstError::INSTANCE, so result->IsError() works
+// for both kinds of results
+class ParseResult
+{
+public:
+	// Rule matched, node isn't AstError
+	ParseResult(IAst *node);
+	// Rule didn't match at the token with index position in the stream
+	ParseResult(PARSE_ERROR error, size_t position);
+
+	bool IsError() const;
+	IAst *Get() const;
+	IAst *operator->() const;
+
+	PARSE_ERROR GetError() const;
+	size_t GetPosition() const;
+	// Message of the error when the program stops at this failure
+	const char *GetMessage() const;
+
+private:
+	IAst *m_node;
+	PARSE_ERROR m_error;
+	size_t m_position;
+};
 
 void InitOperatorMap();
+// Tokens are copied into a TokenStream, see its constructors
 std::shared_ptr<IAst> Parse(const std::vector<Token> &tokens);
+std::shared_ptr<IAst> Parse(std::vector<Token> &&tokens);
+std::shared_ptr<IAst> Parse(TokenStream &ts);
+// Same as Parse(), but every error is recorded instead of throwing the first one
+// - InternalError of a definition the parser can't build (e.g. 'const a%[1] = 5')
+// is recorded like the other errors
+// - After an error the parser goes on from the next statement, '}' or definition
+// - Returns the definitions and statements without errors,
+// the program is valid only if there are no errors
+std::shared_ptr<IAst> ParseWithRecovery(TokenStream &ts, std::vector<CompileError> &errors);
+// Same as Parse(), but the top-level definitions are found by a scan
+// of the braces and parsed in chunks on the threads of the pool
+// - Small programs are parsed on the calling thread
+// - If there are errors, the program is parsed again by Parse(),
+// so the error is the same
+std::shared_ptr<IAst> ParseParallel(const TokenBuffer &tokens, ThreadPool &pool);
+// Parses one top-level definition (function, constants or globals)
+// - Fails with EXPECTED_DEFINITION if there is no definition at the current position
+// - The nodes are owned by the context of the stream
+ParseResult ParseDefinition(TokenStream &tk);
 void ParserTests();
 
-std::shared_ptr<IAst> ParseNewRDP(TokenStream &tk);
-std::shared_ptr<IAst> ParseVariableRDP(TokenStream &tk);
+// Rules called by the table engines of LL.cpp and LR.cpp, so they return
+// the node or AstError the same way as the engines
+IAst *ParseNewRDP(TokenStream &tk);
+IAst *ParseVariableRDP(TokenStream &tk);
+
+// Nodes made with the same checks and constant folding by every front end
+IAst *CreateBinaryExpression(AstContext &context, IAst *left, KEYWORD op, IAst *right);
+IAst *CreateUnaryExpression(AstContext &context, KEYWORD op, IAst *ast_expr);
+// Turns the assignments of a 'const' definition into constant declarations
+AstList *CreateConstDecl(AstContext &context, AstList *assignments);
 
 /*
 class Parser
@@ -0,0 +1,579 @@
+#include <climits>
+#include <sstream>
+#include <vector>
+#include "ParserTest.h"
+#include "UnitTest.h"
+#include "Exception.h"
+#include "Ast.h"
+#include "AstContext.h"
+#include "FenwickTree.h"
+#include "IncrementalParser.h"
+#include "LALR.h"
+#include "Lexer.h"
+#include "Parser.h"
+#include "ProgramGenerator.h"
+#include "ThreadPool.h"
+#include "TokenBuffer.h"
+
+using namespace std;
+
+namespace
+{
+	string JoinLines(const vector<string> &lines)
+	{
+		string text;
+		for (const string &line : lines)
+		{
+			text += line;
+			text += '\n';
+		}
+		return text;
+	}
+
+	// Line numbers (from 1) of the lines that begin with the prefix
+	vector<int> FindLines(const vector<string> &lines, const string &prefix)
+	{
+		vector<int> result;
+		for (size_t i = 0; i < lines.size(); i++)
+		{
+			if (lines[i].compare(0, prefix.size(), prefix) == 0)
+			{
+				result.push_back(static_cast<int>(i) + 1);
+			}
+		}
+		return result;
+	}
+
+	// Parses the text with both parsers and compares the trees and the errors
+	// - Semantic errors must be the same, syntax errors of ParseLALR()
+	// are "Syntax error" at another token
+	// - Returns the error of ParseLALR(), empty if the text is valid
+	string CompareLALR(const string &text)
+	{
+		string error, lalrError;
+		string tree, lalrTree;
+		try
+		{
+			tree = DumpAst(*ParseText(text));
+		}
+		catch (const CompileError &ex)
+		{
+			error = ex.what();
+		}
+		try
+		{
+			Lexer lex;
+			TokenStream ts(lex.ParseBuffer(text.data(), text.size()));
+			lalrTree = DumpAst(*ParseLALR(ts));
+		}
+		catch (const CompileError &ex)
+		{
+			lalrError = ex.what();
+		}
+
+		Check(lalrError == error || (!error.empty() && lalrError.find(": Syntax error") != string::npos),
+			"error of Parse() '" + error + "', of ParseLALR() '" + lalrError + "'");
+		Check(lalrTree == tree, "ParseLALR() makes another tree");
+		return lalrError;
+	}
+
+	// Parses the text with Parse() and ParseParallel(), the trees and the errors must be the same
+	// - Returns the error, empty if the text is valid
+	string CompareParallel(const string &text, ThreadPool &pool)
+	{
+		string error, parallelError;
+		string tree, parallelTree;
+		try
+		{
+			tree = DumpAst(*ParseText(text));
+		}
+		catch (const CompileError &ex)
+		{
+			error = ex.what();
+		}
+		try
+		{
+			Lexer lex;
+			TokenBuffer tokens(lex.ParseBuffer(text.data(), text.size()));
+			parallelTree = DumpAst(*ParseParallel(tokens, pool));
+		}
+		catch (const CompileError &ex)
+		{
+			parallelError = ex.what();
+		}
+
+		Check(parallelError == error, "error of Parse() '" + error + "', of ParseParallel() '" +
+			parallelError + "'");
+		Check(parallelTree == tree, "ParseParallel() makes another tree");
+		return error;
+	}
+
+	// Errors and the tree of ParseWithRecovery()
+	shared_ptr<IAst> ParseWithRecovery(const string &text, vector<CompileError> &errors)
+	{
+		Lexer lex;
+		TokenStream ts(lex.ParseBuffer(text.data(), text.size()));
+		return ParseWithRecovery(ts, errors);
+	}
+
+	// Tree of the text parsed with hash-consing on or off, and the number of its nodes
+	shared_ptr<IAst> ParseHashConsing(const string &text, bool isOn, size_t &nodeCount)
+	{
+		Lexer lex;
+		TokenStream ts(lex.ParseBuffer(text.data(), text.size()));
+		ts.GetAstContext().SetHashConsing(isOn);
+		shared_ptr<IAst> result = Parse(ts);
+		nodeCount = ts.GetAstContext().GetNodeCount();
+		return result;
+	}
+
+	// Right side of the statement of the function, e.g. of "a% = 1"
+	const AstExpression *GetAssigned(const IAst *program, size_t function, size_t statement)
+	{
+		const AstFunction *definition = Cast<AstFunction>(Cast<AstList>(program)->GetElements()[function]);
+		return Cast<AstAssignmentExpression>(definition->GetCode()->GetElements()[statement])->GetExpression();
+	}
+
+	// Applies the edit both to the parser and to the lines,
+	// then compares the program with the tree of the whole text
+	void CheckEdit(IncrementalParser &parser, vector<string> &lines,
+		int firstLine, int removedCount, const vector<string> &newLines)
+	{
+		lines.erase(lines.begin() + firstLine - 1, lines.begin() + firstLine - 1 + removedCount);
+		lines.insert(lines.begin() + firstLine - 1, newLines.begin(), newLines.end());
+
+		parser.Edit(firstLine, removedCount, newLines);
+		Check(parser.GetLines() == lines, "lines of the parser differ after editing line " +
+			to_string(firstLine));
+		Check(DumpAst(*parser.GetProgram()) == DumpAst(*ParseText(JoinLines(lines))),
+			"program differs from the whole text after editing line " + to_string(firstLine));
+	}
+
+	// Same as CheckEdit(), but the edit makes an error, so it must throw CompileError
+	void CheckInvalidEdit(IncrementalParser &parser, vector<string> &lines,
+		int firstLine, int removedCount, const vector<string> &newLines)
+	{
+		lines.erase(lines.begin() + firstLine - 1, lines.begin() + firstLine - 1 + removedCount);
+		lines.insert(lines.begin() + firstLine - 1, newLines.begin(), newLines.end());
+
+		bool isError = false;
+		try
+		{
+			parser.Edit(firstLine, removedCount, newLines);
+		}
+		catch (const CompileError &)
+		{
+			isError = true;
+		}
+		Check(isError, "editing line " + to_string(firstLine) + " isn't an error");
+		Check(parser.GetLines() == lines, "lines of the parser differ after an error at line " +
+			to_string(firstLine));
+	}
+}
+
+void TestIncrementalParser()
+{
+	GeneratorOptions options;
+	options.seed = 5;
+	options.functionCount = 12;
+	options.statementsPerFunction = 15;
+	string text = ProgramGenerator(options).Generate();
+
+	IncrementalParser parser;
+	parser.Load(text.data(), text.size());
+	vector<string> lines = parser.GetLines();
+	Check(DumpAst(*parser.GetProgram()) == DumpAst(*ParseText(text)), "loaded program differs");
+
+	// Typing inside a function, the line count stays the same
+	vector<int> functions = FindLines(lines, "def ");
+	Check(functions.size() == 13, "functions and main() aren't found");
+	int body = functions[3] + 2;
+	CheckEdit(parser, lines, body, 1, vector<string>(1, "  x0% = 12345"));
+	CheckEdit(parser, lines, body, 1, vector<string>(1, "  x0% = 12345 + a% * 2"));
+
+	// Lines added into and removed from a function
+	CheckEdit(parser, lines, body + 1, 0, { "  y1# = 1.5", "  print(\"inserted\")" });
+	CheckEdit(parser, lines, body, 3, vector<string>());
+
+	// Errors are thrown while any of them is left,
+	// and the program is correct after all of them are fixed
+	CheckInvalidEdit(parser, lines, body, 0, vector<string>(1, "  x0% = "));
+	CheckInvalidEdit(parser, lines, body + 3, 0, vector<string>(1, "  )"));
+	CheckInvalidEdit(parser, lines, body, 1, vector<string>());
+	CheckEdit(parser, lines, body + 2, 1, vector<string>());
+
+	// Whole functions removed, copied and added at the end
+	functions = FindLines(lines, "def ");
+	CheckEdit(parser, lines, functions[5], functions[6] - functions[5], vector<string>());
+	functions = FindLines(lines, "def ");
+	vector<string> copied(lines.begin() + functions[1] - 1, lines.begin() + functions[2] - 1);
+	CheckEdit(parser, lines, functions[8], 0, copied);
+	CheckEdit(parser, lines, static_cast<int>(lines.size()) + 1, 0,
+		{ "def added%(a%)", "{", "  return a% * 2", "}" });
+
+	// Two functions joined into one and split again
+	functions = FindLines(lines, "def ");
+	int end = functions[2] - 1;
+	while (lines[end - 1] != "}")
+	{
+		end--;
+	}
+	vector<string> joined(lines.begin() + end - 1, lines.begin() + functions[2] + 1);
+	CheckEdit(parser, lines, end, static_cast<int>(joined.size()), vector<string>());
+	CheckEdit(parser, lines, end, 0, joined);
+	CheckInvalidEdit(parser, lines, end, 1, vector<string>());
+	CheckEdit(parser, lines, end, 0, vector<string>(1, "}"));
+
+	// A function split into two and joined again
+	body = functions[4] + 4;
+	CheckEdit(parser, lines, body, 0, { "}", "def split%()", "{" });
+	CheckEdit(parser, lines, body, 3, vector<string>());
+
+	// Declarations at the beginning of the program
+	CheckEdit(parser, lines, 1, 0, vector<string>(1, "const first% = 1"));
+	CheckEdit(parser, lines, 1, 1, vector<string>(1, "const first% = 2, second$ = \"2\""));
+	CheckEdit(parser, lines, 1, 1, vector<string>());
+
+	// The whole text replaced
+	GeneratorOptions otherOptions = options;
+	otherOptions.seed = 6;
+	string other = ProgramGenerator(otherOptions).Generate();
+	IncrementalParser otherParser;
+	otherParser.Load(other.data(), other.size());
+	CheckEdit(parser, lines, 1, static_cast<int>(lines.size()), otherParser.GetLines());
+
+	// A program held by the caller stays as it was
+	shared_ptr<AstList> held = parser.GetProgram();
+	string heldTree = DumpAst(*held);
+	functions = FindLines(lines, "def ");
+	CheckEdit(parser, lines, functions[2] + 2, 1, vector<string>(1, "  held% = 1"));
+	Check(DumpAst(*held) == heldTree, "held program is changed by an edit");
+
+	// Functions moved around, segments are split and joined all over the program
+	for (size_t i = 0; i < functions.size(); i++)
+	{
+		functions = FindLines(lines, "def ");
+		size_t from = i % (functions.size() - 1);
+		int begin = functions[from];
+		int count = functions[from + 1] - begin;
+		vector<string> moved(lines.begin() + begin - 1, lines.begin() + begin - 1 + count);
+		CheckEdit(parser, lines, begin, count, vector<string>());
+
+		functions = FindLines(lines, "def ");
+		CheckEdit(parser, lines, functions[(i * 7) % functions.size()], 0, moved);
+	}
+
+	// Prefix sums of the segments, empty counts contain no position
+	const int COUNTS[] = { 3, 0, 5, 1, 0, 0, 7, 2, 4 };
+	vector<int> counts(COUNTS, COUNTS + sizeof(COUNTS) / sizeof(COUNTS[0]));
+	FenwickTree tree;
+	tree.Assign(counts);
+	counts[1] += 2;
+	tree.Add(1, 2);
+	counts[6] -= 7;
+	tree.Add(6, -7);
+	int sum = 0;
+	for (size_t i = 0; i < counts.size(); i++)
+	{
+		Check(tree.Sum(i) == sum, "sum of " + to_string(i) + " counts is " + to_string(tree.Sum(i)));
+		for (int position = sum; position < sum + counts[i]; position++)
+		{
+			Check(tree.Find(position) == i, "position " + to_string(position) + " is found in " +
+				to_string(tree.Find(position)));
+		}
+		sum += counts[i];
+	}
+	Check(tree.Sum(counts.size()) == sum && tree.Find(sum) == counts.size(), "end of the counts isn't found");
+}
+
+void TestLALRParser()
+{
+	const char *const PROGRAMS[] = {
+		"1.txt", "Adder.txt", "ArrayAssign.txt", "ArrayLength.txt", "ArrayValue.txt",
+		"ArrayValueSimple.txt", "Constants.txt", "DivFloat.txt", "DoWhile.txt", "DoWhile2.txt",
+		"For.txt", "Hello.txt", "IfElse.txt", "ModByZero.txt", "NewArray.txt", "NewDict.txt",
+		"Not.txt", "Random.txt", "Strlen.txt", "Substring.txt", "TestDiv.txt", "While.txt"
+	};
+	for (const char *name : PROGRAMS)
+	{
+		CompareLALR(ReadTestProgram(name));
+	}
+
+	for (unsigned seed = 1; seed <= 5; ++seed)
+	{
+		GeneratorOptions options;
+		options.seed = seed;
+		options.functionCount = 20;
+		options.statementsPerFunction = 20;
+		string error = CompareLALR(ProgramGenerator(options).Generate());
+		Check(error.empty(), "program of seed " + to_string(seed) + " is invalid: " + error);
+	}
+
+	// Nesting deeper than in the generated programs
+	string expression = "1";
+	string blocks = "    a% = a% + 1\n";
+	for (int i = 0; i < 200; i++)
+	{
+		expression = "(" + expression + " + a%)";
+		blocks = "  while a% < 10\n  {\n" + blocks + "  }\n";
+	}
+	string error = CompareLALR("def main()\n{\n  a% = " + expression + "\n" + blocks + "}\n");
+	Check(error.empty(), "nested program is invalid: " + error);
+
+	// Semantic and syntax errors
+	const char *const ERRORS[] = {
+		"def main()\n{\n  a% = \"s\" - 1\n}\n",
+		"def main()\n{\n  x# = 1.5 mod 2\n}\n",
+		"def main()\n{\n  if 1\n  {\n  }\n}\n",
+		"const a% = b%\n",
+		"def main()\n{\n  a% = 1 +\n}\n",
+		"def main()\n{\n  a% = (1\n}\n",
+		"def main()\n{\n  a%[1 = 2\n}\n",
+		"def main()\n{\n  return 1 2\n}\n",
+		"def main()\n{\n  a% = 1\n",
+		"global a%\nglobal\n"
+	};
+	for (const char *text : ERRORS)
+	{
+		Check(!CompareLALR(text).empty(), string("program isn't an error: ") + text);
+	}
+}
+
+void TestParallelParser()
+{
+	GeneratorOptions options;
+	options.seed = 7;
+	options.functionCount = 60;
+	options.statementsPerFunction = 20;
+	string text = ProgramGenerator(options).Generate();
+
+	// Definitions are split into several chunks per thread
+	ThreadPool pool(4);
+	string error = CompareParallel(text, pool);
+	Check(error.empty(), "generated program is invalid: " + error);
+
+	// Constants and globals between the functions
+	string mixed;
+	istringstream source(text);
+	string line;
+	int definition = 0;
+	while (getline(source, line))
+	{
+		if (line.compare(0, 4, "def ") == 0)
+		{
+			definition++;
+			mixed += "const c" + to_string(definition) + "% = " + to_string(definition) + "\n";
+			mixed += "global g" + to_string(definition) + "#, h" + to_string(definition) + "$[]\n";
+		}
+		mixed += line + "\n";
+	}
+	error = CompareParallel(mixed, pool);
+	Check(error.empty(), "program with declarations is invalid: " + error);
+
+	// Errors in the middle and at the end are rethrown by Parse(), so they are the same
+	size_t middle = text.find("\ndef ", text.size() / 2);
+	size_t body = text.find("{\n", middle) + 2;
+	error = CompareParallel(text.substr(0, body) + "  a% = \"s\" - 1\n" + text.substr(body), pool);
+	Check(!error.empty(), "type mismatch isn't an error");
+	error = CompareParallel(text.substr(0, body) + "  a% = (1\n" + text.substr(body), pool);
+	Check(!error.empty(), "syntax error isn't an error");
+	error = CompareParallel(text + "def last()\n{\n  return 1 +\n}\n", pool);
+	Check(!error.empty(), "error in the last function isn't an error");
+
+	// Braces that aren't balanced, the definitions can't be found
+	error = CompareParallel(text.substr(0, body) + "  }\n" + text.substr(body), pool);
+	Check(!error.empty(), "extra '}' isn't an error");
+	error = CompareParallel(text + "def last()\n{\n", pool);
+	Check(!error.empty(), "missing '}' isn't an error");
+
+	// InternalError of the first chunk is thrown only after the other
+	// chunks are parsed, they refer to the tokens of the caller
+	options.functionCount = 400;
+	options.statementsPerFunction = 10;
+	string internal = "const a%[1] = 5\n" + ProgramGenerator(options).Generate();
+	string internalError;
+	try
+	{
+		ParseText(internal);
+	}
+	catch (const InternalError &ex)
+	{
+		internalError = ex.what();
+	}
+	Check(!internalError.empty(), "array in a constant declaration isn't an internal error");
+	for (int i = 0; i < 10; i++)
+	{
+		string parallelError;
+		try
+		{
+			Lexer lex;
+			TokenBuffer tokens(lex.ParseBuffer(internal.data(), internal.size()));
+			ParseParallel(tokens, pool);
+		}
+		catch (const InternalError &ex)
+		{
+			parallelError = ex.what();
+		}
+		Check(parallelError == internalError, "internal error of ParseParallel() is '" + parallelError + "'");
+	}
+
+	// Program that is too small for chunks
+	error = CompareParallel("def main()\n{\n  print(\"a\")\n}\n", pool);
+	Check(error.empty(), "small program is invalid: " + error);
+}
+
+void TestRecovery()
+{
+	// Valid programs give the same tree as Parse()
+	const char *const VALID[] = { "Adder.txt", "ArrayAssign.txt", "DoWhile.txt", "For.txt", "NewDict.txt" };
+	for (const char *name : VALID)
+	{
+		string text = ReadTestProgram(name);
+		vector<CompileError> errors;
+		string tree = DumpAst(*ParseWithRecovery(text, errors));
+		Check(errors.empty(), string(name) + " has errors: " + (errors.empty() ? "" : errors[0].what()));
+		Check(tree == DumpAst(*ParseText(text)), string(name) + " has another tree");
+	}
+
+	// Errors in a declaration and in the statements of every function,
+	// the first one is the error of Parse()
+	string text = ReadTestProgram("Recovery.txt");
+	vector<CompileError> errors;
+	shared_ptr<IAst> program = ParseWithRecovery(text, errors);
+
+	const int LINES[] = { 1, 6, 7, 14, 22 };
+	Check(errors.size() == sizeof(LINES) / sizeof(LINES[0]), to_string(errors.size()) + " errors are found");
+	for (size_t i = 0; i < errors.size(); i++)
+	{
+		string prefix = "Error at line " + to_string(LINES[i]) + ":";
+		Check(string(errors[i].what()).compare(0, prefix.size(), prefix) == 0,
+			"error " + to_string(i + 1) + " is " + errors[i].what());
+	}
+	Check(errors[0].what() == GetParseError(text), "first error isn't the error of Parse()");
+
+	// Functions are kept without the statements that have errors
+	const AstList *definitions = Cast<AstList>(program.get());
+	Check(definitions->GetElements().size() == 3, to_string(definitions->GetElements().size()) +
+		" definitions are kept");
+	const char *const NAMES[] = { "first", "second", "main" };
+	for (size_t i = 0; i < 3; i++)
+	{
+		const AstFunction *function = DynCast<AstFunction>(definitions->GetElements()[i]);
+		Check(function && function->GetName() == NAMES[i], string("function ") + NAMES[i] + " isn't kept");
+	}
+	const AstFunction *main = Cast<AstFunction>(definitions->GetElements()[2]);
+	Check(main->GetCode()->GetElements().size() == 1, "statements of main() aren't kept");
+
+	// A constant the parser can't build (InternalError of Parse()) is
+	// recorded and skipped like the other wrong definitions
+	text =
+		"const a%[1] = 5\n"
+		"def main()\n"
+		"{\n"
+		"  c% = 1\n"
+		"}\n"
+		"const b%[2] = 1\n"
+		"const d% = 2\n";
+	errors.clear();
+	program = ParseWithRecovery(text, errors);
+	Check(errors.size() == 2, to_string(errors.size()) + " internal errors are found");
+	for (size_t i = 0; i < errors.size(); i++)
+	{
+		string prefix = "Error at line " + to_string(i == 0 ? 1 : 6) + ": Internal error:";
+		Check(string(errors[i].what()).compare(0, prefix.size(), prefix) == 0,
+			"internal error " + to_string(i + 1) + " is " + errors[i].what());
+	}
+	definitions = Cast<AstList>(program.get());
+	Check(definitions->GetElements().size() == 2, to_string(definitions->GetElements().size()) +
+		" definitions are kept after internal errors");
+	Check(DynCast<AstFunction>(definitions->GetElements()[0]) != nullptr, "main() isn't kept after an internal error");
+}
+
+void TestHashConsing()
+{
+	// Trees are the same, only the nodes are shared
+	GeneratorOptions options;
+	options.seed = 4;
+	options.functionCount = 20;
+	options.statementsPerFunction = 30;
+	string text = ProgramGenerator(options).Generate();
+
+	size_t nodeCount, sharedNodeCount;
+	string tree = DumpAst(*ParseHashConsing(text, false, nodeCount));
+	Check(DumpAst(*ParseHashConsing(text, true, sharedNodeCount)) == tree, "shared tree differs");
+	Check(sharedNodeCount < nodeCount, to_string(sharedNodeCount) + " shared nodes of " + to_string(nodeCount));
+
+	const char *const PROGRAMS[] = { "Adder.txt", "ArrayAssign.txt", "Constants.txt", "For.txt", "NewDict.txt" };
+	for (const char *name : PROGRAMS)
+	{
+		text = ReadTestProgram(name);
+		Check(DumpAst(*ParseHashConsing(text, true, sharedNodeCount)) ==
+			DumpAst(*ParseHashConsing(text, false, nodeCount)), string("shared tree of ") + name + " differs");
+	}
+
+	// Equal expressions of a function are one node, but calls,
+	// array values and expressions of other functions aren't
+	text =
+		"def first%(i%)\n"
+		"{\n"
+		"  a% = (i% + 1) * 2\n"
+		"  i% = 5\n"
+		"  b% = (i% + 1) * 2\n"
+		"  c% = first%(i%) + first%(i%)\n"
+		"  m%[] = new array%(3)\n"
+		"  d% = m%[i% + 1] + m%[i% + 1]\n"
+		"  return a%\n"
+		"}\n"
+		"def second%(i%)\n"
+		"{\n"
+		"  a% = (i% + 1) * 2\n"
+		"  return a%\n"
+		"}\n";
+	shared_ptr<IAst> program = ParseHashConsing(text, true, sharedNodeCount);
+	Check(GetAssigned(program.get(), 0, 0) == GetAssigned(program.get(), 0, 2), "equal expressions aren't shared");
+	Check(GetAssigned(program.get(), 0, 0) != GetAssigned(program.get(), 1, 0), "expressions of two functions are shared");
+
+	const AstBinaryExpression *calls = Cast<AstBinaryExpression>(GetAssigned(program.get(), 0, 3));
+	Check(calls->GetLeft() != calls->GetRight(), "calls are shared");
+	const AstBinaryExpression *values = Cast<AstBinaryExpression>(GetAssigned(program.get(), 0, 5));
+	Check(values->GetLeft() != values->GetRight(), "array values are shared");
+	const AstList *firstIndexes = Cast<AstArrayValue>(values->GetLeft())->GetIndexes();
+	const AstList *secondIndexes = Cast<AstArrayValue>(values->GetRight())->GetIndexes();
+	Check(firstIndexes->GetElements()[0] == secondIndexes->GetElements()[0], "indexes aren't shared");
+
+	Check(DumpAst(*program) == DumpAst(*ParseHashConsing(text, false, nodeCount)), "shared tree differs");
+}
+
+void TestConstantFolding()
+{
+	// Value of "i% = <expression>" in main()
+	struct Folding
+	{
+		const char *expression;
+		int value;
+	};
+	const Folding FOLDINGS[] = {
+		{ "7 / 2", 3 }, { "~7 / 2", -3 }, { "7 mod ~2", 1 }, { "~7 mod 2", -1 },
+		{ "~2147483648 / 1", INT_MIN }, { "~2147483648 / 2", -1073741824 },
+		{ "~2147483648 mod ~1", 0 }, { "~2147483648 mod 3", -2 }, { "2147483647 / ~1", -2147483647 }
+	};
+	for (const Folding &folding : FOLDINGS)
+	{
+		string text = string("def main()\n{\n  i% = ") + folding.expression + "\n}\n";
+		Check(CompareLALR(text).empty(), string(folding.expression) + " is an error");
+		shared_ptr<IAst> program = ParseText(text);
+		const AstIntConst *value = DynCast<AstIntConst>(GetAssigned(program.get(), 0, 0));
+		Check(value && value->GetValue() == folding.value, string(folding.expression) + " isn't folded to " +
+			to_string(folding.value));
+	}
+
+	// Errors instead of the trap of the machine division
+	const char *const ERRORS[] = { "~2147483648 / ~1", "1 / 0", "1 mod 0", "(~2147483647 - 1) / ~1" };
+	const char *const MESSAGES[] = { "Integer overflow", "Division by zero", "Division by zero", "Integer overflow" };
+	for (size_t i = 0; i < sizeof(ERRORS) / sizeof(ERRORS[0]); i++)
+	{
+		string text = string("def main()\n{\n  i% = ") + ERRORS[i] + "\n}\n";
+		string error = CompareLALR(text);
+		Check(error.find(MESSAGES[i]) != string::npos, string(ERRORS[i]) + " gives '" + error + "'");
+	}
+}
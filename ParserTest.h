@@ -0,0 +1,19 @@
+#pragma once
+
+// IncrementalParser::Edit() makes the same program as parsing the whole text
+void TestIncrementalParser();
+
+// ParseLALR() makes the same trees and errors as Parse()
+void TestLALRParser();
+
+// ParseParallel() makes the same trees and errors as Parse()
+void TestParallelParser();
+
+// ParseWithRecovery() reports every error and keeps the valid definitions
+void TestRecovery();
+
+// Hash-consing shares equal expressions of a function without changing the tree
+void TestHashConsing();
+
+// Folding of constant expressions, including the edge cases of int division
+void TestConstantFolding();
@@ -70,7 +70,7 @@ void PrintVisitor::visit(const AstList &ref)
 {
 	cout << "AstList<" << endl;
 
-	for (shared_ptr<IAst> statement : ref.GetElements())
+	for (IAst *statement : ref.GetElements())
 	{
 		statement->accept(*this);
 		cout << endl;
@@ -0,0 +1,517 @@
+#include "ProgramGenerator.h"
+
+using namespace std;
+
+GeneratorOptions::GeneratorOptions()
+	: seed(1)
+	, functionCount(100)
+	, statementsPerFunction(20)
+	, maxBlockDepth(3)
+	, maxExpressionDepth(4)
+{
+}
+
+ProgramGenerator::ProgramGenerator(const GeneratorOptions &options)
+	: m_options(options)
+	, m_state(0)
+	, m_lineCount(0)
+	, m_statementCount(0)
+	, m_function(0)
+{
+}
+
+string ProgramGenerator::Generate()
+{
+	Reset();
+	Constants();
+	Globals();
+	for (m_function = 0; m_function < m_options.functionCount; m_function++)
+	{
+		Function(m_function);
+	}
+	Main();
+
+	return m_text;
+}
+
+string ProgramGenerator::GenerateVariables(unsigned count)
+{
+	Reset();
+	for (unsigned i = 0; i < count; i++)
+	{
+		string line = i == 0 ? "global " : "";
+		line += VariableDeclaration(i);
+		if (i + 1 < count)
+		{
+			line += ",";
+		}
+		Line(i == 0 ? 0 : 1, line);
+	}
+	return m_text;
+}
+
+string ProgramGenerator::GenerateNewExpressions(unsigned count)
+{
+	Reset();
+	Line(0, "def main()");
+	Line(0, "{");
+	for (unsigned i = 0; i < count; i++)
+	{
+		string line = i == 0 ? "f(" : "";
+		line += NewExpression();
+		line += i + 1 < count ? "," : ")";
+		Line(i == 0 ? 1 : 2, line);
+	}
+	Line(0, "}");
+	m_statementCount++;
+	return m_text;
+}
+
+size_t ProgramGenerator::GetLineCount() const
+{
+	return m_lineCount;
+}
+
+size_t ProgramGenerator::GetStatementCount() const
+{
+	return m_statementCount;
+}
+
+size_t ProgramGenerator::GetFunctionCount() const
+{
+	return m_options.functionCount + 1;
+}
+
+unsigned ProgramGenerator::Random(unsigned bound)
+{
+	// Own generator instead of <random> distributions,
+	// which give different sequences with different libraries
+	m_state ^= m_state << 13;
+	m_state ^= m_state >> 17;
+	m_state ^= m_state << 5;
+	return m_state % bound;
+}
+
+bool ProgramGenerator::Chance(unsigned percent)
+{
+	return Random(100) < percent;
+}
+
+void ProgramGenerator::Reset()
+{
+	// Xorshift never leaves the zero state
+	m_state = m_options.seed != 0 ? m_options.seed : 1;
+	m_text.clear();
+	m_lineCount = 0;
+	m_statementCount = 0;
+}
+
+void ProgramGenerator::Line(unsigned indent, const string &text)
+{
+	m_text.append(indent * 2, ' ');
+	m_text += text;
+	m_text += '\n';
+	m_lineCount++;
+}
+
+void ProgramGenerator::Constants()
+{
+	Line(0, "const n% = 10, pi# = 3.14, greet$ = \"hello\"");
+	Line(0, "const limit% = ~100, flag! = 1 <= 2");
+	Line(0, "");
+}
+
+void ProgramGenerator::Globals()
+{
+	Line(0, "global g%, gm%[][], gd$%()");
+	Line(0, "");
+}
+
+void ProgramGenerator::Function(unsigned index)
+{
+	VALUE_TYPE type = static_cast<VALUE_TYPE>(index % 4);
+
+	Line(0, "` function " + ToString(index));
+	Line(0, "def " + FunctionName(index) + Suffix(type) + "(a%, b#)");
+	Line(0, "{");
+	Locals(1);
+	Statements(1, m_options.statementsPerFunction, 0);
+	Line(1, "return " + Expression(type, m_options.maxExpressionDepth));
+	m_statementCount++;
+	Line(0, "}");
+	Line(0, "");
+}
+
+void ProgramGenerator::Main()
+{
+	Line(0, "def main()");
+	Line(0, "{");
+	Line(1, "a% = n%");
+	Line(1, "b# = pi#");
+	m_statementCount += 2;
+	Locals(1);
+	Statements(1, m_options.statementsPerFunction, 0);
+	Line(0, "}");
+}
+
+void ProgramGenerator::Locals(unsigned indent)
+{
+	Line(indent, "x0% = a%");
+	Line(indent, "x1% = " + IntExpression(m_options.maxExpressionDepth));
+	Line(indent, "x2% = 0");
+	Line(indent, "y0# = b# * 2.5");
+	Line(indent, "s0$ = \"s\" + a$");
+	Line(indent, "c0! = a% > 0");
+	Line(indent, "m%[][] = new array%(4, 4)");
+	Line(indent, "d$#() = new dict$#()");
+	m_statementCount += 8;
+}
+
+void ProgramGenerator::Statements(unsigned indent, unsigned count, unsigned depth)
+{
+	for (unsigned i = 0; i < count; i++)
+	{
+		Statement(indent, depth);
+	}
+}
+
+void ProgramGenerator::Statement(unsigned indent, unsigned depth)
+{
+	unsigned exprDepth = m_options.maxExpressionDepth;
+	unsigned kinds = depth < m_options.maxBlockDepth ? 11 : 7;
+
+	m_statementCount++;
+	switch (Random(kinds))
+	{
+	case 0:
+	{
+		string name = "x" + ToString(Random(3)) + "%";
+		Line(indent, name + " = " + IntExpression(exprDepth));
+		break;
+	}
+	case 1:
+		Line(indent, "y0# = " + FloatExpression(exprDepth));
+		break;
+	case 2:
+		Line(indent, "s0$ = " + StringExpression(exprDepth));
+		break;
+	case 3:
+		Line(indent, "c0! = " + BoolExpression(exprDepth));
+		break;
+	case 4:
+	{
+		string element = ArrayElement();
+		Line(indent, element + " = " + IntExpression(exprDepth));
+		break;
+	}
+	case 5:
+	{
+		string key = StringExpression(exprDepth / 2);
+		Line(indent, "d$#(" + key + ") = " + FloatExpression(exprDepth));
+		break;
+	}
+	case 6:
+	{
+		string function = Chance(50) ? "print" : "printn";
+		Line(indent, function + "(" + StringExpression(exprDepth) + ")");
+		break;
+	}
+	case 7:
+	{
+		string header = "for i" + ToString(depth) + "% = " + IntExpression(1);
+		header += " to " + IntExpression(exprDepth);
+		if (Chance(50))
+		{
+			header += " step " + ToString(1 + Random(5));
+		}
+		Line(indent, header);
+		Block(indent, depth + 1, "}");
+		break;
+	}
+	case 8:
+		Line(indent, "while " + BoolExpression(exprDepth));
+		Block(indent, depth + 1, "}");
+		break;
+	case 9:
+		Line(indent, "do");
+		// Closing brace and condition of do-while share the line
+		Block(indent, depth + 1, "} while " + BoolExpression(exprDepth));
+		break;
+	case 10:
+		Line(indent, "if " + BoolExpression(exprDepth));
+		Block(indent, depth + 1, "}");
+		if (Chance(50))
+		{
+			Line(indent, "else");
+			Block(indent, depth + 1, "}");
+		}
+		break;
+	}
+}
+
+void ProgramGenerator::Block(unsigned indent, unsigned depth, const string &closing)
+{
+	Line(indent, "{");
+	Statements(indent + 1, 1 + Random(3), depth);
+	Line(indent, closing);
+}
+
+string ProgramGenerator::Expression(VALUE_TYPE type, unsigned depth)
+{
+	switch (type)
+	{
+	case VALUE_INT:
+		return IntExpression(depth);
+	case VALUE_FLOAT:
+		return FloatExpression(depth);
+	case VALUE_STRING:
+		return StringExpression(depth);
+	default:
+		return BoolExpression(depth);
+	}
+}
+
+// Parts of an expression are built one by one in separate statements:
+// order of evaluation of operands is unspecified, and building them
+// in one expression could consume random numbers in another order
+// with another compiler
+
+string ProgramGenerator::IntExpression(unsigned depth)
+{
+	// Operators are chosen more often than leaves, so expressions
+	// usually reach the maximum depth
+	if (depth > 0 && Chance(70))
+	{
+		static const char *const OPERATORS[] = { " + ", " - ", " * ", " / ", " mod " };
+		switch (Random(8))
+		{
+		case 0:
+			return "(" + IntExpression(depth - 1) + ")";
+		case 1:
+			return "~" + IntExpression(depth - 1);
+		case 2:
+			return Call(VALUE_INT, depth - 1);
+		default:
+		{
+			string result = IntExpression(depth - 1);
+			unsigned op = Random(5);
+			result += OPERATORS[op];
+			// Constant divisions are folded by the parser, a divisor
+			// that folds to 0 would make the program invalid
+			result += op >= 3 ? ToString(1 + Random(999)) : IntExpression(depth - 1);
+			return result;
+		}
+		}
+	}
+
+	switch (Random(6))
+	{
+	case 0:
+		return ToString(Random(1000));
+	case 1:
+		return "a%";
+	case 2:
+		return "x" + ToString(Random(3)) + "%";
+	case 3:
+		return ArrayElement();
+	case 4:
+		return Chance(50) ? "n%" : "g%";
+	default:
+		return ToString(Random(100000));
+	}
+}
+
+string ProgramGenerator::FloatExpression(unsigned depth)
+{
+	if (depth > 0 && Chance(70))
+	{
+		static const char *const OPERATORS[] = { " + ", " - ", " * ", " / " };
+		switch (Random(6))
+		{
+		case 0:
+			return "(" + FloatExpression(depth - 1) + ")";
+		case 1:
+			return Call(VALUE_FLOAT, depth - 1);
+		default:
+		{
+			string result = FloatExpression(depth - 1);
+			unsigned op = Random(4);
+			result += OPERATORS[op];
+			if (op == 3)
+			{
+				// Same as for int divisors
+				result += ToString(1 + Random(99));
+				result += "." + ToString(Random(100));
+			}
+			else
+			{
+				result += FloatExpression(depth - 1);
+			}
+			return result;
+		}
+		}
+	}
+
+	switch (Random(5))
+	{
+	case 0:
+	{
+		string result = ToString(Random(100));
+		result += "." + ToString(Random(100));
+		return result;
+	}
+	case 1:
+		return "b#";
+	case 2:
+		return "y0#";
+	case 3:
+		return "d$#(\"k" + ToString(Random(10)) + "\")";
+	default:
+		return Chance(50) ? "pi#" : "~1.5";
+	}
+}
+
+string ProgramGenerator::StringExpression(unsigned depth)
+{
+	if (depth > 0 && Chance(60))
+	{
+		if (Random(4) == 0)
+		{
+			return Call(VALUE_STRING, depth - 1);
+		}
+		string result = StringExpression(depth - 1);
+		result += " + ";
+		result += StringExpression(depth - 1);
+		return result;
+	}
+
+	switch (Random(5))
+	{
+	case 0:
+		return "\"text " + ToString(Random(1000)) + "\"";
+	case 1:
+		return "s0$";
+	case 2:
+		return "x" + ToString(Random(3)) + "$";
+	case 3:
+		return "greet$";
+	default:
+		return "y0$";
+	}
+}
+
+string ProgramGenerator::BoolExpression(unsigned depth)
+{
+	if (depth > 0 && Chance(70))
+	{
+		static const char *const COMPARISONS[] = { " == ", " <> ", " < ", " <= ", " > ", " >= " };
+		switch (Random(6))
+		{
+		case 0:
+			return "not (" + BoolExpression(depth - 1) + ")";
+		case 1:
+		{
+			string result = BoolExpression(depth - 1);
+			result += Chance(50) ? " and " : " or ";
+			result += BoolExpression(depth - 1);
+			return result;
+		}
+		case 2:
+			return Call(VALUE_BOOL, depth - 1);
+		default:
+		{
+			string result = IntExpression(depth - 1);
+			result += COMPARISONS[Random(6)];
+			result += IntExpression(depth - 1);
+			return result;
+		}
+		}
+	}
+
+	switch (Random(3))
+	{
+	case 0:
+		return "c0!";
+	case 1:
+		return "flag!";
+	default:
+		return "x" + ToString(Random(3)) + "% < n%";
+	}
+}
+
+string ProgramGenerator::ArrayElement()
+{
+	string result = "m%[" + ToString(Random(4));
+	result += "][" + ToString(Random(4)) + "]";
+	return result;
+}
+
+string ProgramGenerator::VariableDeclaration(unsigned index)
+{
+	string result = "v" + ToString(index) + Suffix(static_cast<VALUE_TYPE>(Random(4)));
+	switch (Random(3))
+	{
+	case 0:
+		break;
+	case 1:
+		for (unsigned i = Random(3); i < 4; i++)
+		{
+			result += "[]";
+		}
+		break;
+	default:
+		result += Suffix(static_cast<VALUE_TYPE>(Random(4)));
+		result += "()";
+		break;
+	}
+	return result;
+}
+
+string ProgramGenerator::NewExpression()
+{
+	if (Chance(50))
+	{
+		string result = "new dict";
+		result += Suffix(static_cast<VALUE_TYPE>(Random(4)));
+		result += Suffix(static_cast<VALUE_TYPE>(Random(4)));
+		return result + "()";
+	}
+	string result = "new array";
+	result += Suffix(static_cast<VALUE_TYPE>(Random(4)));
+	result += "(" + ToString(Random(16) + 1);
+	for (unsigned i = Random(4); i < 3; i++)
+	{
+		result += ", " + ToString(Random(16) + 1);
+	}
+	return result + ")";
+}
+
+string ProgramGenerator::Call(VALUE_TYPE type, unsigned depth)
+{
+	// Function with index i returns the type i % 4
+	unsigned callable = (m_function + 3 - type) / 4;
+	if (callable == 0)
+	{
+		return Expression(type, depth);
+	}
+	unsigned index = Random(callable) * 4 + type;
+	string result = FunctionName(index) + Suffix(type) + "(" + IntExpression(depth);
+	result += ", " + FloatExpression(depth) + ")";
+	return result;
+}
+
+string ProgramGenerator::FunctionName(unsigned index)
+{
+	return "f" + ToString(index);
+}
+
+const char *ProgramGenerator::Suffix(VALUE_TYPE type)
+{
+	static const char *const SUFFIXES[] = { "%", "#", "$", "!" };
+	return SUFFIXES[type];
+}
+
+string ProgramGenerator::ToString(unsigned value)
+{
+	return to_string(value);
+}
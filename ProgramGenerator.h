@@ -0,0 +1,90 @@
+#pragma once
+#include <string>
+
+struct GeneratorOptions
+{
+	GeneratorOptions();
+
+	unsigned seed;
+	// Number of functions besides main
+	unsigned functionCount;
+	// Number of statements in the body of each function (nested ones aren't counted)
+	unsigned statementsPerFunction;
+	// Maximum nesting of for/while/do/if blocks
+	unsigned maxBlockDepth;
+	// Maximum nesting of operators and parentheses in an expression
+	unsigned maxExpressionDepth;
+};
+
+// Writes random syntactically valid Backslash programs of any size
+// - Programs consist of constants, globals and functions with nested
+// loops, conditions, arrays, dictionaries, calls and deep expressions
+// - The same options give the same text on every platform
+// - Functions only call the ones defined before them, names and types
+// of variables are consistent within a function
+class ProgramGenerator
+{
+public:
+	explicit ProgramGenerator(const GeneratorOptions &options);
+
+	std::string Generate();
+
+	// Corpora of single constructs for comparing the parsing engines
+	// that handle only a part of the language (see Benchmark.cpp)
+	// - 'global' with count declarations of simple, array and dict variables
+	std::string GenerateVariables(unsigned count);
+	// - main() passing count 'new' expressions of arrays and dicts to a call
+	std::string GenerateNewExpressions(unsigned count);
+
+	// Statistics of the last generated program
+	size_t GetLineCount() const;
+	size_t GetStatementCount() const;
+	size_t GetFunctionCount() const;
+
+private:
+	enum VALUE_TYPE
+	{
+		VALUE_INT,
+		VALUE_FLOAT,
+		VALUE_STRING,
+		VALUE_BOOL
+	};
+
+	GeneratorOptions m_options;
+	unsigned m_state;
+	std::string m_text;
+	size_t m_lineCount;
+	size_t m_statementCount;
+	// Index of the function being generated, it may call functions [0, m_function)
+	unsigned m_function;
+
+	unsigned Random(unsigned bound);
+	bool Chance(unsigned percent);
+
+	void Reset();
+	void Line(unsigned indent, const std::string &text);
+
+	void Constants();
+	void Globals();
+	void Function(unsigned index);
+	void Main();
+	void Locals(unsigned indent);
+	void Statements(unsigned indent, unsigned count, unsigned depth);
+	void Statement(unsigned indent, unsigned depth);
+	// closing is the last line of the block
+	void Block(unsigned indent, unsigned depth, const std::string &closing);
+
+	std::string Expression(VALUE_TYPE type, unsigned depth);
+	std::string IntExpression(unsigned depth);
+	std::string FloatExpression(unsigned depth);
+	std::string StringExpression(unsigned depth);
+	std::string BoolExpression(unsigned depth);
+	std::string ArrayElement();
+	std::string VariableDeclaration(unsigned index);
+	std::string NewExpression();
+	std::string Call(VALUE_TYPE type, unsigned depth);
+
+	static std::string FunctionName(unsigned index);
+	static const char *Suffix(VALUE_TYPE type);
+	static std::string ToString(unsigned value);
+};
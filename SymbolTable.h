@@ -1,15 +1,18 @@
 #pragma once
 #include <vector>
-#include <map>
+#include <unordered_map>
 #include <string>
 #include <memory>
 #include "Exception.h"
+#include "Interner.h"
 
 // ==  
 // -   -   map'
 // -      
 // -        
-// - ,   T   const string &GetName()
+// - ,   T   const string &GetName()  Atom GetAtom()
+// - Symbols are looked up by atom, a string name that was never interned
+// isn't defined (looking it up doesn't intern it)
 template<class T> class SymbolTable
 {
 public:
@@ -17,30 +20,51 @@ public:
 	{
 	}
 
-	bool IsDefined(const std::string &name) const
+	bool IsDefined(Atom name) const
 	{
 		return m_indexTable.find(name) != m_indexTable.end();
 	}
 
+	bool IsDefined(const std::string &name) const
+	{
+		Atom atom = Interner::Find(name);
+		return atom != Interner::NO_ATOM && IsDefined(atom);
+	}
+
 	void Define(std::shared_ptr<T> symb)
 	{
-		const std::string &name = symb->GetName();
+		Atom name = symb->GetAtom();
 
 		if (IsDefined(name))
 		{
-			throw IntermediateError("Symbol '" + name + "' was already defined");
+			throw IntermediateError("Symbol '" + symb->GetName() + "' was already defined");
 		}
 
 		m_symbols.push_back(symb);
 		m_indexTable[name] = m_symbols.size() - 1;
 	}
 
-	unsigned int GetIndex(const std::string &name) const
+	unsigned int GetIndex(Atom name) const
 	{
 		AssertSymbolIsDefined(name);
 		return m_indexTable.at(name);
 	}
 
+	unsigned int GetIndex(const std::string &name) const
+	{
+		Atom atom = Interner::Find(name);
+		if (atom == Interner::NO_ATOM)
+		{
+			throw IntermediateError("Symbol '" + name + "' is undefined");
+		}
+		return GetIndex(atom);
+	}
+
+	std::shared_ptr<T> Get(Atom name) const
+	{
+		return m_symbols[GetIndex(name)];
+	}
+
 	std::shared_ptr<T> Get(const std::string &name) const
 	{
 		return m_symbols[GetIndex(name)];
@@ -57,14 +81,14 @@ public:
 	}
 
 private:
-	std::map<std::string, unsigned> m_indexTable;
+	std::unordered_map<Atom, unsigned> m_indexTable;
 	std::vector<std::shared_ptr<T>> m_symbols;
 
-	void AssertSymbolIsDefined(const std::string &name) const
+	void AssertSymbolIsDefined(Atom name) const
 	{
 		if (!IsDefined(name))
 		{
-			throw IntermediateError("Symbol '" + name + "' is undefined");
+			throw IntermediateError("Symbol '" + Interner::GetString(name) + "' is undefined");
 		}
 	}
 };
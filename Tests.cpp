@@ -0,0 +1,60 @@
+#include <iostream>
+#include "Exception.h"
+#include "Parser.h"
+#include "AstCacheTest.h"
+#include "GeneratorTest.h"
+#include "LexerTest.h"
+#include "ParserTest.h"
+
+using namespace std;
+
+// Runs the tests of the front end, see UnitTest.h
+// - Must be started in the directory with "Test programs"
+// - Returns the number of the failed tests
+
+struct UnitTestCase
+{
+	const char *name;
+	void (*run)();
+};
+
+const UnitTestCase TESTS[] =
+{
+	{ "Generator", &TestGenerator },
+	{ "Scanner", &TestScanner },
+	{ "Interner", &TestInterner },
+	{ "ParallelLexer", &TestParallelLexer },
+	{ "Numbers", &TestNumbers },
+	{ "LineTable", &TestLineTable },
+	{ "StreamLexer", &TestStreamLexer },
+	{ "IncrementalParser", &TestIncrementalParser },
+	{ "LALRParser", &TestLALRParser },
+	{ "ParallelParser", &TestParallelParser },
+	{ "Recovery", &TestRecovery },
+	{ "HashConsing", &TestHashConsing },
+	{ "ConstantFolding", &TestConstantFolding },
+	{ "AstCache", &TestAstCache },
+};
+
+int main()
+{
+	InitOperatorMap();
+
+	int failed = 0;
+	for (const UnitTestCase &test : TESTS)
+	{
+		try
+		{
+			test.run();
+			cout << test.name << ": passed\n";
+		}
+		catch (const exception &ex)
+		{
+			++failed;
+			cout << test.name << ": FAILED\n  " << ex.what() << "\n";
+		}
+	}
+
+	cout << failed << " of " << sizeof(TESTS) / sizeof(TESTS[0]) << " tests failed\n";
+	return failed;
+}
@@ -0,0 +1,79 @@
+#include "ThreadPool.h"
+
+using namespace std;
+
+ThreadPool::ThreadPool(unsigned threadCount)
+	: m_stopping(false)
+{
+	if (threadCount == 0)
+	{
+		threadCount = thread::hardware_concurrency();
+	}
+	if (threadCount == 0)
+	{
+		threadCount = 1;
+	}
+
+	for (unsigned i = 0; i < threadCount; i++)
+	{
+		m_workers.push_back(thread(&ThreadPool::WorkerLoop, this));
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard<mutex> lock(m_lock);
+		m_stopping = true;
+	}
+	m_taskAdded.notify_all();
+
+	for (auto &worker : m_workers)
+	{
+		worker.join();
+	}
+}
+
+future<void> ThreadPool::Submit(function<void()> task)
+{
+	packaged_task<void()> packagedTask(task);
+	future<void> result = packagedTask.get_future();
+
+	{
+		lock_guard<mutex> lock(m_lock);
+		m_tasks.push(move(packagedTask));
+	}
+	m_taskAdded.notify_one();
+
+	return result;
+}
+
+unsigned ThreadPool::GetThreadCount() const
+{
+	return m_workers.size();
+}
+
+void ThreadPool::WorkerLoop()
+{
+	while (true)
+	{
+		packaged_task<void()> task;
+
+		{
+			unique_lock<mutex> lock(m_lock);
+			while (m_tasks.empty() && !m_stopping)
+			{
+				m_taskAdded.wait(lock);
+			}
+			if (m_tasks.empty())
+			{
+				return;
+			}
+
+			task = move(m_tasks.front());
+			m_tasks.pop();
+		}
+
+		task();
+	}
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <functional>
+
+// Fixed set of worker threads running queued tasks
+// - Tasks are run in the order they were submitted
+// - Destructor waits for the queued tasks to finish
+class ThreadPool
+{
+public:
+	// threadCount = 0 means one thread per hardware thread
+	explicit ThreadPool(unsigned threadCount = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool &) = delete;
+	ThreadPool &operator=(const ThreadPool &) = delete;
+
+	// Queues the task
+	// - Exception thrown by the task is rethrown by get() of the returned future
+	std::future<void> Submit(std::function<void()> task);
+
+	unsigned GetThreadCount() const;
+
+private:
+	std::vector<std::thread> m_workers;
+	std::queue<std::packaged_task<void()>> m_tasks;
+	std::mutex m_lock;
+	std::condition_variable m_taskAdded;
+	bool m_stopping;
+
+	void WorkerLoop();
+};
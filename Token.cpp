@@ -4,56 +4,60 @@
 
 using namespace std;
 
-Token::Token(TOKEN_TYPE type, const InputStream &is, int offset)
-	: m_type(type)
+Token::Token()
+{
+}
 
-	, m_line(is.GetLine())
+Token::Token(TOKEN_TYPE type, const InputStream &is, int offset)
+	: m_lines(is.GetLineTable())
+	, m_line(is.GetLineIndex())
 	, m_lineNumber(is.GetLineNumber())
 	, m_offset(offset)
+	, m_type(type)
 {
 	assert(type == TOKEN_ERROR || type == TOKEN_EOF);
 }
 
 Token::Token(TOKEN_TYPE type, double value, const InputStream &is, int offset)
-	: m_type(type)
+	: m_lines(is.GetLineTable())
 	, m_fvalue(value)
-
-	, m_line(is.GetLine())
+	, m_line(is.GetLineIndex())
 	, m_lineNumber(is.GetLineNumber())
 	, m_offset(offset)
+	, m_type(type)
 {
 	assert(type == TOKEN_FLOAT);
 }
 
 Token::Token(TOKEN_TYPE type, int value, const InputStream &is, int offset)
-	: m_type(type)
+	: m_lines(is.GetLineTable())
 	, m_ivalue(value)
-
-	, m_line(is.GetLine())
+	, m_line(is.GetLineIndex())
 	, m_lineNumber(is.GetLineNumber())
 	, m_offset(offset)
+	, m_type(type)
 {
 	assert(type == TOKEN_INT);
 }
 
-Token::Token(TOKEN_TYPE type, const string &value, const InputStream &is, int offset)
-	: m_type(type)
-	, m_svalue(value)
-
-	, m_line(is.GetLine())
+Token::Token(TOKEN_TYPE type, Atom value, const InputStream &is, int offset)
+	: m_lines(is.GetLineTable())
+	, m_avalue(value)
+	, m_line(is.GetLineIndex())
 	, m_lineNumber(is.GetLineNumber())
 	, m_offset(offset)
+	, m_type(type)
 {
 	assert(type == TOKEN_STRING || type == TOKEN_ID);
 }
 
 Token::Token(TOKEN_TYPE type, KEYWORD value, const InputStream &is, int offset)
-	: m_type(type)
+	: m_lines(is.GetLineTable())
 	, m_kvalue(value)
-
-	, m_line(is.GetLine())
+	, m_line(is.GetLineIndex())
 	, m_lineNumber(is.GetLineNumber())
 	, m_offset(offset)
+	, m_type(type)
 {
 	assert(type == TOKEN_DELIMETER || type == TOKEN_KEYWORD);
 }
@@ -70,6 +74,30 @@ Token Token::TokenEOF(const InputStream &is, int offset)
 	return Token(TOKEN_EOF, is, offset);
 }
 
+Token Token::TokenEOF(const Token &lastToken)
+{
+	Token result(lastToken);
+
+	result.m_type = TOKEN_EOF;
+	result.m_offset = lastToken.m_lines ? lastToken.m_lines->GetLength(lastToken.m_line) : 0;
+
+	return result;
+}
+
+Token Token::TokenEOF()
+{
+	Token result;
+
+	result.m_lines = nullptr;
+	result.m_ivalue = 0;
+	result.m_line = 0;
+	result.m_lineNumber = 1;
+	result.m_offset = 0;
+	result.m_type = TOKEN_EOF;
+
+	return result;
+}
+
 Token Token::TokenFloat(double value, const InputStream &is, int offset)
 {
 	return Token(TOKEN_FLOAT, value, is, offset);
@@ -80,12 +108,12 @@ Token Token::TokenInt(int value, const InputStream &is, int offset)
 	return Token(TOKEN_INT, value, is, offset);
 }
 
-Token Token::TokenString(const std::string &value, const InputStream &is, int offset)
+Token Token::TokenString(Atom value, const InputStream &is, int offset)
 {
 	return Token(TOKEN_STRING, value, is, offset);
 }
 
-Token Token::TokenID(const std::string &value, const InputStream &is, int offset)
+Token Token::TokenID(Atom value, const InputStream &is, int offset)
 {
 	return Token(TOKEN_ID, value, is, offset);
 }
@@ -100,6 +128,12 @@ Token Token::TokenKeyword(KEYWORD value, const InputStream &is, int offset)
 	return Token(TOKEN_KEYWORD, value, is, offset);
 }
 
+void Token::RebaseLine(const LineTable *lines, unsigned lineShift)
+{
+	m_lines = lines;
+	m_line += lineShift;
+}
+
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
 TOKEN_TYPE Token::GetType() const
@@ -163,10 +197,16 @@ int Token::GetValueI() const
 	return m_ivalue;
 }
 
-const string Token::GetValueS() const
+const string &Token::GetValueS() const
 {
 	assert(GetType() == TOKEN_STRING || GetType() == TOKEN_ID);
-	return m_svalue;
+	return Interner::GetString(m_avalue);
+}
+
+Atom Token::GetValueA() const
+{
+	assert(GetType() == TOKEN_STRING || GetType() == TOKEN_ID);
+	return m_avalue;
 }
 
 KEYWORD Token::GetValueK() const
@@ -177,9 +217,9 @@ KEYWORD Token::GetValueK() const
 
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-
 
-const char *Token::GetLine() const
+string Token::GetLine() const
 {
-	return m_line.c_str();
+	return m_lines ? m_lines->GetLine(m_line) : string();
 }
 
 int Token::GetLineNumber() const
@@ -191,3 +231,8 @@ int Token::GetOffset() const
 {
 	return m_offset;
 }
+
+unsigned Token::GetLineIndex() const
+{
+	return m_line;
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include <string>
 #include "InputStream.h"
+#include "LineTable.h"
+#include "Interner.h"
 
 // preprocessor magic
 
@@ -14,51 +16,66 @@
 		FOREACH(GENERATE_STRING)				\
 	};
 
-#define ENUM_KEYWORD(DECL)	\
-	DECL(KW_CONST)			\
-	DECL(KW_GLOBAL)			\
-	DECL(KW_DEF)			\
-	DECL(KW_RETURN)			\
-	DECL(KW_IF)				\
-	DECL(KW_ELSE)			\
-	DECL(KW_DO)				\
-	DECL(KW_WHILE)			\
-	DECL(KW_FOR)			\
-	DECL(KW_TO)				\
-	DECL(KW_STEP)			\
-	DECL(KW_ASSIGN)			\
-	DECL(KW_COMMA)			\
-	DECL(KW_BRACE_L)		\
-	DECL(KW_BRACE_R)		\
-	DECL(KW_BLOCK_L)		\
-	DECL(KW_BLOCK_R)		\
-	DECL(KW_INDEX_L)		\
-	DECL(KW_INDEX_R)		\
-	DECL(KW_UNARY_MINUS)	\
-	DECL(KW_PLUS)			\
-	DECL(KW_MINUS)			\
-	DECL(KW_MUL)			\
-	DECL(KW_DIV)			\
-	DECL(KW_MOD)			\
-	DECL(KW_OR)				\
-	DECL(KW_AND)			\
-	DECL(KW_NOT)			\
-	DECL(KW_LESS)			\
-	DECL(KW_GREATER)		\
-	DECL(KW_EQUAL)			\
-	DECL(KW_GR_EQ)			\
-	DECL(KW_LE_EQ)			\
-	DECL(KW_NOT_EQ)			\
-	DECL(KW_STRING)			\
-	DECL(KW_INT)			\
-	DECL(KW_FLOAT)			\
-	DECL(KW_BOOL)			\
-	DECL(KW_NEW)			\
-	DECL(KW_DELETE)			\
-	DECL(KW_ARRAY)			\
-	DECL(KW_DICT)
-
-DEFINE_ENUM(KEYWORD, ENUM_KEYWORD)
+// Keywords and delimiters with their spelling in the source text
+// (the scanner tables of the lexer are built from this list)
+#define ENUM_KEYWORD(DECL)				\
+	DECL(KW_CONST,		"const")		\
+	DECL(KW_GLOBAL,		"global")		\
+	DECL(KW_DEF,		"def")			\
+	DECL(KW_RETURN,		"return")		\
+	DECL(KW_IF,			"if")			\
+	DECL(KW_ELSE,		"else")			\
+	DECL(KW_DO,			"do")			\
+	DECL(KW_WHILE,		"while")		\
+	DECL(KW_FOR,		"for")			\
+	DECL(KW_TO,			"to")			\
+	DECL(KW_STEP,		"step")			\
+	DECL(KW_ASSIGN,		"=")			\
+	DECL(KW_COMMA,		",")			\
+	DECL(KW_BRACE_L,	"(")			\
+	DECL(KW_BRACE_R,	")")			\
+	DECL(KW_BLOCK_L,	"{")			\
+	DECL(KW_BLOCK_R,	"}")			\
+	DECL(KW_INDEX_L,	"[")			\
+	DECL(KW_INDEX_R,	"]")			\
+	DECL(KW_UNARY_MINUS,	"~")		\
+	DECL(KW_PLUS,		"+")			\
+	DECL(KW_MINUS,		"-")			\
+	DECL(KW_MUL,		"*")			\
+	DECL(KW_DIV,		"/")			\
+	DECL(KW_MOD,		"mod")			\
+	DECL(KW_OR,			"or")			\
+	DECL(KW_AND,		"and")			\
+	DECL(KW_NOT,		"not")			\
+	DECL(KW_LESS,		"<")			\
+	DECL(KW_GREATER,	">")			\
+	DECL(KW_EQUAL,		"==")			\
+	DECL(KW_GR_EQ,		">=")			\
+	DECL(KW_LE_EQ,		"<=")			\
+	DECL(KW_NOT_EQ,		"<>")			\
+	DECL(KW_STRING,		"$")			\
+	DECL(KW_INT,		"%")			\
+	DECL(KW_FLOAT,		"#")			\
+	DECL(KW_BOOL,		"!")			\
+	DECL(KW_NEW,		"new")			\
+	DECL(KW_DELETE,		"delete")		\
+	DECL(KW_ARRAY,		"array")		\
+	DECL(KW_DICT,		"dict")
+
+#define GENERATE_KEYWORD_ENUM(ENUM, SPELLING) ENUM,
+#define GENERATE_KEYWORD_STRING(ENUM, SPELLING) #ENUM,
+#define GENERATE_KEYWORD_SPELLING(ENUM, SPELLING) SPELLING,
+
+enum KEYWORD {
+	ENUM_KEYWORD(GENERATE_KEYWORD_ENUM)
+};
+static const char * KEYWORD_STRING[] = {
+	ENUM_KEYWORD(GENERATE_KEYWORD_STRING)
+};
+static const char * KEYWORD_SPELLING[] = {
+	ENUM_KEYWORD(GENERATE_KEYWORD_SPELLING)
+};
+static const unsigned KEYWORD_COUNT = sizeof(KEYWORD_SPELLING) / sizeof(*KEYWORD_SPELLING);
 
 #define ENUM_TOKEN_TYPE(DECL)	\
 	DECL(TOKEN_ERROR)			\
@@ -72,6 +89,9 @@ DEFINE_ENUM(KEYWORD, ENUM_KEYWORD)
 
 DEFINE_ENUM(TOKEN_TYPE, ENUM_TOKEN_TYPE)
 
+// Token is a small trivially copyable record
+// - Text of the source line is kept in LineTable, token holds its index
+// - Values of TOKEN_STRING and TOKEN_ID are interned, token holds an atom
 class Token
 {
 protected:
@@ -82,20 +102,28 @@ protected:
 	// TOKEN_INT
 	Token(TOKEN_TYPE type, int value,					const InputStream &is, int offset);
 	// TOKEN_STRING, TOKEN_ID
-	Token(TOKEN_TYPE type, const std::string &value,	const InputStream &is, int offset);
+	Token(TOKEN_TYPE type, Atom value,					const InputStream &is, int offset);
 	// TOKEN_DELIMETER, TOKEN_KEYWORD
 	Token(TOKEN_TYPE type, KEYWORD value,				const InputStream &is, int offset);
 
 public:
 	static Token TokenError(							const InputStream &is, int offset);
 	static Token TokenEOF(								const InputStream &is, int offset);
+	// TOKEN_EOF placed at the end of line of lastToken
+	static Token TokenEOF(const Token &lastToken);
+	// TOKEN_EOF of an empty source: line 1 without text
+	static Token TokenEOF();
 	static Token TokenFloat(double value,				const InputStream &is, int offset);
 	static Token TokenInt(int value,					const InputStream &is, int offset);
-	static Token TokenString(const std::string &value,	const InputStream &is, int offset);
-	static Token TokenID(const std::string &value,		const InputStream &is, int offset);
+	static Token TokenString(Atom value,				const InputStream &is, int offset);
+	static Token TokenID(Atom value,					const InputStream &is, int offset);
 	static Token TokenDelimeter(KEYWORD value,			const InputStream &is, int offset);
 	static Token TokenKeyword(KEYWORD value,			const InputStream &is, int offset);
 
+	// Makes token refer to another table, where its line has index
+	// shifted by lineShift (used when line tables are merged)
+	void RebaseLine(const LineTable *lines, unsigned lineShift);
+
 	void Print() const;
 
 	TOKEN_TYPE GetType() const;
@@ -105,24 +133,33 @@ public:
 
 	double GetValueF() const;
 	int GetValueI() const;
-	const std::string GetValueS() const;
+	const std::string &GetValueS() const;
+	Atom GetValueA() const;
 	KEYWORD GetValueK() const;
 
-	const char *GetLine() const;
+	std::string GetLine() const;
 	int GetLineNumber() const;
 	int GetOffset() const;
+	// Index of the line in the table of the lexer
+	unsigned GetLineIndex() const;
 
 private:
-	TOKEN_TYPE m_type;
+	// TokenBuffer stores tokens field by field and puts them back together
+	friend class TokenBuffer;
+	Token();
+
+	// Lines of the lexer which created this token (can be null)
+	const LineTable *m_lines;
 
 	union
 	{
 		double m_fvalue;
 		int m_ivalue;
 		KEYWORD m_kvalue;
+		Atom m_avalue;
 	};
-	std::string m_svalue;
 
-	std::string m_line;
+	unsigned m_line;
 	int m_lineNumber, m_offset;
+	TOKEN_TYPE m_type;
 };
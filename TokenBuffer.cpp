@@ -0,0 +1,194 @@
+#include <algorithm>
+#include <utility>
+#include "TokenBuffer.h"
+
+using namespace std;
+
+TokenBuffer::TokenBuffer()
+{
+
+}
+
+TokenBuffer::TokenBuffer(const vector<Token> &tokens)
+{
+	Append(tokens);
+}
+
+TokenBuffer::TokenBuffer(const TokenBuffer &other)
+	: m_types(other.m_types)
+	, m_keywords(other.m_keywords)
+	, m_values(other.m_values)
+	, m_positions(other.m_positions)
+{
+
+}
+
+TokenBuffer::TokenBuffer(TokenBuffer &&other)
+	: m_types(move(other.m_types))
+	, m_keywords(move(other.m_keywords))
+	, m_values(move(other.m_values))
+	, m_positions(move(other.m_positions))
+{
+
+}
+
+TokenBuffer &TokenBuffer::operator=(const TokenBuffer &other)
+{
+	m_types = other.m_types;
+	m_keywords = other.m_keywords;
+	m_values = other.m_values;
+	m_positions = other.m_positions;
+	return *this;
+}
+
+TokenBuffer &TokenBuffer::operator=(TokenBuffer &&other)
+{
+	m_types = move(other.m_types);
+	m_keywords = move(other.m_keywords);
+	m_values = move(other.m_values);
+	m_positions = move(other.m_positions);
+	return *this;
+}
+
+void TokenBuffer::Append(const Token &token)
+{
+	Value value;
+	value.fvalue = 0;
+	unsigned char keyword = NO_KEYWORD;
+
+	switch (token.m_type)
+	{
+	case TOKEN_FLOAT:
+		value.fvalue = token.m_fvalue;
+		break;
+	case TOKEN_INT:
+		value.ivalue = token.m_ivalue;
+		break;
+	case TOKEN_STRING:
+	case TOKEN_ID:
+		value.avalue = token.m_avalue;
+		break;
+	case TOKEN_KEYWORD:
+	case TOKEN_DELIMETER:
+		keyword = static_cast<unsigned char>(token.m_kvalue);
+		break;
+	default:
+		// TOKEN_ERROR and TOKEN_EOF have no value
+		break;
+	}
+
+	Position position = { token.m_lines, token.m_line, token.m_lineNumber, token.m_offset };
+
+	m_types.push_back(static_cast<unsigned char>(token.m_type));
+	m_keywords.push_back(keyword);
+	m_values.push_back(value);
+	m_positions.push_back(position);
+}
+
+void TokenBuffer::Append(const vector<Token> &tokens)
+{
+	// Reserving the exact size would copy the buffer on every append
+	// (e.g. IncrementalParser appends the tokens line by line)
+	size_t size = Size() + tokens.size();
+	if (size > m_types.capacity())
+	{
+		Reserve(max(size, m_types.capacity() * 2));
+	}
+	for (auto &token : tokens)
+	{
+		Append(token);
+	}
+}
+
+void TokenBuffer::Append(const TokenBuffer &tokens, size_t begin, size_t end)
+{
+	m_types.insert(m_types.end(), tokens.m_types.begin() + begin, tokens.m_types.begin() + end);
+	m_keywords.insert(m_keywords.end(), tokens.m_keywords.begin() + begin, tokens.m_keywords.begin() + end);
+	m_values.insert(m_values.end(), tokens.m_values.begin() + begin, tokens.m_values.begin() + end);
+	m_positions.insert(m_positions.end(), tokens.m_positions.begin() + begin, tokens.m_positions.begin() + end);
+}
+
+void TokenBuffer::EraseFront(size_t count)
+{
+	m_types.erase(m_types.begin(), m_types.begin() + count);
+	m_keywords.erase(m_keywords.begin(), m_keywords.begin() + count);
+	m_values.erase(m_values.begin(), m_values.begin() + count);
+	m_positions.erase(m_positions.begin(), m_positions.begin() + count);
+}
+
+void TokenBuffer::Clear()
+{
+	m_types.clear();
+	m_keywords.clear();
+	m_values.clear();
+	m_positions.clear();
+}
+
+void TokenBuffer::Reserve(size_t count)
+{
+	m_types.reserve(count);
+	m_keywords.reserve(count);
+	m_values.reserve(count);
+	m_positions.reserve(count);
+}
+
+size_t TokenBuffer::Size() const
+{
+	return m_types.size();
+}
+
+bool TokenBuffer::IsEmpty() const
+{
+	return m_types.empty();
+}
+
+TOKEN_TYPE TokenBuffer::GetType(size_t index) const
+{
+	return static_cast<TOKEN_TYPE>(m_types[index]);
+}
+
+KEYWORD TokenBuffer::GetKeyword(size_t index) const
+{
+	return static_cast<KEYWORD>(m_keywords[index]);
+}
+
+bool TokenBuffer::IsKeyword(size_t index, KEYWORD kw) const
+{
+	return m_keywords[index] == kw;
+}
+
+Token TokenBuffer::Get(size_t index) const
+{
+	Token result;
+	const Value &value = m_values[index];
+	const Position &position = m_positions[index];
+
+	result.m_type = GetType(index);
+	switch (result.m_type)
+	{
+	case TOKEN_FLOAT:
+		result.m_fvalue = value.fvalue;
+		break;
+	case TOKEN_INT:
+		result.m_ivalue = value.ivalue;
+		break;
+	case TOKEN_STRING:
+	case TOKEN_ID:
+		result.m_avalue = value.avalue;
+		break;
+	case TOKEN_KEYWORD:
+	case TOKEN_DELIMETER:
+		result.m_kvalue = GetKeyword(index);
+		break;
+	default:
+		result.m_ivalue = 0;
+		break;
+	}
+
+	result.m_lines = position.lines;
+	result.m_line = position.line;
+	result.m_lineNumber = position.lineNumber;
+	result.m_offset = position.offset;
+
+	return result;
+}
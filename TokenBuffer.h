@@ -0,0 +1,65 @@
+#pragma once
+#include <vector>
+#include "Token.h"
+
+// Sequence of tokens stored as parallel arrays
+// - Types and keywords take one byte per token, so checks of the kind
+// of token (as the parser does most of the time) read one cache line
+// per 64 tokens
+// - Values and source positions are only read when a whole token is made
+class TokenBuffer
+{
+public:
+	TokenBuffer();
+	explicit TokenBuffer(const std::vector<Token> &tokens);
+
+	TokenBuffer(const TokenBuffer &other);
+	TokenBuffer(TokenBuffer &&other);
+	TokenBuffer &operator=(const TokenBuffer &other);
+	TokenBuffer &operator=(TokenBuffer &&other);
+
+	void Append(const Token &token);
+	void Append(const std::vector<Token> &tokens);
+	// Appends tokens [begin, end) of another buffer
+	void Append(const TokenBuffer &tokens, size_t begin, size_t end);
+	// Removes count tokens from the beginning
+	void EraseFront(size_t count);
+	void Clear();
+	void Reserve(size_t count);
+
+	size_t Size() const;
+	bool IsEmpty() const;
+
+	TOKEN_TYPE GetType(size_t index) const;
+	// Token must be a keyword or a delimiter
+	KEYWORD GetKeyword(size_t index) const;
+	// Same as Get(index).IsKeyword(kw), but reads only the keyword array
+	bool IsKeyword(size_t index, KEYWORD kw) const;
+
+	// Makes the whole token
+	Token Get(size_t index) const;
+
+private:
+	// Stored in m_keywords for the tokens that aren't keywords or delimiters
+	static const unsigned char NO_KEYWORD = 0xFF;
+
+	union Value
+	{
+		double fvalue;
+		int ivalue;
+		Atom avalue;
+	};
+
+	struct Position
+	{
+		const LineTable *lines;
+		unsigned line;
+		int lineNumber;
+		int offset;
+	};
+
+	std::vector<unsigned char> m_types;
+	std::vector<unsigned char> m_keywords;
+	std::vector<Value> m_values;
+	std::vector<Position> m_positions;
+};
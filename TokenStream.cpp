@@ -1,76 +1,281 @@
+#include <utility>
 #include "TokenStream.h"
 #include "Exception.h"
+#include "AstContext.h"
 
 using namespace std;
 
+// Window is compacted when at least this many tokens
+// (and at least a half of the window) can be dropped
+static const size_t MIN_RELEASE_SIZE = 256;
+// Position of the cached token that isn't made yet
+static const size_t NO_POSITION = static_cast<size_t>(-1);
+
 TokenStream::TokenStream(const vector<Token> &tokens)
-	: m_tokens(tokens)
+	: m_window(tokens)
+	, m_windowStart(0)
+	, m_borrowed(nullptr)
+	, m_eof(MakeEOF(m_window))
+	, m_current(m_eof)
+	, m_previous(m_eof)
+	, m_currentPosition(NO_POSITION)
+	, m_previousPosition(NO_POSITION)
+	, m_position(0)
+	, m_errors(nullptr)
+{
+
+}
+
+TokenStream::TokenStream(vector<Token> &&tokens)
+	: m_window(tokens)
+	, m_windowStart(0)
+	, m_borrowed(nullptr)
+	, m_eof(MakeEOF(m_window))
+	, m_current(m_eof)
+	, m_previous(m_eof)
+	, m_currentPosition(NO_POSITION)
+	, m_previousPosition(NO_POSITION)
 	, m_position(0)
+	, m_errors(nullptr)
+{
+	vector<Token>().swap(tokens);
+}
+
+TokenStream::TokenStream(const TokenBuffer &tokens)
+	: m_windowStart(0)
+	, m_borrowed(&tokens)
+	, m_eof(MakeEOF(tokens))
+	, m_current(m_eof)
+	, m_previous(m_eof)
+	, m_currentPosition(NO_POSITION)
+	, m_previousPosition(NO_POSITION)
+	, m_position(0)
+	, m_errors(nullptr)
+{
+
+}
+
+TokenStream::TokenStream(TokenBuffer &&tokens)
+	: m_window(move(tokens))
+	, m_windowStart(0)
+	, m_borrowed(nullptr)
+	, m_eof(MakeEOF(m_window))
+	, m_current(m_eof)
+	, m_previous(m_eof)
+	, m_currentPosition(NO_POSITION)
+	, m_previousPosition(NO_POSITION)
+	, m_position(0)
+	, m_errors(nullptr)
+{
+
+}
+
+TokenStream::TokenStream(shared_ptr<ITokenSource> source)
+	: m_windowStart(0)
+	, m_borrowed(nullptr)
+	, m_eof(MakeEOF(m_window))
+	, m_current(m_eof)
+	, m_previous(m_eof)
+	, m_currentPosition(NO_POSITION)
+	, m_previousPosition(NO_POSITION)
+	, m_source(source)
+	, m_position(0)
+	, m_errors(nullptr)
+{
+
+}
+
+Token TokenStream::MakeEOF(const TokenBuffer &tokens)
 {
+	if (tokens.IsEmpty())
+	{
+		return Token::TokenEOF();
+	}
+	return Token::TokenEOF(tokens.Get(tokens.Size() - 1));
+}
 
+const TokenBuffer &TokenStream::Tokens() const
+{
+	return m_borrowed ? *m_borrowed : m_window;
 }
-	
-const Token TokenStream::Current() const
+
+bool TokenStream::Fetch(size_t position) const
 {
-	if (m_position >= m_tokens.size())
+	while (position >= m_windowStart + Tokens().Size())
 	{
-		if (m_tokens.size())
+		if (!m_source)
 		{
-			const Token &tk = m_tokens[m_tokens.size() - 1];
-			InputStream is(tk.GetLine(), tk.GetLineNumber());
-			is.Forward(strlen(is.GetLine()));
-			return Token::TokenEOF(is, is.Tell());
+			return false;
 		}
-		else
+		if (!m_source->ReadTokens(m_window))
 		{
-			return Token::TokenEOF(InputStream("", 1), 0);
+			m_source.reset();
+			m_eof = MakeEOF(m_window);
+			return false;
 		}
 	}
-	else
+
+	return true;
+}
+
+void TokenStream::Release()
+{
+	if (m_borrowed)
 	{
-		return m_tokens[m_position];
+		return;
+	}
+
+	// Previous() must work after returning to a saved position as well,
+	// so the token before it is kept too
+	size_t keepFrom = m_position;
+	if (!m_positionStack.empty() && m_positionStack.front() < keepFrom)
+	{
+		keepFrom = m_positionStack.front();
+	}
+	if (keepFrom > 0)
+	{
+		keepFrom--;
+	}
+
+	size_t released = keepFrom - m_windowStart;
+	if (released >= MIN_RELEASE_SIZE && released * 2 >= m_window.Size())
+	{
+		m_window.EraseFront(released);
+		m_windowStart = keepFrom;
+		if (m_source && !m_window.IsEmpty())
+		{
+			m_source->Release(m_window.Get(0));
+		}
 	}
 }
 
-const Token TokenStream::Previous() const
+const Token &TokenStream::Current() const
+{
+	if (!Fetch(m_position))
+	{
+		return m_eof;
+	}
+
+	if (m_currentPosition != m_position)
+	{
+		m_current = Tokens().Get(m_position - m_windowStart);
+		m_currentPosition = m_position;
+	}
+	return m_current;
+}
+
+const Token &TokenStream::Previous() const
 {
 	if (m_position == 0)
 	{
 		return Current();
 	}
-	else
+
+	if (m_previousPosition != m_position - 1)
 	{
-		return m_tokens[m_position - 1];
+		m_previous = Tokens().Get(m_position - 1 - m_windowStart);
+		m_previousPosition = m_position - 1;
 	}
+	return m_previous;
+}
+
+TOKEN_TYPE TokenStream::CurrentType() const
+{
+	return PeekType(0);
+}
+
+KEYWORD TokenStream::CurrentKeyword() const
+{
+	if (!Fetch(m_position))
+	{
+		return m_eof.GetValueK();
+	}
+	return Tokens().GetKeyword(m_position - m_windowStart);
+}
+
+bool TokenStream::IsKeyword(KEYWORD kw) const
+{
+	return PeekKeyword(0, kw);
+}
+
+TOKEN_TYPE TokenStream::PeekType(size_t ahead) const
+{
+	size_t position = m_position + ahead;
+	if (!Fetch(position))
+	{
+		return TOKEN_EOF;
+	}
+	return Tokens().GetType(position - m_windowStart);
+}
+
+bool TokenStream::PeekKeyword(size_t ahead, KEYWORD kw) const
+{
+	size_t position = m_position + ahead;
+	return Fetch(position) && Tokens().IsKeyword(position - m_windowStart, kw);
 }
 
 void TokenStream::Forward()
 {
-	if (m_position < m_tokens.size())
+	if (Fetch(m_position))
 	{
 		m_position++;
+		Release();
 	}
 }
 
 void TokenStream::PushPosition()
 {
-	m_positionStack.push(m_position);
+	m_positionStack.push_back(m_position);
 }
 
 void TokenStream::PopPosition()
 {
-	m_positionStack.pop();
+	m_positionStack.pop_back();
 }
 
 void TokenStream::RestorePosition()
 {
-	m_position = m_positionStack.top();
+	m_position = m_positionStack.back();
 	PopPosition();
 }
 
+size_t TokenStream::GetSavedPositionCount() const
+{
+	return m_positionStack.size();
+}
+
+void TokenStream::DropSavedPositions(size_t count)
+{
+	m_positionStack.resize(count);
+}
+
+vector<CompileError> *TokenStream::GetErrorLog() const
+{
+	return m_errors;
+}
+
+void TokenStream::SetErrorLog(vector<CompileError> *errors)
+{
+	m_errors = errors;
+}
+
+AstContext &TokenStream::GetAstContext()
+{
+	if (!m_context)
+	{
+		m_context = make_shared<AstContext>();
+	}
+	return *m_context;
+}
+
+size_t TokenStream::GetPosition() const
+{
+	return m_position;
+}
+
 bool TokenStream::IsEOS() const
 {
-	  return m_position >= m_tokens.size();
+	  return !Fetch(m_position);
 }
 
 void TokenStream::AssertStackIsEmpty() const
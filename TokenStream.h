@@ -1,28 +1,120 @@
 #pragma once
 #include <vector>
-#include <stack>
+#include <memory>
 #include "Token.h"
+#include "TokenBuffer.h"
+
+class CompileError;
+class AstContext;
+
+// Source of tokens for TokenStream (e.g. lexer reading a file)
+class ITokenSource
+{
+public:
+	virtual ~ITokenSource()
+	{
+	}
+
+	// Appends following tokens to the buffer (maybe none)
+	// - Returns false if there are no more tokens
+	virtual bool ReadTokens(TokenBuffer &tokens) = 0;
+
+	// Stream has dropped the tokens before first, the source may
+	// forget what only they needed (e.g. their lines)
+	virtual void Release(const Token &first)
+	{
+	}
+};
 
 class TokenStream
 {
 public:
 	TokenStream();
+	// Copies the tokens into the buffer of the stream
+	// - The copy is deliberate: the parser reads the kinds of tokens from
+	// the parallel arrays of TokenBuffer, which a vector of whole tokens
+	// doesn't have; a TokenBuffer is borrowed or moved without it
 	TokenStream(const std::vector<Token> &tokens);
+	// Same, but the vector is freed as soon as it's copied
+	TokenStream(std::vector<Token> &&tokens);
+	// Borrows the tokens, the buffer must outlive the stream
+	TokenStream(const TokenBuffer &tokens);
+	// Takes the tokens over without copying them
+	TokenStream(TokenBuffer &&tokens);
+	// Tokens are read from the source when the parser gets to them
+	// - Only a window of tokens is kept in memory: the ones starting
+	// from the token before the outermost saved position (or the previous token)
+	TokenStream(std::shared_ptr<ITokenSource> source);
 
-	const Token Current() const;
-	const Token Previous() const;
+	// References stay valid until the stream is moved forward
+	// - At the end of the stream Current() returns the same EOF token
+	// - Token is put together from the arrays of the buffer, so checks
+	// of its kind are better done with the functions below
+	const Token &Current() const;
+	const Token &Previous() const;
+
+	// Kind of the current token, read without making the whole token
+	// - TOKEN_EOF at the end of the stream
+	TOKEN_TYPE CurrentType() const;
+	// Current token must be a keyword or a delimiter
+	KEYWORD CurrentKeyword() const;
+	bool IsKeyword(KEYWORD kw) const;
+	// Same for the token that is ahead positions after the current one
+	TOKEN_TYPE PeekType(size_t ahead) const;
+	bool PeekKeyword(size_t ahead, KEYWORD kw) const;
 
 	void Forward();
 
 	void PushPosition();
 	void PopPosition();
 	void RestorePosition();
+	// After an error thrown between PushPosition() and PopPosition()
+	// the positions saved above count are dropped
+	size_t GetSavedPositionCount() const;
+	void DropSavedPositions(size_t count);
+
+	// Errors are recorded here by the parser that recovers from them
+	// (see ParseWithRecovery()), null if the parser throws them
+	std::vector<CompileError> *GetErrorLog() const;
+	void SetErrorLog(std::vector<CompileError> *errors);
+
+	// Context that owns the nodes made by the parser from this stream,
+	// made on the first call; copies of the stream share it
+	AstContext &GetAstContext();
+
+	// Index of the current token from the start of the stream
+	size_t GetPosition() const;
 
 	bool IsEOS() const;
 	void AssertStackIsEmpty() const;
 
 private:
-	const std::vector<Token> m_tokens;
+	// Tokens [m_windowStart, m_windowStart + m_window.Size())
+	mutable TokenBuffer m_window;
+	mutable size_t m_windowStart;
+	// Not null if the stream reads borrowed tokens instead of the window
+	const TokenBuffer *m_borrowed;
+	// Returned by Current() at the end of the stream
+	mutable Token m_eof;
+	// Tokens made by Current() and Previous() and their positions
+	mutable Token m_current, m_previous;
+	mutable size_t m_currentPosition, m_previousPosition;
+	// Null when all tokens were read
+	mutable std::shared_ptr<ITokenSource> m_source;
+
 	size_t m_position;
-	std::stack<size_t> m_positionStack;
+	// Positions only grow from the bottom to the top of the stack
+	std::vector<size_t> m_positionStack;
+	std::vector<CompileError> *m_errors;
+	std::shared_ptr<AstContext> m_context;
+
+	// Reads tokens until the window contains position
+	// - Returns false if the stream ends before that position
+	bool Fetch(size_t position) const;
+	// Drops tokens that can't be returned to
+	void Release();
+
+	const TokenBuffer &Tokens() const;
+	// Makes EOF token that follows the last token (if any)
+	static Token MakeEOF(const TokenBuffer &tokens);
 };
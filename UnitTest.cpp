@@ -0,0 +1,180 @@
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include "UnitTest.h"
+#include "Exception.h"
+#include "Lexer.h"
+#include "Parser.h"
+#include "AstWalker.h"
+#include "Constant.h"
+
+using namespace std;
+
+void Check(bool condition, const string &message)
+{
+	if (!condition)
+	{
+		throw InternalError("Check failed: " + message);
+	}
+}
+
+string ReadTestProgram(const string &name)
+{
+	ifstream file("Test programs/" + name, ios::binary);
+	if (!file)
+	{
+		throw InternalError("Cannot open test program '" + name + "'");
+	}
+
+	ostringstream text;
+	text << file.rdbuf();
+	return text.str();
+}
+
+shared_ptr<IAst> ParseText(const string &text)
+{
+	Lexer lex;
+	TokenStream ts(lex.ParseBuffer(text.data(), text.size()));
+	return Parse(ts);
+}
+
+string GetParseError(const string &text)
+{
+	try
+	{
+		ParseText(text);
+	}
+	catch (const CompileError &ex)
+	{
+		return ex.what();
+	}
+	return string();
+}
+
+namespace
+{
+	// Writes a node as "(kind <type> <values> children...)"
+	class AstDumper : public AstWalker<AstDumper>
+	{
+	public:
+		using AstWalker<AstDumper>::visit;
+
+		explicit AstDumper(ostream &os)
+			: m_os(os)
+		{
+			m_os << setprecision(17);
+		}
+
+		void Walk(const IAst *node)
+		{
+			m_os << '(' << static_cast<unsigned>(node->GetKind());
+			if (node->IsExpression())
+			{
+				m_os << ' ' << Cast<AstExpression>(node)->GetType().ToString();
+			}
+			AstWalker<AstDumper>::Walk(node);
+			m_os << ')';
+		}
+
+		void visit(const AstIntConst &ref)
+		{
+			m_os << ' ' << ref.GetValue();
+		}
+
+		void visit(const AstFloatConst &ref)
+		{
+			m_os << ' ' << ref.GetValue();
+		}
+
+		void visit(const AstStringConst &ref)
+		{
+			m_os << " \"" << ref.GetValue() << '"';
+		}
+
+		void visit(const AstBoolConst &ref)
+		{
+			m_os << ' ' << ref.GetValue();
+		}
+
+		void visit(const AstVariable &ref)
+		{
+			m_os << ' ' << ref.GetName();
+		}
+
+		void visit(const AstUnaryExpression &ref)
+		{
+			m_os << ' ' << KEYWORD_STRING[ref.GetOperator()];
+			WalkChildren(ref);
+		}
+
+		void visit(const AstBinaryExpression &ref)
+		{
+			m_os << ' ' << KEYWORD_STRING[ref.GetOperator()];
+			WalkChildren(ref);
+		}
+
+		void visit(const AstFunctionCall &ref)
+		{
+			m_os << ' ' << ref.GetName();
+			WalkChildren(ref);
+		}
+
+		void visit(const AstArrayValue &ref)
+		{
+			m_os << ' ' << ref.GetName() << ' ' << ref.GetArrayType().ToString();
+			WalkChildren(ref);
+		}
+
+		void visit(const AstDictValue &ref)
+		{
+			m_os << ' ' << ref.GetName() << ' ' << ref.GetDictType().ToString();
+			WalkChildren(ref);
+		}
+
+		void visit(const AstFunction &ref)
+		{
+			m_os << ' ' << ref.GetName() << ' ' << ref.GetReturnType().ToString();
+			WalkChildren(ref);
+		}
+
+		void visit(const AstWhile &ref)
+		{
+			m_os << ' ' << ref.IsDoWhile();
+			WalkChildren(ref);
+		}
+
+		void visit(const AstConstantDecl &ref)
+		{
+			const ConstantBase &constant = *ref.GetConst();
+			m_os << ' ' << constant.GetName() << ' ';
+			switch (constant.GetType().GetType())
+			{
+			case DATA_TYPE::TYPE_INT:
+				m_os << static_cast<const IntConst &>(constant).GetValue();
+				break;
+			case DATA_TYPE::TYPE_FLOAT:
+				m_os << static_cast<const FloatConst &>(constant).GetValue();
+				break;
+			case DATA_TYPE::TYPE_STRING:
+				m_os << '"' << static_cast<const StringConst &>(constant).GetValue() << '"';
+				break;
+			case DATA_TYPE::TYPE_BOOL:
+				m_os << static_cast<const BoolConst &>(constant).GetValue();
+				break;
+			default:
+				throw InternalError("DumpAst: invalid type of constant");
+			}
+		}
+
+	private:
+		ostream &m_os;
+	};
+}
+
+string DumpAst(const IAst &ast)
+{
+	ostringstream text;
+	AstDumper dumper(text);
+	dumper.Walk(&ast);
+	return text.str();
+}
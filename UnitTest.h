@@ -0,0 +1,24 @@
+#pragma once
+#include <memory>
+#include <string>
+#include "AstFwd.h"
+
+// Helpers of the tests run by Tests.cpp
+// - A test is a function that throws InternalError if a check fails
+// - Sample programs of the tests are in the "Test programs" directory,
+// which must be the working directory's subdirectory
+
+// Throws InternalError with the message if the condition is false
+void Check(bool condition, const std::string &message);
+
+// Text of a sample program, e.g. ReadTestProgram("ModByZero.txt")
+std::string ReadTestProgram(const std::string &name);
+
+// Parses the text with Parse(), CompileError isn't caught
+std::shared_ptr<IAst> ParseText(const std::string &text);
+// Message of the error of parsing the text, empty if the program is valid
+std::string GetParseError(const std::string &text);
+
+// Text form of the tree with the kinds, types and values of all the nodes,
+// equal trees have equal text
+std::string DumpAst(const IAst &ast);
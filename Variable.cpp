@@ -3,6 +3,12 @@
 using namespace std;
 
 Variable::Variable(const string &varName, const DataType &varType)
+	: m_name(Interner::Intern(varName))
+	, m_type(varType)
+{
+}
+
+Variable::Variable(Atom varName, const DataType &varType)
 	: m_name(varName)
 	, m_type(varType)
 {
@@ -13,6 +19,11 @@ Variable::~Variable()
 }
 
 const string &Variable::GetName() const
+{
+	return Interner::GetString(m_name);
+}
+
+Atom Variable::GetAtom() const
 {
 	return m_name;
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include "DataType.h"
+#include "Interner.h"
 
 // Holds all information about a variable or constant
 // (its name and data type)
@@ -8,12 +9,14 @@ class Variable
 {
 public:
 	Variable(const std::string &varName, const DataType &varType);
+	Variable(Atom varName, const DataType &varType);
 	virtual ~Variable();
 
 	const std::string &GetName() const;
+	Atom GetAtom() const;
 	const DataType &GetType() const;
 
 private:
-	const std::string m_name;
+	const Atom m_name;
 	const DataType m_type;
 };